@@ -47,6 +47,13 @@ METRIC_DEFINE_histogram(
 DECLARE_bool(rpc_dump_all_traces);
 DECLARE_bool(collect_end_to_end_traces);
 
+DEFINE_bool(collect_request_costs, false,
+            "If true, tablet servers are asked to report the resources spent on each read and "
+            "write (keys scanned, blocks read, lock/Raft wait and apply time). The costs are "
+            "added to the trace of the request and show up in its slow query log.");
+TAG_FLAG(collect_request_costs, advanced);
+TAG_FLAG(collect_request_costs, runtime);
+
 using namespace std::placeholders;
 
 namespace yb {
@@ -185,6 +192,21 @@ void SetTransactionMetadata(const TransactionMetadata& metadata, tserver::ReadRe
   metadata.ToPB(req->mutable_transaction());
 }
 
+template <class Resp>
+void AddCostToTrace(const Resp& resp, Trace* trace) {
+  if (!resp.has_cost()) {
+    return;
+  }
+  const auto& cost = resp.cost();
+  trace->AddCost(TraceCost::kKeysScanned, cost.keys_scanned());
+  trace->AddCost(TraceCost::kBlocksRead, cost.blocks_read());
+  trace->AddCost(TraceCost::kBlockCacheHits, cost.block_cache_hits());
+  trace->AddCost(TraceCost::kBytesRead, cost.bytes_read());
+  trace->AddCost(TraceCost::kLockWaitMicros, cost.lock_wait_micros());
+  trace->AddCost(TraceCost::kRaftWaitMicros, cost.raft_wait_micros());
+  trace->AddCost(TraceCost::kApplyMicros, cost.apply_micros());
+}
+
 } // namespace
 
 void AsyncRpc::SendRpcToTserver() {
@@ -202,6 +224,7 @@ AsyncRpcBase<Req, Resp>::AsyncRpcBase(const scoped_refptr<Batcher>& batcher,
     : AsyncRpc(batcher, tablet, ops, consistency_level) {
   req_.set_tablet_id(tablet_invoker_.tablet()->tablet_id());
   req_.set_include_trace(IsTracingEnabled());
+  req_.set_include_cost(FLAGS_collect_request_costs);
   auto& transaction_data = batcher_->transaction_prepare_data();
   if (transaction_data.propagated_ht.is_valid()) {
     req_.set_propagated_hybrid_time(transaction_data.propagated_ht.ToUint64());
@@ -348,6 +371,7 @@ void WriteRpc::ProcessResponseFromTserver(const Status& status) {
   if (resp_.has_trace_buffer()) {
     TRACE_TO(trace_, "Received from server: $0", resp_.trace_buffer());
   }
+  AddCostToTrace(resp_, trace_.get());
   batcher_->ProcessWriteResponse(*this, status);
   if (!CommonResponseCheck(status)) {
     return;
@@ -486,6 +510,7 @@ void ReadRpc::ProcessResponseFromTserver(const Status& status) {
   if (resp_.has_trace_buffer()) {
     TRACE_TO(trace_, "Received from server: $0", resp_.trace_buffer());
   }
+  AddCostToTrace(resp_, trace_.get());
   batcher_->ProcessReadResponse(*this, status);
   if (!CommonResponseCheck(status)) {
     return;
@@ -0,0 +1,226 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "yb/common/ql_batch_condition.h"
+#include "yb/util/random.h"
+#include "yb/util/test_macros.h"
+
+namespace yb {
+
+namespace {
+
+constexpr ColumnIdRep kIntColumn = 10;
+constexpr ColumnIdRep kBigIntColumn = 11;
+constexpr ColumnIdRep kStringColumn = 12;
+
+QLValuePB Int32Value(int32_t value) {
+  QLValuePB result;
+  result.set_int32_value(value);
+  return result;
+}
+
+QLValuePB StringValue(const std::string& value) {
+  QLValuePB result;
+  result.set_string_value(value);
+  return result;
+}
+
+QLValuePB ListValue(const std::vector<QLValuePB>& elems) {
+  QLValuePB result;
+  for (const auto& elem : elems) {
+    *result.mutable_list_value()->add_elems() = elem;
+  }
+  return result;
+}
+
+void AddColumn(ColumnIdRep column_id, QLConditionPB* condition) {
+  condition->add_operands()->set_column_id(column_id);
+}
+
+void AddValue(const QLValuePB& value, QLConditionPB* condition) {
+  *condition->add_operands()->mutable_value() = value;
+}
+
+QLConditionPB ColumnCondition(QLOperator op, ColumnIdRep column_id,
+                              const std::vector<QLValuePB>& values) {
+  QLConditionPB condition;
+  condition.set_op(op);
+  AddColumn(column_id, &condition);
+  for (const auto& value : values) {
+    AddValue(value, &condition);
+  }
+  return condition;
+}
+
+QLConditionPB Conjunction(QLOperator op, const std::vector<QLConditionPB>& conditions) {
+  QLConditionPB result;
+  result.set_op(op);
+  for (const auto& condition : conditions) {
+    *result.add_operands()->mutable_condition() = condition;
+  }
+  return result;
+}
+
+// Generates rows with random values, some of them null or absent.
+std::vector<QLTableRow> GenerateRows(size_t num_rows) {
+  Random rnd(42);
+  std::vector<QLTableRow> rows(num_rows);
+  for (auto& row : rows) {
+    if (rnd.Uniform(10) != 0) {
+      row.AllocColumn(kIntColumn).value.set_int32_value(static_cast<int32_t>(rnd.Uniform(20)) - 10);
+    }
+    if (rnd.Uniform(10) != 0) {
+      auto& value = row.AllocColumn(kBigIntColumn).value;
+      if (rnd.Uniform(10) != 0) {
+        value.set_int64_value(rnd.Uniform(1000));
+      }
+    }
+    row.AllocColumn(kStringColumn).value.set_string_value(std::string(1, 'a' + rnd.Uniform(5)));
+  }
+  return rows;
+}
+
+// Checks that batch evaluation of the condition selects the same rows as evaluating it row by row.
+void CheckCondition(const QLConditionPB& condition, const std::vector<QLTableRow>& rows,
+                    size_t expected_column_conjuncts) {
+  SCOPED_TRACE(condition.ShortDebugString());
+  auto executor = std::make_shared<QLExprExecutor>();
+  std::vector<size_t> expected;
+  for (size_t i = 0; i != rows.size(); ++i) {
+    bool match = false;
+    ASSERT_OK(executor->EvalCondition(condition, rows[i], &match));
+    if (match) {
+      expected.push_back(i);
+    }
+  }
+
+  QLBatchCondition batch_condition(condition, executor);
+  ASSERT_EQ(expected_column_conjuncts, batch_condition.TEST_num_column_conjuncts());
+  std::vector<size_t> selection;
+  // Use a batch size that does not divide the number of rows.
+  constexpr size_t kBatchSize = 64;
+  std::vector<size_t> actual;
+  for (size_t start = 0; start < rows.size(); start += kBatchSize) {
+    const size_t end = std::min(rows.size(), start + kBatchSize);
+    std::vector<QLTableRow> batch(rows.begin() + start, rows.begin() + end);
+    ASSERT_OK(batch_condition.Match(batch, batch.size(), &selection));
+    for (const size_t index : selection) {
+      actual.push_back(start + index);
+    }
+  }
+  ASSERT_EQ(expected, actual);
+}
+
+} // namespace
+
+TEST(QLBatchConditionTest, TestBetween) {
+  // Values below, at the bounds of, inside and above [-3, 4].
+  const std::vector<int32_t> values = {-5, -3, 0, 4, 6};
+  std::vector<QLTableRow> rows(values.size());
+  for (size_t i = 0; i != values.size(); ++i) {
+    rows[i].AllocColumn(kIntColumn).value.set_int32_value(values[i]);
+  }
+
+  auto executor = std::make_shared<QLExprExecutor>();
+  const std::vector<std::pair<QLOperator, std::vector<bool>>> cases = {
+      {QL_OP_BETWEEN, {false, true, true, true, false}},
+      {QL_OP_NOT_BETWEEN, {true, false, false, false, true}}};
+  for (const auto& test_case : cases) {
+    const auto condition = ColumnCondition(
+        test_case.first, kIntColumn, {Int32Value(-3), Int32Value(4)});
+    SCOPED_TRACE(condition.ShortDebugString());
+    for (size_t i = 0; i != rows.size(); ++i) {
+      bool match = false;
+      ASSERT_OK(executor->EvalCondition(condition, rows[i], &match));
+      ASSERT_EQ(test_case.second[i], match) << "value: " << values[i];
+    }
+    CheckCondition(condition, rows, 1);
+  }
+}
+
+TEST(QLBatchConditionTest, TestMatchesRowByRowEvaluation) {
+  const auto rows = GenerateRows(1000);
+
+  for (QLOperator op : {QL_OP_EQUAL, QL_OP_NOT_EQUAL, QL_OP_LESS_THAN, QL_OP_LESS_THAN_EQUAL,
+                        QL_OP_GREATER_THAN, QL_OP_GREATER_THAN_EQUAL}) {
+    CheckCondition(ColumnCondition(op, kIntColumn, {Int32Value(3)}), rows, 1);
+    CheckCondition(ColumnCondition(op, kStringColumn, {StringValue("c")}), rows, 1);
+    CheckCondition(ColumnCondition(op, kIntColumn, {QLValuePB()}), rows, 1);
+
+    // Constant on the left-hand side.
+    QLConditionPB reversed;
+    reversed.set_op(op);
+    AddValue(Int32Value(-2), &reversed);
+    AddColumn(kIntColumn, &reversed);
+    CheckCondition(reversed, rows, 1);
+  }
+
+  for (QLOperator op : {QL_OP_BETWEEN, QL_OP_NOT_BETWEEN}) {
+    CheckCondition(ColumnCondition(op, kIntColumn, {Int32Value(-3), Int32Value(4)}), rows, 1);
+    CheckCondition(ColumnCondition(op, kStringColumn, {StringValue("b"), StringValue("d")}), rows,
+                   1);
+  }
+
+  for (QLOperator op : {QL_OP_IN, QL_OP_NOT_IN}) {
+    CheckCondition(ColumnCondition(
+        op, kIntColumn, {ListValue({Int32Value(7), Int32Value(-1), Int32Value(2)})}), rows, 1);
+    CheckCondition(ColumnCondition(
+        op, kStringColumn, {ListValue({StringValue("e"), StringValue("a")})}), rows, 1);
+    CheckCondition(ColumnCondition(op, kIntColumn, {ListValue({})}), rows, 1);
+  }
+
+  for (QLOperator op : {QL_OP_IS_NULL, QL_OP_IS_NOT_NULL}) {
+    CheckCondition(ColumnCondition(op, kIntColumn, {}), rows, 1);
+    CheckCondition(ColumnCondition(op, kBigIntColumn, {}), rows, 1);
+  }
+
+  // Nested conjunctions are flattened, other conditions are evaluated row by row.
+  const auto or_condition = Conjunction(QL_OP_OR, {
+      ColumnCondition(QL_OP_LESS_THAN, kIntColumn, {Int32Value(-5)}),
+      ColumnCondition(QL_OP_EQUAL, kStringColumn, {StringValue("b")})});
+  CheckCondition(Conjunction(QL_OP_AND, {
+      ColumnCondition(QL_OP_GREATER_THAN_EQUAL, kIntColumn, {Int32Value(-8)}),
+      Conjunction(QL_OP_AND, {
+          ColumnCondition(QL_OP_NOT_EQUAL, kStringColumn, {StringValue("a")}),
+          ColumnCondition(QL_OP_IS_NOT_NULL, kBigIntColumn, {})}),
+      or_condition}), rows, 3);
+  CheckCondition(or_condition, rows, 0);
+}
+
+TEST(QLBatchConditionTest, TestNotComparable) {
+  const auto rows = GenerateRows(100);
+  auto executor = std::make_shared<QLExprExecutor>();
+  std::vector<size_t> selection;
+
+  QLBatchCondition int_condition(
+      ColumnCondition(QL_OP_EQUAL, kStringColumn, {Int32Value(1)}), executor);
+  ASSERT_TRUE(int_condition.Match(rows, rows.size(), &selection).IsRuntimeError());
+
+  QLBatchCondition string_condition(
+      ColumnCondition(QL_OP_LESS_THAN, kIntColumn, {StringValue("a")}), executor);
+  ASSERT_TRUE(string_condition.Match(rows, rows.size(), &selection).IsRuntimeError());
+
+  // Rows not selected by a preceding conjunct are not evaluated.
+  QLBatchCondition and_condition(Conjunction(QL_OP_AND, {
+      ColumnCondition(QL_OP_IS_NULL, kStringColumn, {}),
+      ColumnCondition(QL_OP_EQUAL, kStringColumn, {Int32Value(1)})}), executor);
+  ASSERT_OK(and_condition.Match(rows, rows.size(), &selection));
+  ASSERT_TRUE(selection.empty());
+}
+
+} // namespace yb
@@ -0,0 +1,491 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+//
+// This file contains QLBatchCondition that evaluates a QL condition over batches of rows.
+
+#include "yb/common/ql_batch_condition.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace yb {
+
+namespace {
+
+bool IsIntegerType(QLValuePB::ValueCase type) {
+  switch (type) {
+    case QLValuePB::kInt8Value: FALLTHROUGH_INTENDED;
+    case QLValuePB::kInt16Value: FALLTHROUGH_INTENDED;
+    case QLValuePB::kInt32Value: FALLTHROUGH_INTENDED;
+    case QLValuePB::kInt64Value:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Returns the value of a non-null integer QLValuePB, widened to int64_t.
+int64_t GetInteger(const QLValuePB& value) {
+  switch (value.value_case()) {
+    case QLValuePB::kInt8Value: return static_cast<int8_t>(value.int8_value());
+    case QLValuePB::kInt16Value: return static_cast<int16_t>(value.int16_value());
+    case QLValuePB::kInt32Value: return value.int32_value();
+    case QLValuePB::kInt64Value: return value.int64_value();
+    default:
+      LOG(FATAL) << "Not an integer value: " << value.ShortDebugString();
+  }
+  return 0;
+}
+
+// Returns the operator to use when the operands of a binary comparison are swapped, or QL_OP_NOOP
+// if the operator is not a binary comparison.
+QLOperator SwappedComparison(QLOperator op) {
+  switch (op) {
+    case QL_OP_EQUAL: return QL_OP_EQUAL;
+    case QL_OP_NOT_EQUAL: return QL_OP_NOT_EQUAL;
+    case QL_OP_LESS_THAN: return QL_OP_GREATER_THAN;
+    case QL_OP_LESS_THAN_EQUAL: return QL_OP_GREATER_THAN_EQUAL;
+    case QL_OP_GREATER_THAN: return QL_OP_LESS_THAN;
+    case QL_OP_GREATER_THAN_EQUAL: return QL_OP_LESS_THAN_EQUAL;
+    default: return QL_OP_NOOP;
+  }
+}
+
+Status NotComparable() {
+  return STATUS(RuntimeError, "values not comparable");
+}
+
+// Sets matches[i] to predicate(values[i]) for all values. Kept as a simple loop over plain arrays
+// so that the compiler can vectorize it.
+template <class Predicate>
+void EvaluateIntegers(const std::vector<int64_t>& values, Predicate predicate,
+                      std::vector<uint8_t>* matches) {
+  const size_t size = values.size();
+  const int64_t* in = values.data();
+  uint8_t* out = matches->data();
+  for (size_t i = 0; i < size; ++i) {
+    out[i] = predicate(in[i]);
+  }
+}
+
+} // namespace
+
+//--------------------------------------------------------------------------------------------------
+
+class QLBatchCondition::Conjunct {
+ public:
+  virtual ~Conjunct() {}
+
+  // Removes the rows that do not match this conjunct from the selection.
+  virtual CHECKED_STATUS Filter(const std::vector<QLTableRow>& rows,
+                                std::vector<size_t>* selection) = 0;
+
+  virtual bool is_column_conjunct() const { return false; }
+};
+
+//--------------------------------------------------------------------------------------------------
+
+// A conjunct evaluated row by row.
+class QLBatchCondition::RowConjunct : public QLBatchCondition::Conjunct {
+ public:
+  RowConjunct(const QLConditionPB& condition, QLExprExecutor* executor)
+      : condition_(condition), executor_(executor) {}
+
+  CHECKED_STATUS Filter(const std::vector<QLTableRow>& rows,
+                        std::vector<size_t>* selection) override {
+    size_t num_selected = 0;
+    for (const size_t index : *selection) {
+      bool match = false;
+      RETURN_NOT_OK(executor_->EvalCondition(condition_, rows[index], &match));
+      if (match) {
+        (*selection)[num_selected++] = index;
+      }
+    }
+    selection->resize(num_selected);
+    return Status::OK();
+  }
+
+ private:
+  const QLConditionPB& condition_;
+  QLExprExecutor* const executor_;
+};
+
+//--------------------------------------------------------------------------------------------------
+
+// A conjunct comparing a column with constants, evaluated column-at-a-time.
+class QLBatchCondition::ColumnConjunct : public QLBatchCondition::Conjunct {
+ public:
+  // Returns nullptr if the condition is not a supported comparison of a column with constants.
+  static std::unique_ptr<ColumnConjunct> Compile(const QLConditionPB& condition);
+
+  CHECKED_STATUS Filter(const std::vector<QLTableRow>& rows,
+                        std::vector<size_t>* selection) override;
+
+  bool is_column_conjunct() const override { return true; }
+
+ private:
+  ColumnConjunct(QLOperator op, ColumnIdRep column_id, std::vector<QLValuePB> operands);
+
+  // Evaluates the conjunct for a single column value in the same way as
+  // QLExprExecutor::EvalCondition does.
+  CHECKED_STATUS MatchValue(const QLValuePB& value, bool* match) const;
+
+  // Evaluates the conjunct for values_ using integer comparisons, setting matches_.
+  CHECKED_STATUS MatchIntegers();
+
+  const QLOperator op_;
+  const ColumnIdRep column_id_;
+
+  // The constant operands: the value to compare with, the lower and upper bounds of BETWEEN, or
+  // the elements of the IN list.
+  const std::vector<QLValuePB> operands_;
+
+  // Set if all constant operands are non-null integers of the same type integer_type_. Column
+  // values are compared as integers in this case.
+  bool use_integers_ = false;
+  QLValuePB::ValueCase integer_type_ = QLValuePB::VALUE_NOT_SET;
+  // The constant operands as integers, sorted in case of IN and NOT IN.
+  std::vector<int64_t> integer_operands_;
+
+  // Scratch buffers reused between batches: the column values of the selected rows (nullptr if the
+  // column is absent), their integer values and null flags, and the match results.
+  std::vector<const QLValuePB*> values_;
+  std::vector<int64_t> integers_;
+  std::vector<uint8_t> nulls_;
+  std::vector<uint8_t> matches_;
+};
+
+std::unique_ptr<QLBatchCondition::ColumnConjunct> QLBatchCondition::ColumnConjunct::Compile(
+    const QLConditionPB& condition) {
+  const auto& operands = condition.operands();
+  auto is_column = [&operands](int index) {
+    return operands.Get(index).expr_case() == QLExpressionPB::ExprCase::kColumnId;
+  };
+  auto is_value = [&operands](int index) {
+    return operands.Get(index).expr_case() == QLExpressionPB::ExprCase::kValue;
+  };
+
+  QLOperator op = condition.op();
+  std::vector<QLValuePB> values;
+  int column_index = 0;
+  switch (op) {
+    case QL_OP_EQUAL: FALLTHROUGH_INTENDED;
+    case QL_OP_NOT_EQUAL: FALLTHROUGH_INTENDED;
+    case QL_OP_LESS_THAN: FALLTHROUGH_INTENDED;
+    case QL_OP_LESS_THAN_EQUAL: FALLTHROUGH_INTENDED;
+    case QL_OP_GREATER_THAN: FALLTHROUGH_INTENDED;
+    case QL_OP_GREATER_THAN_EQUAL:
+      if (operands.size() != 2) {
+        return nullptr;
+      }
+      if (is_column(0) && is_value(1)) {
+        values.push_back(operands.Get(1).value());
+      } else if (is_value(0) && is_column(1)) {
+        column_index = 1;
+        op = SwappedComparison(op);
+        values.push_back(operands.Get(0).value());
+      } else {
+        return nullptr;
+      }
+      break;
+
+    case QL_OP_BETWEEN: FALLTHROUGH_INTENDED;
+    case QL_OP_NOT_BETWEEN:
+      if (operands.size() != 3 || !is_column(0) || !is_value(1) || !is_value(2)) {
+        return nullptr;
+      }
+      values.push_back(operands.Get(1).value());
+      values.push_back(operands.Get(2).value());
+      break;
+
+    case QL_OP_IN: FALLTHROUGH_INTENDED;
+    case QL_OP_NOT_IN:
+      if (operands.size() != 2 || !is_column(0) || !is_value(1)) {
+        return nullptr;
+      }
+      for (const QLValuePB& elem : operands.Get(1).value().list_value().elems()) {
+        values.push_back(elem);
+      }
+      break;
+
+    case QL_OP_IS_NULL: FALLTHROUGH_INTENDED;
+    case QL_OP_IS_NOT_NULL:
+      if (operands.size() != 1 || !is_column(0)) {
+        return nullptr;
+      }
+      break;
+
+    default:
+      return nullptr;
+  }
+
+  return std::unique_ptr<ColumnConjunct>(new ColumnConjunct(
+      op, operands.Get(column_index).column_id(), std::move(values)));
+}
+
+QLBatchCondition::ColumnConjunct::ColumnConjunct(
+    QLOperator op, ColumnIdRep column_id, std::vector<QLValuePB> operands)
+    : op_(op), column_id_(column_id), operands_(std::move(operands)) {
+  if (op_ == QL_OP_IS_NULL || op_ == QL_OP_IS_NOT_NULL || operands_.empty()) {
+    return;
+  }
+  integer_type_ = operands_.front().value_case();
+  if (!IsIntegerType(integer_type_)) {
+    return;
+  }
+  for (const QLValuePB& operand : operands_) {
+    if (operand.value_case() != integer_type_) {
+      return;
+    }
+    integer_operands_.push_back(GetInteger(operand));
+  }
+  if (op_ == QL_OP_IN || op_ == QL_OP_NOT_IN) {
+    std::sort(integer_operands_.begin(), integer_operands_.end());
+  }
+  use_integers_ = true;
+}
+
+Status QLBatchCondition::ColumnConjunct::MatchValue(const QLValuePB& value, bool* match) const {
+#define QL_MATCH_RELATIONAL_OP(op)                                                                 \
+  do {                                                                                             \
+    if (!Comparable(value, operands_[0])) {                                                        \
+      return NotComparable();                                                                      \
+    }                                                                                              \
+    *match = value op operands_[0];                                                                \
+    return Status::OK();                                                                           \
+  } while (false)
+
+  switch (op_) {
+    case QL_OP_EQUAL:
+      QL_MATCH_RELATIONAL_OP(==);
+
+    case QL_OP_NOT_EQUAL:
+      QL_MATCH_RELATIONAL_OP(!=);
+
+    case QL_OP_LESS_THAN:
+      QL_MATCH_RELATIONAL_OP(<);                                                         // NOLINT
+
+    case QL_OP_LESS_THAN_EQUAL:
+      QL_MATCH_RELATIONAL_OP(<=);
+
+    case QL_OP_GREATER_THAN:
+      QL_MATCH_RELATIONAL_OP(>);                                                         // NOLINT
+
+    case QL_OP_GREATER_THAN_EQUAL:
+      QL_MATCH_RELATIONAL_OP(>=);
+
+    case QL_OP_BETWEEN:
+      if (!Comparable(value, operands_[0]) || !Comparable(value, operands_[1])) {
+        return NotComparable();
+      }
+      *match = value >= operands_[0] && value <= operands_[1];
+      return Status::OK();
+
+    case QL_OP_NOT_BETWEEN:
+      if (!Comparable(value, operands_[0]) || !Comparable(value, operands_[1])) {
+        return NotComparable();
+      }
+      *match = value < operands_[0] || value > operands_[1];
+      return Status::OK();
+
+    case QL_OP_IN: FALLTHROUGH_INTENDED;
+    case QL_OP_NOT_IN: {
+      bool found = false;
+      for (const QLValuePB& elem : operands_) {
+        if (!Comparable(elem, value)) {
+          return NotComparable();
+        }
+        if (elem == value) {
+          found = true;
+          break;
+        }
+      }
+      *match = (op_ == QL_OP_IN) == found;
+      return Status::OK();
+    }
+
+    case QL_OP_IS_NULL:
+      *match = IsNull(value);
+      return Status::OK();
+
+    case QL_OP_IS_NOT_NULL:
+      *match = !IsNull(value);
+      return Status::OK();
+
+    default:
+      break;
+  }
+  return STATUS_FORMAT(IllegalState, "Unexpected operator $0", op_);
+
+#undef QL_MATCH_RELATIONAL_OP
+}
+
+Status QLBatchCondition::ColumnConjunct::MatchIntegers() {
+  const size_t size = values_.size();
+  integers_.resize(size);
+  nulls_.resize(size);
+  matches_.resize(size);
+  for (size_t i = 0; i != size; ++i) {
+    const QLValuePB* value = values_[i];
+    if (value == nullptr || IsNull(*value)) {
+      nulls_[i] = true;
+      integers_[i] = 0;
+    } else if (value->value_case() != integer_type_) {
+      return NotComparable();
+    } else {
+      nulls_[i] = false;
+      integers_[i] = GetInteger(*value);
+    }
+  }
+
+  const int64_t operand = integer_operands_.front();
+  switch (op_) {
+    case QL_OP_EQUAL:
+      EvaluateIntegers(integers_, [operand](int64_t v) { return v == operand; }, &matches_);
+      break;
+    case QL_OP_NOT_EQUAL:
+      EvaluateIntegers(integers_, [operand](int64_t v) { return v != operand; }, &matches_);
+      break;
+    case QL_OP_LESS_THAN:
+      EvaluateIntegers(integers_, [operand](int64_t v) { return v < operand; }, &matches_);
+      break;
+    case QL_OP_LESS_THAN_EQUAL:
+      EvaluateIntegers(integers_, [operand](int64_t v) { return v <= operand; }, &matches_);
+      break;
+    case QL_OP_GREATER_THAN:
+      EvaluateIntegers(integers_, [operand](int64_t v) { return v > operand; }, &matches_);
+      break;
+    case QL_OP_GREATER_THAN_EQUAL:
+      EvaluateIntegers(integers_, [operand](int64_t v) { return v >= operand; }, &matches_);
+      break;
+    case QL_OP_BETWEEN: {
+      const int64_t upper = integer_operands_[1];
+      EvaluateIntegers(
+          integers_, [operand, upper](int64_t v) { return (v >= operand) & (v <= upper); },
+          &matches_);
+      break;
+    }
+    case QL_OP_NOT_BETWEEN: {
+      const int64_t upper = integer_operands_[1];
+      EvaluateIntegers(
+          integers_, [operand, upper](int64_t v) { return (v < operand) | (v > upper); },
+          &matches_);
+      break;
+    }
+    case QL_OP_IN: FALLTHROUGH_INTENDED;
+    case QL_OP_NOT_IN: {
+      const bool in = op_ == QL_OP_IN;
+      for (size_t i = 0; i != size; ++i) {
+        matches_[i] = std::binary_search(
+            integer_operands_.begin(), integer_operands_.end(), integers_[i]) == in;
+      }
+      break;
+    }
+    default:
+      return STATUS_FORMAT(IllegalState, "Unexpected operator $0", op_);
+  }
+
+  // A null value does not match any comparison with a non-null constant, and is therefore only
+  // selected by NOT IN.
+  const uint8_t null_match = op_ == QL_OP_NOT_IN;
+  for (size_t i = 0; i != size; ++i) {
+    if (nulls_[i]) {
+      matches_[i] = null_match;
+    }
+  }
+  return Status::OK();
+}
+
+Status QLBatchCondition::ColumnConjunct::Filter(const std::vector<QLTableRow>& rows,
+                                                std::vector<size_t>* selection) {
+  // Gather the column values of the selected rows.
+  values_.clear();
+  for (const size_t index : *selection) {
+    values_.push_back(rows[index].GetColumnValue(column_id_));
+  }
+
+  if (use_integers_) {
+    RETURN_NOT_OK(MatchIntegers());
+  } else {
+    matches_.resize(values_.size());
+    for (size_t i = 0; i != values_.size(); ++i) {
+      const QLValuePB& value = values_[i] != nullptr ? *values_[i] : QLValuePB::default_instance();
+      bool match = false;
+      RETURN_NOT_OK(MatchValue(value, &match));
+      matches_[i] = match;
+    }
+  }
+
+  size_t num_selected = 0;
+  for (size_t i = 0; i != selection->size(); ++i) {
+    if (matches_[i]) {
+      (*selection)[num_selected++] = (*selection)[i];
+    }
+  }
+  selection->resize(num_selected);
+  return Status::OK();
+}
+
+//--------------------------------------------------------------------------------------------------
+
+QLBatchCondition::QLBatchCondition(const QLConditionPB& condition,
+                                   QLExprExecutor::SharedPtr executor)
+    : executor_(std::move(executor)) {
+  AddConjuncts(condition);
+}
+
+QLBatchCondition::~QLBatchCondition() {
+}
+
+void QLBatchCondition::AddConjuncts(const QLConditionPB& condition) {
+  if (condition.op() == QL_OP_AND && condition.operands_size() > 0 &&
+      std::all_of(condition.operands().begin(), condition.operands().end(),
+                  [](const QLExpressionPB& operand) {
+                    return operand.expr_case() == QLExpressionPB::ExprCase::kCondition;
+                  })) {
+    for (const QLExpressionPB& operand : condition.operands()) {
+      AddConjuncts(operand.condition());
+    }
+    return;
+  }
+
+  auto column_conjunct = ColumnConjunct::Compile(condition);
+  if (column_conjunct != nullptr) {
+    conjuncts_.push_back(std::move(column_conjunct));
+  } else {
+    conjuncts_.emplace_back(new RowConjunct(condition, executor_.get()));
+  }
+}
+
+Status QLBatchCondition::Match(const std::vector<QLTableRow>& rows, size_t num_rows,
+                               std::vector<size_t>* selection) {
+  DCHECK_LE(num_rows, rows.size());
+  selection->resize(num_rows);
+  std::iota(selection->begin(), selection->end(), 0);
+  for (const auto& conjunct : conjuncts_) {
+    if (selection->empty()) {
+      break;
+    }
+    RETURN_NOT_OK(conjunct->Filter(rows, selection));
+  }
+  return Status::OK();
+}
+
+size_t QLBatchCondition::TEST_num_column_conjuncts() const {
+  return std::count_if(conjuncts_.begin(), conjuncts_.end(),
+                       [](const std::unique_ptr<Conjunct>& conjunct) {
+                         return conjunct->is_column_conjunct();
+                       });
+}
+
+} // namespace yb
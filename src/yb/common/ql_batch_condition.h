@@ -0,0 +1,65 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+//
+// This file contains QLBatchCondition that evaluates a QL condition over batches of rows.
+
+#ifndef YB_COMMON_QL_BATCH_CONDITION_H
+#define YB_COMMON_QL_BATCH_CONDITION_H
+
+#include <memory>
+#include <vector>
+
+#include "yb/common/ql_expr.h"
+#include "yb/common/ql_protocol.pb.h"
+
+namespace yb {
+
+// Evaluates a QL condition (e.g. a WHERE clause) over a batch of rows at a time.
+//
+// The condition is compiled once into its top-level conjuncts. Conjuncts that compare a column
+// with constants (=, !=, <, <=, >, >=, BETWEEN, NOT BETWEEN, IN, NOT IN, IS NULL, IS NOT NULL)
+// are evaluated column-at-a-time: the column values of the selected rows are gathered into a
+// vector, and only the rows matching the conjunct are kept in the selection vector. Integer
+// columns are gathered into plain integer arrays so that the comparison loops can be vectorized by
+// the compiler. All other conjuncts are evaluated row by row with QLExprExecutor. Conjuncts are
+// evaluated in order over the rows selected by the preceding ones, so the result (including errors
+// for values that are not comparable) is the same as evaluating the condition row by row.
+//
+// This class is not thread-safe, since it keeps scratch buffers between batches.
+class QLBatchCondition {
+ public:
+  QLBatchCondition(const QLConditionPB& condition, QLExprExecutor::SharedPtr executor);
+  ~QLBatchCondition();
+
+  // Sets selection to the indexes, in increasing order, of the first num_rows rows that match the
+  // condition.
+  CHECKED_STATUS Match(const std::vector<QLTableRow>& rows, size_t num_rows,
+                       std::vector<size_t>* selection);
+
+  // Number of conjuncts that are evaluated column-at-a-time, for testing.
+  size_t TEST_num_column_conjuncts() const;
+
+ private:
+  class Conjunct;
+  class ColumnConjunct;
+  class RowConjunct;
+
+  void AddConjuncts(const QLConditionPB& condition);
+
+  QLExprExecutor::SharedPtr executor_;
+  std::vector<std::unique_ptr<Conjunct>> conjuncts_;
+};
+
+} // namespace yb
+
+#endif // YB_COMMON_QL_BATCH_CONDITION_H
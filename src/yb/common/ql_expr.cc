@@ -155,7 +155,8 @@ CHECKED_STATUS QLExprExecutor::EvalCondition(const QLConditionPB& condition,
       if (!temp.Comparable(lower) || !temp.Comparable(upper)) {                                    \
         return STATUS(RuntimeError, "values not comparable");                                      \
       }                                                                                            \
-      result->set_bool_value(temp.value() >= lower.value() rel_op temp.value() <= upper.value());  \
+      result->set_bool_value(                                                                      \
+          temp.value() op1 lower.value() rel_op temp.value() op2 upper.value());                   \
       return Status::OK();                                                                         \
   } while (false)
 
@@ -322,6 +323,11 @@ CHECKED_STATUS QLTableRow::ReadColumn(ColumnIdRep col_id, QLValue *col_value) co
   return Status::OK();
 }
 
+const QLValuePB* QLTableRow::GetColumnValue(ColumnIdRep col_id) const {
+  const auto& col_iter = col_map_.find(col_id);
+  return col_iter == col_map_.end() ? nullptr : &col_iter->second.value;
+}
+
 CHECKED_STATUS QLTableRow::ReadSubscriptedColumn(const QLSubscriptedColPB& subcol,
                                                  const QLValue& index_arg,
                                                  QLValue *col_value) const {
@@ -89,6 +89,9 @@ class QLTableRow {
 
   // Get the column value in PB format.
   CHECKED_STATUS ReadColumn(ColumnIdRep col_id, QLValue *col_value) const;
+
+  // Get a pointer to the column value without copying it, or nullptr if the column is not cached.
+  const QLValuePB* GetColumnValue(ColumnIdRep col_id) const;
   CHECKED_STATUS ReadSubscriptedColumn(const QLSubscriptedColPB& subcol,
                                        const QLValue& index,
                                        QLValue *col_value) const;
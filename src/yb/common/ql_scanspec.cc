@@ -15,6 +15,10 @@
 
 #include "yb/common/ql_scanspec.h"
 
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+
 namespace yb {
 namespace common {
 
@@ -83,6 +87,9 @@ QLScanRange::QLScanRange(const Schema& schema, const QLConditionPB& condition)
         const ColumnId column_id(col_expr->column_id());
         ranges_.at(column_id).min_value = val_expr->value();
         ranges_.at(column_id).max_value = val_expr->value();
+        if (!IsNull(val_expr->value())) {
+          options_[column_id] = { val_expr->value() };
+        }
       }
       return;
     }
@@ -137,13 +144,21 @@ QLScanRange::QLScanRange(const Schema& schema, const QLConditionPB& condition)
     case QL_OP_IN: {
       if (has_range_column) {
         QL_GET_COLUMN_VALUE_EXPR_ELSE_RETURN(col_expr, val_expr);
-        // - <column> IN (<value>) --> min/max values = <value>
-        // TODO(Mihnea) handle the other cases here too
-        if (val_expr->value().list_value().elems_size() == 1) {
-          QLValuePB value = val_expr->value().list_value().elems(0);
+        // - <column> IN (<values>) --> min/max values = smallest/largest <value>,
+        //                              options = <values>
+        vector<QLValuePB> values;
+        for (const auto& elem : val_expr->value().list_value().elems()) {
+          if (!IsNull(elem)) {
+            values.push_back(elem);
+          }
+        }
+        if (!values.empty()) {
+          std::sort(values.begin(), values.end());
+          values.erase(std::unique(values.begin(), values.end()), values.end());
           const ColumnId column_id(col_expr->column_id());
-          ranges_.at(column_id).min_value = value;
-          ranges_.at(column_id).max_value = value;
+          ranges_.at(column_id).min_value = values.front();
+          ranges_.at(column_id).max_value = values.back();
+          options_[column_id] = std::move(values);
         }
       }
       return;
@@ -162,9 +177,17 @@ QLScanRange::QLScanRange(const Schema& schema, const QLConditionPB& condition)
     }
     case QL_OP_OR: {
       CHECK_GT(operands.size(), 0);
+      // Start from the range of the first operand, the union with the initial unbounded range
+      // would be unbounded.
+      bool first = true;
       for (const auto& operand : operands) {
         CHECK_EQ(operand.expr_case(), QLExpressionPB::ExprCase::kCondition);
-        *this |= QLScanRange(schema_, operand.condition());
+        if (first) {
+          *this = QLScanRange(schema_, operand.condition());
+          first = false;
+        } else {
+          *this |= QLScanRange(schema_, operand.condition());
+        }
       }
       return;
     }
@@ -218,6 +241,25 @@ QLScanRange& QLScanRange::operator&=(const QLScanRange& other) {
       range.max_value = other_range.max_value;
     }
   }
+
+  // Intersect operation for options: values present in both. An empty intersection means no row
+  // can match, which the WHERE condition will filter out, so just drop the options then.
+  for (const auto& elem : other.options_) {
+    auto it = options_.find(elem.first);
+    if (it == options_.end()) {
+      options_.insert(elem);
+      continue;
+    }
+    vector<QLValuePB> intersection;
+    std::set_intersection(it->second.begin(), it->second.end(),
+                          elem.second.begin(), elem.second.end(),
+                          std::back_inserter(intersection));
+    if (intersection.empty()) {
+      options_.erase(it);
+    } else {
+      it->second = std::move(intersection);
+    }
+  }
   return *this;
 }
 
@@ -241,6 +283,21 @@ QLScanRange& QLScanRange::operator|=(const QLScanRange& other) {
       SetNull(&range.max_value);
     }
   }
+
+  // Union operation for options: a column stays restricted only if it is restricted on both sides.
+  for (auto it = options_.begin(); it != options_.end();) {
+    auto other_it = other.options_.find(it->first);
+    if (other_it == other.options_.end()) {
+      it = options_.erase(it);
+      continue;
+    }
+    vector<QLValuePB> merged;
+    std::set_union(it->second.begin(), it->second.end(),
+                   other_it->second.begin(), other_it->second.end(),
+                   std::back_inserter(merged));
+    it->second = std::move(merged);
+    ++it;
+  }
   return *this;
 }
 
@@ -261,11 +318,14 @@ QLScanRange& QLScanRange::operator~() {
       range.min_value.Swap(&range.max_value);
     }
   }
+  // The complement of a finite set of values is not finite.
+  options_.clear();
   return *this;
 }
 
 QLScanRange& QLScanRange::operator=(QLScanRange&& other) {
   ranges_ = std::move(other.ranges_);
+  options_ = std::move(other.options_);
   return *this;
 }
 
@@ -286,6 +346,33 @@ vector<QLValuePB> QLScanRange::range_values(const bool lower_bound) const {
   return range_values;
 }
 
+vector<vector<QLValuePB>> QLScanRange::range_options() const {
+  vector<vector<QLValuePB>> result;
+  for (size_t i = 0; i < schema_.num_key_columns(); i++) {
+    if (!schema_.column(i).is_hash_key()) {
+      const ColumnId column_id = schema_.column_id(i);
+      auto it = options_.find(column_id);
+      if (it == options_.end()) {
+        break;
+      }
+      // Leave out the values outside the column's bounds, e.g. for "r IN (1, 5) AND r > 3".
+      const auto& range = ranges_.at(column_id);
+      vector<QLValuePB> values;
+      for (const auto& value : it->second) {
+        if ((IsNull(range.min_value) || value >= range.min_value) &&
+            (IsNull(range.max_value) || value <= range.max_value)) {
+          values.push_back(value);
+        }
+      }
+      if (values.empty()) {
+        break;
+      }
+      result.push_back(std::move(values));
+    }
+  }
+  return result;
+}
+
 //-------------------------------------- QL scan spec ---------------------------------------
 
 QLScanSpec::QLScanSpec(QLExprExecutor::SharedPtr executor) : QLScanSpec(nullptr, true, executor) {
@@ -309,5 +396,18 @@ CHECKED_STATUS QLScanSpec::Match(const QLTableRow& table_row, bool* match) const
   return Status::OK();
 }
 
+CHECKED_STATUS QLScanSpec::MatchBatch(const std::vector<QLTableRow>& rows, size_t num_rows,
+                                      std::vector<size_t>* selection) const {
+  if (condition_ == nullptr) {
+    selection->resize(num_rows);
+    std::iota(selection->begin(), selection->end(), 0);
+    return Status::OK();
+  }
+  if (batch_condition_ == nullptr) {
+    batch_condition_.reset(new QLBatchCondition(*condition_, executor_));
+  }
+  return batch_condition_->Match(rows, num_rows, selection);
+}
+
 } // namespace common
 } // namespace yb
@@ -19,6 +19,7 @@
 #include <map>
 
 #include "yb/common/schema.h"
+#include "yb/common/ql_batch_condition.h"
 #include "yb/common/ql_protocol.pb.h"
 #include "yb/common/ql_rowblock.h"
 #include "yb/common/ql_expr.h"
@@ -42,6 +43,11 @@ class QLScanRange {
   // Return the inclusive lower and upper range values to scan.
   std::vector<QLValuePB> range_values(bool lower_bound) const;
 
+  // Return the sorted distinct values of the leading range columns that the condition restricts
+  // to a finite set of values (through = or IN), up to the first range column that is not
+  // restricted this way.
+  std::vector<std::vector<QLValuePB>> range_options() const;
+
   // Intersect / union / complement operators.
   QLScanRange& operator&=(const QLScanRange& other);
   QLScanRange& operator|=(const QLScanRange& other);
@@ -56,6 +62,10 @@ class QLScanRange {
 
   // Mapping of column id to the column value ranges (inclusive lower/upper bounds) to scan.
   std::unordered_map<ColumnId, QLRange> ranges_;
+
+  // Mapping of column id to the sorted distinct values to scan, for the range columns that are
+  // restricted to a finite set of values. Never contains an empty set.
+  std::unordered_map<ColumnId, std::vector<QLValuePB>> options_;
 };
 
 // A scan specification for a QL scan. It may be used to scan either a specified doc key
@@ -75,6 +85,16 @@ class QLScanSpec {
   // virtual to make the class polymorphic.
   virtual CHECKED_STATUS Match(const QLTableRow& table_row, bool* match) const;
 
+  // Evaluate the WHERE condition for the first num_rows rows, and set selection to the indexes of
+  // the selected ones. Gives the same result as calling Match() for each row, but evaluates
+  // simple conditions a column at a time.
+  virtual CHECKED_STATUS MatchBatch(const std::vector<QLTableRow>& rows, size_t num_rows,
+                                    std::vector<size_t>* selection) const;
+
+  bool has_condition() const {
+    return condition_ != nullptr;
+  }
+
   bool is_forward_scan() const {
     return is_forward_scan_;
   }
@@ -83,6 +103,9 @@ class QLScanSpec {
   const QLConditionPB* condition_;
   const bool is_forward_scan_;
   QLExprExecutor::SharedPtr executor_;
+
+  // The WHERE condition compiled for batch evaluation, created on first use by MatchBatch().
+  mutable std::unique_ptr<QLBatchCondition> batch_condition_;
 };
 
 } // namespace common
@@ -425,18 +425,27 @@ class TableProperties {
   TableProperties()
       : default_time_to_live_(kNoDefaultTtl),
         contain_counters_(false),
-        is_transactional_(false) {}
+        is_transactional_(false),
+        block_cache_priority_(BLOCK_CACHE_PRIORITY_DEFAULT),
+        use_packed_rows_(false),
+        use_range_tombstones_(false),
+        drop_expired_files_(false) {}
 
   TableProperties(const TableProperties& other) {
     default_time_to_live_ = other.default_time_to_live_;
     contain_counters_ = other.contain_counters_;
     is_transactional_ = other.is_transactional_;
+    block_cache_priority_ = other.block_cache_priority_;
+    use_packed_rows_ = other.use_packed_rows_;
+    use_range_tombstones_ = other.use_range_tombstones_;
+    drop_expired_files_ = other.drop_expired_files_;
   }
 
   // Containing counters is a internal property instead of a user-defined property, so we don't use
   // it when comparing table properties.
   bool operator==(const TableProperties& other) const {
-    return (default_time_to_live_ == other.default_time_to_live_);
+    return default_time_to_live_ == other.default_time_to_live_ &&
+           block_cache_priority_ == other.block_cache_priority_;
   }
 
   bool operator!=(const TableProperties& other) const {
@@ -471,12 +480,56 @@ class TableProperties {
     is_transactional_ = is_transactional;
   }
 
+  BlockCachePriorityPB block_cache_priority() const {
+    return block_cache_priority_;
+  }
+
+  void SetBlockCachePriority(BlockCachePriorityPB block_cache_priority) {
+    block_cache_priority_ = block_cache_priority;
+  }
+
+  bool use_packed_rows() const {
+    return use_packed_rows_;
+  }
+
+  void SetUsePackedRows(bool use_packed_rows) {
+    use_packed_rows_ = use_packed_rows;
+  }
+
+  bool use_range_tombstones() const {
+    return use_range_tombstones_;
+  }
+
+  void SetUseRangeTombstones(bool use_range_tombstones) {
+    use_range_tombstones_ = use_range_tombstones;
+  }
+
+  bool drop_expired_files() const {
+    return drop_expired_files_;
+  }
+
+  void SetDropExpiredFiles(bool drop_expired_files) {
+    drop_expired_files_ = drop_expired_files;
+  }
+
   void ToTablePropertiesPB(TablePropertiesPB *pb) const {
     if (HasDefaultTimeToLive()) {
       pb->set_default_time_to_live(default_time_to_live_);
     }
     pb->set_contain_counters(contain_counters_);
     pb->set_is_transactional(is_transactional_);
+    if (block_cache_priority_ != BLOCK_CACHE_PRIORITY_DEFAULT) {
+      pb->set_block_cache_priority(block_cache_priority_);
+    }
+    if (use_packed_rows_) {
+      pb->set_use_packed_rows(use_packed_rows_);
+    }
+    if (use_range_tombstones_) {
+      pb->set_use_range_tombstones(use_range_tombstones_);
+    }
+    if (drop_expired_files_) {
+      pb->set_drop_expired_files(drop_expired_files_);
+    }
   }
 
   static TableProperties FromTablePropertiesPB(const TablePropertiesPB& pb) {
@@ -490,6 +543,18 @@ class TableProperties {
     if (pb.has_is_transactional()) {
       table_properties.SetTransactional(pb.is_transactional());
     }
+    if (pb.has_block_cache_priority()) {
+      table_properties.SetBlockCachePriority(pb.block_cache_priority());
+    }
+    if (pb.has_use_packed_rows()) {
+      table_properties.SetUsePackedRows(pb.use_packed_rows());
+    }
+    if (pb.has_use_range_tombstones()) {
+      table_properties.SetUseRangeTombstones(pb.use_range_tombstones());
+    }
+    if (pb.has_drop_expired_files()) {
+      table_properties.SetDropExpiredFiles(pb.drop_expired_files());
+    }
     return table_properties;
   }
 
@@ -500,12 +565,23 @@ class TableProperties {
     if (pb.has_is_transactional()) {
       SetTransactional(pb.is_transactional());
     }
+    if (pb.has_block_cache_priority()) {
+      SetBlockCachePriority(pb.block_cache_priority());
+    }
+    // use_packed_rows is fixed when the table is created, since packed rows that were already
+    // written are only read back for tables that have it set. The same applies to
+    // use_range_tombstones. drop_expired_files is fixed as well, since it is only applied when a
+    // tablet is opened.
   }
 
   void Reset() {
     default_time_to_live_ = kNoDefaultTtl;
     contain_counters_ = false;
     is_transactional_ = false;
+    block_cache_priority_ = BLOCK_CACHE_PRIORITY_DEFAULT;
+    use_packed_rows_ = false;
+    use_range_tombstones_ = false;
+    drop_expired_files_ = false;
   }
 
  private:
@@ -513,6 +589,10 @@ class TableProperties {
   int64_t default_time_to_live_;
   bool contain_counters_;
   bool is_transactional_;
+  BlockCachePriorityPB block_cache_priority_;
+  bool use_packed_rows_;
+  bool use_range_tombstones_;
+  bool drop_expired_files_;
 };
 
 // The schema for a set of rows.
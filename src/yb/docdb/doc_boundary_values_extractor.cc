@@ -16,6 +16,9 @@
 #include "yb/rocksdb/db/dbformat.h"
 
 #include "yb/docdb/doc_key.h"
+#include "yb/docdb/doc_kv_util.h"
+#include "yb/docdb/value.h"
+#include "yb/gutil/endian.h"
 
 namespace yb {
 namespace docdb {
@@ -29,6 +32,7 @@ Status GetPrimitiveValue(const rocksdb::UserBoundaryValues& values,
 namespace {
 
 constexpr rocksdb::UserBoundaryTag kDocHybridTimeTag = 1;
+constexpr rocksdb::UserBoundaryTag kValueTtlTag = 2;
 // Here we reserve some tags for future use.
 // Because Tag is persistent.
 constexpr rocksdb::UserBoundaryTag kRangeComponentsStart = 10;
@@ -79,6 +83,65 @@ class DocHybridTimeValue : public rocksdb::UserBoundaryValue {
   Slice encoded_;
 };
 
+// Wrapper for UserBoundaryValue that stores the TTL of a value, so that the smallest and largest
+// boundaries of a file tell the range of TTLs of its values. The TTL is stored as 8 big-endian
+// bytes: kTableTtl if the value has no TTL of its own and uses the table TTL, kNoExpiration if the
+// value never expires (its TTL was reset, or it is not a regular value), and the TTL in
+// milliseconds otherwise.
+class ValueTtlBoundaryValue : public rocksdb::UserBoundaryValue {
+ public:
+  static constexpr uint64_t kTableTtl = 0;
+  static constexpr uint64_t kNoExpiration = std::numeric_limits<uint64_t>::max();
+  static constexpr size_t kEncodedSize = sizeof(uint64_t);
+
+  explicit ValueTtlBoundaryValue(uint64_t ttl) {
+    BigEndian::Store64(buffer_, ttl);
+  }
+
+  static CHECKED_STATUS Create(Slice data, rocksdb::UserBoundaryValuePtr* value) {
+    CHECK_NOTNULL(value);
+    uint64_t ttl = 0;
+    RETURN_NOT_OK(Decode(data, &ttl));
+    *value = std::make_shared<ValueTtlBoundaryValue>(ttl);
+    return Status::OK();
+  }
+
+  static CHECKED_STATUS Decode(Slice data, uint64_t* ttl) {
+    if (data.size() != kEncodedSize) {
+      return STATUS_SUBSTITUTE(Corruption, "Bad encoded value TTL size: $0", data.size());
+    }
+    *ttl = BigEndian::Load64(data.data());
+    return Status::OK();
+  }
+
+  // Returns the encoded TTL of a value with the given TTL, as decoded by Value::DecodeTTL.
+  static uint64_t FromValueTtl(const MonoDelta& ttl) {
+    if (ttl.Equals(Value::kMaxTtl)) {
+      return kTableTtl;
+    }
+    const uint64_t ttl_msec = ttl.ToMilliseconds();
+    return ttl_msec == kResetTTL ? kNoExpiration : ttl_msec;
+  }
+
+  virtual ~ValueTtlBoundaryValue() {}
+
+  rocksdb::UserBoundaryTag Tag() override {
+    return kValueTtlTag;
+  }
+
+  Slice Encode() override {
+    return Slice(buffer_, kEncodedSize);
+  }
+
+  int CompareTo(const UserBoundaryValue& pre_rhs) override {
+    const auto* rhs = down_cast<const ValueTtlBoundaryValue*>(&pre_rhs);
+    return memcmp(buffer_, rhs->buffer_, kEncodedSize);
+  }
+
+ private:
+  uint8_t buffer_[kEncodedSize];
+};
+
 // Wrapper for UserBoundaryValue that stores PrimitiveValue with index.
 class PrimitiveBoundaryValue : public rocksdb::UserBoundaryValue {
  public:
@@ -146,6 +209,9 @@ class DocBoundaryValuesExtractor : public rocksdb::BoundaryValuesExtractor {
     if (tag == kDocHybridTimeTag) {
       return DocHybridTimeValue::Create(data, value);
     }
+    if (tag == kValueTtlTag) {
+      return ValueTtlBoundaryValue::Create(data, value);
+    }
     if (tag >= kRangeComponentsStart) {
       return PrimitiveBoundaryValue::Create(tag - kRangeComponentsStart, data, value);
     }
@@ -177,6 +243,15 @@ class DocBoundaryValuesExtractor : public rocksdb::BoundaryValuesExtractor {
     RETURN_NOT_OK(DocHybridTimeValue::Create(slices.back(), &temp));
     values->push_back(std::move(temp));
 
+    // Intents are not regular values, so they are recorded as never expiring.
+    uint64_t ttl = ValueTtlBoundaryValue::kNoExpiration;
+    if (static_cast<ValueType>(user_key[0]) != ValueType::kIntentPrefix) {
+      MonoDelta value_ttl;
+      RETURN_NOT_OK(Value::DecodeTTL(value, &value_ttl));
+      ttl = ValueTtlBoundaryValue::FromValueTtl(value_ttl);
+    }
+    values->push_back(std::make_shared<ValueTtlBoundaryValue>(ttl));
+
     for (size_t i = 0; i != size; ++i) {
       RETURN_NOT_OK(PrimitiveBoundaryValue::Create(i, slices[i], &temp));
       values->push_back(std::move(temp));
@@ -252,5 +327,34 @@ rocksdb::UserBoundaryTag TagForRangeComponent(size_t index) {
   return PrimitiveBoundaryValue::TagForIndex(index);
 }
 
+rocksdb::UserBoundaryTag TagForDocHybridTime() {
+  return kDocHybridTimeTag;
+}
+
+rocksdb::UserBoundaryTag TagForValueTtl() {
+  return kValueTtlTag;
+}
+
+MonoDelta MaxValueTtl(const Slice* smallest, const Slice* largest, const MonoDelta& table_ttl) {
+  uint64_t smallest_ttl = 0, largest_ttl = 0;
+  if (smallest == nullptr || largest == nullptr ||
+      !ValueTtlBoundaryValue::Decode(*smallest, &smallest_ttl).ok() ||
+      !ValueTtlBoundaryValue::Decode(*largest, &largest_ttl).ok() ||
+      largest_ttl == ValueTtlBoundaryValue::kNoExpiration) {
+    return Value::kMaxTtl;
+  }
+  MonoDelta result = MonoDelta::FromMilliseconds(largest_ttl);
+  if (smallest_ttl == ValueTtlBoundaryValue::kTableTtl) {
+    // Some values use the table TTL.
+    if (table_ttl.Equals(Value::kMaxTtl)) {
+      return Value::kMaxTtl;
+    }
+    if (largest_ttl == ValueTtlBoundaryValue::kTableTtl || table_ttl.MoreThan(result)) {
+      result = table_ttl;
+    }
+  }
+  return result;
+}
+
 } // namespace docdb
 } // namespace yb
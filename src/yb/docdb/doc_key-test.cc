@@ -330,6 +330,54 @@ TEST(DocKeyTest, TestNumSharedPrefixComponents) {
                 PrimitiveValue("some_more"))));
 }
 
+TEST(DocKeyTest, TestSubDocKeyView) {
+  RandomNumberGenerator rng;  // Use the default seed to keep it deterministic.
+  for (auto use_hash : UseHash::kValues) {
+    const auto subdoc_keys = GenRandomSubDocKeys(&rng, use_hash, kNumDocOrSubDocKeysPerBatch);
+    std::vector<KeyBytes> encoded_keys;
+    for (const auto& subdoc_key : subdoc_keys) {
+      encoded_keys.push_back(subdoc_key.Encode());
+      SubDocKeyView view;
+      ASSERT_OK(view.Decode(encoded_keys.back().AsSlice()));
+      ASSERT_EQ(subdoc_key.doc_key().Encode().AsSlice(), view.doc_key());
+      ASSERT_EQ(subdoc_key.Encode(/* include_hybrid_time */ false).AsSlice(),
+                view.key_without_ht());
+      ASSERT_EQ(subdoc_key.doc_hybrid_time(), view.doc_hybrid_time());
+      ASSERT_EQ(subdoc_key.num_subkeys(), view.num_subkeys());
+      for (int i = 0; i < view.num_subkeys(); ++i) {
+        PrimitiveValue subkey;
+        ASSERT_OK(view.DecodeSubkey(i, &subkey));
+        ASSERT_EQ(subdoc_key.subkeys()[i], subkey);
+        ASSERT_EQ(subdoc_key.subkeys()[i].value_type(), view.subkey_type(i));
+      }
+      ASSERT_EQ(subdoc_key.ToString(), view.ToString());
+    }
+
+    for (int k = 0; k < kNumTestDocOrSubDocKeyComparisons; ++k) {
+      const size_t a = rng() % subdoc_keys.size();
+      const size_t b = rng() % subdoc_keys.size();
+      SubDocKeyView a_view, b_view;
+      ASSERT_OK(a_view.Decode(encoded_keys[a].AsSlice()));
+      ASSERT_OK(b_view.Decode(encoded_keys[b].AsSlice()));
+      std::string buffer;
+      SubDocKeyView b_copy;
+      b_copy.AssignCopy(b_view, &buffer);
+      ASSERT_EQ(subdoc_keys[a].NumSharedPrefixComponents(subdoc_keys[b]),
+                a_view.NumSharedPrefixComponents(b_copy));
+    }
+  }
+
+  // Keys without hybrid time are only accepted if requested.
+  const SubDocKey key_without_ht(DocKey({PrimitiveValue("a")}), PrimitiveValue("b"));
+  const KeyBytes encoded = key_without_ht.Encode();
+  SubDocKeyView view;
+  ASSERT_NOK(view.Decode(encoded.AsSlice()));
+  ASSERT_OK(view.Decode(encoded.AsSlice(), HybridTimeRequired::kFalse));
+  ASSERT_FALSE(view.has_hybrid_time());
+  ASSERT_EQ(1, view.num_subkeys());
+  ASSERT_EQ(encoded.AsSlice(), view.key_without_ht());
+}
+
 std::string EncodeSubDocKey(const std::string& hash_key,
     const std::string& range_key, const std::string& sub_key, uint64_t time) {
   DocKey dk(DocKey(0, PrimitiveValues(hash_key), PrimitiveValues(range_key)));
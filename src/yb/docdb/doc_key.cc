@@ -641,6 +641,81 @@ KeyBytes SubDocKey::AdvanceOutOfDocKeyPrefix() const {
   return doc_key_encoded;
 }
 
+// ------------------------------------------------------------------------------------------------
+// SubDocKeyView
+// ------------------------------------------------------------------------------------------------
+
+Status SubDocKeyView::Decode(Slice key, HybridTimeRequired hybrid_time_required) {
+  key_ = key;
+  subkey_ends_.clear();
+  doc_ht_ = DocHybridTime::kInvalid;
+
+  auto doc_key_size = DocKey::EncodedSize(key, DocKeyPart::WHOLE_DOC_KEY);
+  RETURN_NOT_OK(doc_key_size);
+  doc_key_size_ = *doc_key_size;
+
+  Slice slice = key;
+  slice.remove_prefix(doc_key_size_);
+  for (;;) {
+    auto decode_result = SubDocKey::DecodeSubkey(&slice);
+    RETURN_NOT_OK_PREPEND(
+        decode_result, Substitute("While decoding SubDocKey $0", ToShortDebugStr(key)));
+    if (!decode_result.get()) {
+      break;
+    }
+    subkey_ends_.push_back(slice.cdata() - key.cdata());
+  }
+
+  if (slice.empty()) {
+    if (!hybrid_time_required) {
+      return Status::OK();
+    }
+    return STATUS_SUBSTITUTE(
+        Corruption,
+        "Found too few bytes in the end of a SubDocKey for a type-prefixed hybrid_time: $0",
+        ToShortDebugStr(key));
+  }
+
+  DCHECK_EQ(ValueType::kHybridTime, DecodeValueType(slice));
+  slice.consume_byte();
+  RETURN_NOT_OK(ConsumeHybridTimeFromKey(&slice, &doc_ht_));
+  if (!slice.empty()) {
+    return STATUS_SUBSTITUTE(InvalidArgument,
+        "Expected all bytes of the slice to be decoded into SubDocKey, found $0 extra bytes: $1",
+        slice.size(), ToShortDebugStr(slice));
+  }
+  return Status::OK();
+}
+
+Status SubDocKeyView::DecodeSubkey(int index, PrimitiveValue* out) const {
+  Slice slice = subkey(index);
+  return PrimitiveValue::DecodeKey(&slice, out);
+}
+
+int SubDocKeyView::NumSharedPrefixComponents(const SubDocKeyView& other) const {
+  if (doc_key() != other.doc_key()) {
+    return 0;
+  }
+  const int min_num_subkeys = min(num_subkeys(), other.num_subkeys());
+  for (int i = 0; i < min_num_subkeys; ++i) {
+    if (subkey(i) != other.subkey(i)) {
+      return i + 1;
+    }
+  }
+  return min_num_subkeys + 1;
+}
+
+void SubDocKeyView::AssignCopy(const SubDocKeyView& other, std::string* buffer) {
+  buffer->assign(other.key_.cdata(), other.key_.size());
+  // Component boundaries are stored as offsets, so they remain valid for the copy.
+  *this = other;
+  key_ = Slice(*buffer);
+}
+
+std::string SubDocKeyView::ToString() const {
+  return BestEffortDocDBKeyToStr(key_);
+}
+
 // ------------------------------------------------------------------------------------------------
 // DocDbAwareFilterPolicy
 // ------------------------------------------------------------------------------------------------
@@ -491,6 +491,93 @@ inline std::ostream& operator <<(std::ostream& out, const SubDocKey& subdoc_key)
   return out;
 }
 
+// ------------------------------------------------------------------------------------------------
+// SubDocKeyView
+// ------------------------------------------------------------------------------------------------
+
+// A lightweight view of an encoded SubDocKey. Decoding a view only locates the boundaries of the
+// document key and of every subkey, and decodes the hybrid time. Components are exposed as slices
+// into the encoded key, and individual subkeys are decoded into PrimitiveValues on demand. This
+// avoids materializing every component (with heap-allocated strings) on hot paths such as
+// compactions and scans, which only need the full decoded form of a few of the keys they visit.
+//
+// The encoded key must outlive the view. Since the key encoding is canonical, two components are
+// equal if and only if their encoded slices are equal.
+class SubDocKeyView {
+ public:
+  // Decodes the component boundaries of the given key, which must consist of exactly one
+  // SubDocKey. Hybrid time is handled in the same way as in SubDocKey::FullyDecodeFrom.
+  CHECKED_STATUS Decode(
+      Slice key, HybridTimeRequired hybrid_time_required = HybridTimeRequired::kTrue);
+
+  // The key this view was decoded from.
+  Slice encoded() const {
+    return key_;
+  }
+
+  // The encoded document key.
+  Slice doc_key() const {
+    return Slice(key_.data(), doc_key_size_);
+  }
+
+  // The encoded document key followed by the encoded subkeys, i.e. the key without the hybrid
+  // time.
+  Slice key_without_ht() const {
+    return Slice(key_.data(), subkey_ends_.empty() ? doc_key_size_ : subkey_ends_.back());
+  }
+
+  int num_subkeys() const {
+    return subkey_ends_.size();
+  }
+
+  // The encoded subkey at the given index, including its value type byte.
+  Slice subkey(int index) const {
+    const size_t begin = index == 0 ? doc_key_size_ : subkey_ends_[index - 1];
+    return Slice(key_.data() + begin, subkey_ends_[index] - begin);
+  }
+
+  ValueType subkey_type(int index) const {
+    return DecodeValueType(subkey(index));
+  }
+
+  // Decodes the subkey at the given index.
+  CHECKED_STATUS DecodeSubkey(int index, PrimitiveValue* out) const;
+
+  bool has_hybrid_time() const {
+    return doc_ht_.is_valid();
+  }
+
+  const DocHybridTime& doc_hybrid_time() const {
+    DCHECK(has_hybrid_time());
+    return doc_ht_;
+  }
+
+  HybridTime hybrid_time() const {
+    return doc_hybrid_time().hybrid_time();
+  }
+
+  // Same as SubDocKey::NumSharedPrefixComponents, but compares encoded components.
+  int NumSharedPrefixComponents(const SubDocKeyView& other) const;
+
+  // Makes this view refer to a copy of the key of the other view stored in the given buffer, e.g.
+  // to keep the previous key around while the key it was decoded from is reused.
+  void AssignCopy(const SubDocKeyView& other, std::string* buffer);
+
+  std::string ToString() const;
+
+ private:
+  Slice key_;
+  size_t doc_key_size_ = 0;
+  // Offsets of the ends of the encoded subkeys relative to the beginning of the key.
+  boost::container::small_vector<size_t, 8> subkey_ends_;
+  DocHybridTime doc_ht_;
+};
+
+inline std::ostream& operator <<(std::ostream& out, const SubDocKeyView& subdoc_key) {
+  out << subdoc_key.ToString();
+  return out;
+}
+
 // A best-effort to decode the given sequence of key bytes as either a DocKey or a SubDocKey.
 // If not possible to decode, return the key_bytes directly as a readable string.
 std::string BestEffortDocDBKeyToStr(const KeyBytes &key_bytes);
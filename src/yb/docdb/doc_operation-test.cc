@@ -11,6 +11,8 @@
 // under the License.
 //
 
+#include <limits>
+#include <set>
 #include <thread>
 
 #include "yb/rocksdb/statistics.h"
@@ -29,11 +31,15 @@
 
 #include "yb/util/random_util.h"
 #include "yb/util/size_literals.h"
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
 #include "yb/util/tostring.h"
 
 DECLARE_uint64(rocksdb_max_file_size_for_compaction);
 DECLARE_int32(rocksdb_level0_slowdown_writes_trigger);
 DECLARE_int32(rocksdb_level0_stop_writes_trigger);
+DECLARE_bool(skip_expired_files_on_read);
+DECLARE_uint64(docdb_small_scan_max_rows);
 
 using namespace std::literals; // NOLINT
 
@@ -61,14 +67,14 @@ class DocOperationTest : public DocDBTestBase {
     SeedRandom();
   }
 
-  Schema CreateSchema() {
+  Schema CreateSchema(const TableProperties& table_properties = TableProperties()) {
     ColumnSchema hash_column_schema("k", INT32, false, true);
     ColumnSchema column1_schema("c1", INT32, false, false);
     ColumnSchema column2_schema("c2", INT32, false, false);
     ColumnSchema column3_schema("c3", INT32, false, false);
     const vector<ColumnSchema> columns({hash_column_schema, column1_schema, column2_schema,
                                            column3_schema});
-    Schema schema(columns, CreateColumnIds(columns.size()), 1);
+    Schema schema(columns, CreateColumnIds(columns.size()), 1, table_properties);
     return schema;
   }
 
@@ -514,6 +520,8 @@ std::ostream& operator<<(std::ostream& out, const RowData& row) {
 class DocOperationRangeFilterTest : public DocOperationTest {
  public:
   void TestWithSortingType(ColumnSchema::SortingType schema_type, bool is_forward_scan = true);
+  void TestInCondition(ColumnSchema::SortingType schema_type);
+  void TestRangeTombstones(ColumnSchema::SortingType schema_type);
  private:
 };
 
@@ -613,8 +621,158 @@ void DocOperationRangeFilterTest::TestWithSortingType(ColumnSchema::SortingType
   }
 }
 
+// Checks that scans with an IN condition on the range column, which are split into one key range
+// per value, return exactly the matching rows in both directions.
+void DocOperationRangeFilterTest::TestInCondition(ColumnSchema::SortingType schema_type) {
+  ColumnSchema hash_column("k", INT32, false, true);
+  ColumnSchema range_column("r", INT32, false, false, false, false, schema_type);
+  ColumnSchema value_column("v", INT32, false, false);
+  auto columns = { hash_column, range_column, value_column };
+  Schema schema(columns, CreateColumnIds(columns.size()), 2);
+
+  auto t = HybridClock::HybridTimeFromMicrosecondsAndLogicalValue(1000, 0);
+  constexpr int32_t kKey = 1;
+  constexpr int32_t kNumRows = 100;
+  for (int32_t r = 0; r != kNumRows; ++r) {
+    WriteQLRow(QLWriteRequestPB_QLStmtType_QL_STMT_INSERT, schema, { kKey, r, r * 2 }, 1000, t);
+  }
+  ASSERT_OK(FlushRocksDB());
+
+  // Includes duplicates and a value that has no row.
+  const std::vector<int32_t> in_values = { 90, 3, 40, 3, 500, 0 };
+  std::vector<RowData> ordered_rows;
+  for (int32_t r : { 0, 3, 40, 90 }) {
+    ordered_rows.push_back({kKey, r, r * 2});
+  }
+
+  QLConditionPB condition;
+  condition.add_operands()->set_column_id(1_ColId);
+  condition.set_op(QL_OP_IN);
+  auto* list = condition.add_operands()->mutable_value()->mutable_list_value();
+  for (int32_t r : in_values) {
+    list->add_elems()->set_int32_value(r);
+  }
+
+  for (bool is_forward_scan : { true, false }) {
+    std::vector<PrimitiveValue> hashed_components = { PrimitiveValue::Int32(kKey) };
+    DocQLScanSpec ql_scan_spec(schema, 0, -1, hashed_components, &condition,
+                               rocksdb::kDefaultQueryId, is_forward_scan);
+    ASSERT_EQ(5, ql_scan_spec.key_ranges().size());
+
+    std::vector<RowData> expected_rows = ordered_rows;
+    if (is_forward_scan == (schema_type == ColumnSchema::SortingType::kDescending)) {
+      std::reverse(expected_rows.begin(), expected_rows.end());
+    }
+    DocRowwiseIterator ql_iter(schema, schema, boost::none, rocksdb(),
+        ReadHybridTime::FromMicros(3000));
+    ASSERT_OK(ql_iter.Init(ql_scan_spec));
+    std::vector<RowData> fetched_rows;
+    while (ql_iter.HasNext()) {
+      QLTableRow value_map;
+      ASSERT_OK(ql_iter.NextRow(&value_map));
+      fetched_rows.push_back({ value_map.TestValue(0_ColId).value.int32_value(),
+                               value_map.TestValue(1_ColId).value.int32_value(),
+                               value_map.TestValue(2_ColId).value.int32_value() });
+    }
+    ASSERT_EQ(yb::ToString(expected_rows), yb::ToString(fetched_rows));
+  }
+}
+
+// Checks that a range delete written as a range tombstone hides exactly the rows it deletes, and
+// that compaction removes them together with the tombstone.
+void DocOperationRangeFilterTest::TestRangeTombstones(ColumnSchema::SortingType schema_type) {
+  ColumnSchema hash_column("k", INT32, false, true);
+  ColumnSchema range_column("r", INT32, false, false, false, false, schema_type);
+  ColumnSchema value_column("v", INT32, false, false);
+  auto columns = { hash_column, range_column, value_column };
+  TableProperties table_properties;
+  table_properties.SetUseRangeTombstones(true);
+  Schema schema(columns, CreateColumnIds(columns.size()), 2, table_properties);
+
+  const HybridTime t0 = HybridClock::HybridTimeFromMicrosecondsAndLogicalValue(1000, 0);
+  const HybridTime t1 = HybridClock::HybridTimeFromMicrosecondsAndLogicalValue(2000, 0);
+  const HybridTime t2 = HybridClock::HybridTimeFromMicrosecondsAndLogicalValue(3000, 0);
+  const HybridTime t3 = HybridClock::HybridTimeFromMicrosecondsAndLogicalValue(4000, 0);
+  constexpr int32_t kKey = 1;
+  constexpr int64_t kTtlMs = 1000000;
+  constexpr int32_t kNumRows = 10;
+  for (int32_t r = 0; r != kNumRows; ++r) {
+    WriteQLRow(QLWriteRequestPB_QLStmtType_QL_STMT_INSERT, schema, { kKey, r, r * 2 }, kTtlMs, t0);
+  }
+
+  // DELETE FROM t WHERE k = 1 AND r >= 3 AND r < 7.
+  QLWriteRequestPB delete_req;
+  QLResponsePB delete_resp;
+  delete_req.set_type(QLWriteRequestPB_QLStmtType_QL_STMT_DELETE);
+  delete_req.set_hash_code(0);
+  AddPrimaryKeyColumn(&delete_req, kKey);
+  auto* condition = delete_req.mutable_where_expr()->mutable_condition();
+  condition->set_op(QL_OP_AND);
+  auto* lower = condition->add_operands()->mutable_condition();
+  lower->set_op(QL_OP_GREATER_THAN_EQUAL);
+  lower->add_operands()->set_column_id(1_ColId);
+  lower->add_operands()->mutable_value()->set_int32_value(3);
+  auto* upper = condition->add_operands()->mutable_condition();
+  upper->set_op(QL_OP_LESS_THAN);
+  upper->add_operands()->set_column_id(1_ColId);
+  upper->add_operands()->mutable_value()->set_int32_value(7);
+  WriteQL(&delete_req, schema, &delete_resp, t1);
+  ASSERT_STR_CONTAINS(DocDBDebugDumpToStr(), "range_tombstone");
+
+  // A row written within the range after the delete is not hidden by it.
+  WriteQLRow(QLWriteRequestPB_QLStmtType_QL_STMT_INSERT, schema, { kKey, 5, 50 }, kTtlMs, t2);
+
+  auto read_rows = [this, &schema](HybridTime read_time) {
+    std::vector<PrimitiveValue> hashed_components = { PrimitiveValue::Int32(kKey) };
+    DocQLScanSpec ql_scan_spec(schema, 0, -1, hashed_components, nullptr /* condition */,
+                               rocksdb::kDefaultQueryId);
+    DocRowwiseIterator ql_iter(schema, schema, boost::none, rocksdb(),
+                               ReadHybridTime::SingleTime(read_time));
+    EXPECT_OK(ql_iter.Init(ql_scan_spec));
+    std::vector<RowData> rows;
+    while (ql_iter.HasNext()) {
+      QLTableRow value_map;
+      EXPECT_OK(ql_iter.NextRow(&value_map));
+      rows.push_back({ value_map.TestValue(0_ColId).value.int32_value(),
+                       value_map.TestValue(1_ColId).value.int32_value(),
+                       value_map.TestValue(2_ColId).value.int32_value() });
+    }
+    std::sort(rows.begin(), rows.end());
+    return yb::ToString(rows);
+  };
+
+  std::vector<RowData> all_rows;
+  std::vector<RowData> remaining_rows;
+  for (int32_t r = 0; r != kNumRows; ++r) {
+    all_rows.push_back({kKey, r, r * 2});
+    if (r < 3 || r >= 7) {
+      remaining_rows.push_back({kKey, r, r * 2});
+    } else if (r == 5) {
+      remaining_rows.push_back({kKey, r, 50});
+    }
+  }
+
+  ASSERT_EQ(yb::ToString(all_rows), read_rows(t0));
+  ASSERT_EQ(yb::ToString(remaining_rows), read_rows(t3));
+
+  CompactHistoryBefore(t3);
+  const auto dump = DocDBDebugDumpToStr();
+  for (const auto* removed : { "range_tombstone", "[1], [3]", "[1], [4]", "[1], [6]" }) {
+    ASSERT_EQ(std::string::npos, dump.find(removed)) << removed << " not removed from:\n" << dump;
+  }
+  ASSERT_EQ(yb::ToString(remaining_rows), read_rows(t3));
+}
+
 } // namespace
 
+TEST_F_EX(DocOperationTest, QLRangeFilterIn, DocOperationRangeFilterTest) {
+  TestInCondition(ColumnSchema::kAscending);
+}
+
+TEST_F_EX(DocOperationTest, QLRangeFilterInDescending, DocOperationRangeFilterTest) {
+  TestInCondition(ColumnSchema::kDescending);
+}
+
 TEST_F_EX(DocOperationTest, QLRangeFilterAscending, DocOperationRangeFilterTest) {
   TestWithSortingType(ColumnSchema::kAscending, true);
 }
@@ -631,6 +789,14 @@ TEST_F_EX(DocOperationTest, TestQLDescAscScan, DocOperationRangeFilterTest) {
   TestWithSortingType(ColumnSchema::kDescending, false);
 }
 
+TEST_F_EX(DocOperationTest, QLRangeTombstones, DocOperationRangeFilterTest) {
+  TestRangeTombstones(ColumnSchema::kAscending);
+}
+
+TEST_F_EX(DocOperationTest, QLRangeTombstonesDescending, DocOperationRangeFilterTest) {
+  TestRangeTombstones(ColumnSchema::kDescending);
+}
+
 TEST_F(DocOperationTest, TestQLCompactions) {
   yb::QLWriteRequestPB ql_writereq_pb;
   yb::QLResponsePB ql_writeresp_pb;
@@ -718,6 +884,174 @@ SubDocKey(DocKey(0x0000, [1], []), [ColumnId(3); HT{ physical: 1000 logical: 1 w
   EXPECT_EQ(30, row_block.row(0).column(3).int32_value());
 }
 
+TEST_F(DocOperationTest, TestQLPackedRows) {
+  const HybridTime t0 = HybridClock::HybridTimeFromMicrosecondsAndLogicalValue(1000, 0);
+  const HybridTime t1 = HybridClock::HybridTimeFromMicrosecondsAndLogicalValue(2000, 0);
+  const HybridTime t2 = HybridClock::HybridTimeFromMicrosecondsAndLogicalValue(3000, 0);
+  const HybridTime t3 = HybridClock::HybridTimeFromMicrosecondsAndLogicalValue(4000, 0);
+
+  TableProperties table_properties;
+  table_properties.SetUsePackedRows(true);
+  Schema schema = CreateSchema(table_properties);
+
+  // A full-row insert is stored as a single packed row.
+  WriteQLRow(QLWriteRequestPB_QLStmtType_QL_STMT_INSERT, schema, vector<int>({1, 1, 2, 3}),
+      10000, t0);
+  AssertDocDbDebugDumpStrEq(R"#(
+SubDocKey(DocKey(0x0000, [1], []), [packed_row; HT{ physical: 1000 }]) -> \
+    {SystemColumnId(0): null, ColumnId(1): 1, ColumnId(2): 2, ColumnId(3): 3}; ttl: 10.000s
+      )#");
+
+  // Update a single column, which is written at its own key and overrides the packed value.
+  yb::QLWriteRequestPB ql_update_pb;
+  yb::QLResponsePB ql_update_resp_pb;
+  ql_update_pb.set_type(QLWriteRequestPB_QLStmtType_QL_STMT_UPDATE);
+  ql_update_pb.set_hash_code(0);
+  AddPrimaryKeyColumn(&ql_update_pb, 1);
+  auto column = ql_update_pb.add_column_values();
+  column->set_column_id(2);
+  column->mutable_expr()->mutable_value()->set_int32_value(20);
+  WriteQL(&ql_update_pb, schema, &ql_update_resp_pb, t1);
+  AssertDocDbDebugDumpStrEq(R"#(
+SubDocKey(DocKey(0x0000, [1], []), [packed_row; HT{ physical: 1000 }]) -> \
+    {SystemColumnId(0): null, ColumnId(1): 1, ColumnId(2): 2, ColumnId(3): 3}; ttl: 10.000s
+SubDocKey(DocKey(0x0000, [1], []), [ColumnId(2); HT{ physical: 2000 }]) -> 20
+      )#");
+
+  QLRowBlock row_block = ReadQLRow(schema, 1, t2);
+  ASSERT_EQ(1, row_block.row_count());
+  EXPECT_EQ(1, row_block.row(0).column(0).int32_value());
+  EXPECT_EQ(1, row_block.row(0).column(1).int32_value());
+  EXPECT_EQ(20, row_block.row(0).column(2).int32_value());
+  EXPECT_EQ(3, row_block.row(0).column(3).int32_value());
+
+  // A later full-row insert shadows both the older packed row and the column update, so
+  // compaction keeps only the latest packed row.
+  WriteQLRow(QLWriteRequestPB_QLStmtType_QL_STMT_INSERT, schema, vector<int>({1, 4, 5, 6}),
+      10000, t2);
+  CompactHistoryBefore(t3);
+  AssertDocDbDebugDumpStrEq(R"#(
+SubDocKey(DocKey(0x0000, [1], []), [packed_row; HT{ physical: 3000 }]) -> \
+    {SystemColumnId(0): null, ColumnId(1): 4, ColumnId(2): 5, ColumnId(3): 6}; ttl: 10.000s
+      )#");
+
+  row_block = ReadQLRow(schema, 1, t3);
+  ASSERT_EQ(1, row_block.row_count());
+  EXPECT_EQ(1, row_block.row(0).column(0).int32_value());
+  EXPECT_EQ(4, row_block.row(0).column(1).int32_value());
+  EXPECT_EQ(5, row_block.row(0).column(2).int32_value());
+  EXPECT_EQ(6, row_block.row(0).column(3).int32_value());
+}
+
+TEST_F(DocOperationTest, TestQLPackedRowsExpire) {
+  const HybridTime t0 = HybridClock::HybridTimeFromMicrosecondsAndLogicalValue(1000, 0);
+  const HybridTime t1 = HybridClock::HybridTimeFromMicrosecondsAndLogicalValue(2000, 0);
+  const HybridTime t2 = HybridClock::HybridTimeFromMicrosecondsAndLogicalValue(4000, 0);
+
+  TableProperties table_properties;
+  table_properties.SetUsePackedRows(true);
+  Schema schema = CreateSchema(table_properties);
+
+  // A standalone column write, followed by a full-row insert with a 1 ms TTL.
+  yb::QLWriteRequestPB ql_update_pb;
+  yb::QLResponsePB ql_update_resp_pb;
+  ql_update_pb.set_type(QLWriteRequestPB_QLStmtType_QL_STMT_UPDATE);
+  ql_update_pb.set_hash_code(0);
+  AddPrimaryKeyColumn(&ql_update_pb, 1);
+  auto column = ql_update_pb.add_column_values();
+  column->set_column_id(2);
+  column->mutable_expr()->mutable_value()->set_int32_value(20);
+  WriteQL(&ql_update_pb, schema, &ql_update_resp_pb, t0);
+  WriteQLRow(QLWriteRequestPB_QLStmtType_QL_STMT_INSERT, schema, vector<int>({1, 1, 2, 3}),
+      1, t1);
+  AssertDocDbDebugDumpStrEq(R"#(
+SubDocKey(DocKey(0x0000, [1], []), [packed_row; HT{ physical: 2000 }]) -> \
+    {SystemColumnId(0): null, ColumnId(1): 1, ColumnId(2): 2, ColumnId(3): 3}; ttl: 0.001s
+SubDocKey(DocKey(0x0000, [1], []), [ColumnId(2); HT{ physical: 1000 }]) -> 20
+      )#");
+
+  QLRowBlock row_block = ReadQLRow(schema, 1, t1);
+  ASSERT_EQ(1, row_block.row_count());
+  EXPECT_EQ(1, row_block.row(0).column(1).int32_value());
+  EXPECT_EQ(2, row_block.row(0).column(2).int32_value());
+  EXPECT_EQ(3, row_block.row(0).column(3).int32_value());
+
+  // Once the packed row has expired, it still hides the older column value.
+  row_block = ReadQLRow(schema, 1, t2);
+  ASSERT_EQ(0, row_block.row_count());
+
+  // Compaction drops the expired packed row together with the column value it hides, rather than
+  // dropping only the packed row and resurrecting the column.
+  CompactHistoryBefore(t2);
+  AssertDocDbDebugDumpStrEq("");
+
+  row_block = ReadQLRow(schema, 1, t2);
+  ASSERT_EQ(0, row_block.row_count());
+}
+
+TEST_F(DocOperationTest, TestQLConditionalWritesShareRowReads) {
+  const HybridTime t0 = HybridClock::HybridTimeFromMicrosecondsAndLogicalValue(1000, 0);
+  const HybridTime t1 = HybridClock::HybridTimeFromMicrosecondsAndLogicalValue(2000, 0);
+
+  Schema schema = CreateSchema();
+  WriteQLRow(QLWriteRequestPB_QLStmtType_QL_STMT_INSERT, schema, vector<int>({1, 1, 2, 3}),
+      10000, t0);
+  ASSERT_OK(FlushRocksDB());
+
+  // Two "UPDATE ... SET c<column_id> = <value> WHERE k = 1 IF c1 = 1" statements.
+  auto make_conditional_update = [this, &schema](int column_id, int value,
+                                                 QLResponsePB* response) {
+    QLWriteRequestPB request;
+    request.set_type(QLWriteRequestPB_QLStmtType_QL_STMT_UPDATE);
+    request.set_hash_code(0);
+    AddPrimaryKeyColumn(&request, 1);
+    auto column = request.add_column_values();
+    column->set_column_id(column_id);
+    column->mutable_expr()->mutable_value()->set_int32_value(value);
+    auto condition = request.mutable_if_expr()->mutable_condition();
+    condition->set_op(QL_OP_EQUAL);
+    condition->add_operands()->set_column_id(1);
+    condition->add_operands()->mutable_value()->set_int32_value(1);
+    request.mutable_column_refs()->add_ids(1);
+
+    auto op = std::make_unique<QLWriteOperation>(schema, kNonTransactionalOperationContext);
+    EXPECT_OK(op->Init(&request, response));
+    return op;
+  };
+  QLResponsePB response1, response2;
+  auto op1 = make_conditional_update(2, 20, &response1);
+  auto op2 = make_conditional_update(3, 30, &response2);
+
+  // Both operations of the batch read the same row at the same read time, so only the first one
+  // opens iterators over the SST files.
+  auto statistics = rocksdb()->GetDBOptions().statistics;
+  auto doc_write_batch = MakeDocWriteBatch();
+  QLRowReadCache row_read_cache;
+  HybridTime restart_read_ht;
+  DocOperationApplyData data = {
+      &doc_write_batch, ReadHybridTime::SingleTime(t1), &restart_read_ht, &row_read_cache};
+  const auto initial_iterators = statistics->getTickerCount(rocksdb::NO_TABLE_CACHE_ITERATORS);
+  ASSERT_OK(op1->Apply(data));
+  const auto first_iterators = statistics->getTickerCount(rocksdb::NO_TABLE_CACHE_ITERATORS);
+  ASSERT_GT(first_iterators, initial_iterators);
+  ASSERT_OK(op2->Apply(data));
+  ASSERT_EQ(first_iterators, statistics->getTickerCount(rocksdb::NO_TABLE_CACHE_ITERATORS));
+  ASSERT_FALSE(restart_read_ht.is_valid());
+
+  for (const auto* op : {op1.get(), op2.get()}) {
+    const auto& rows = op->rowblock()->rows();
+    ASSERT_EQ(1U, rows.size());
+    ASSERT_TRUE(rows[0].column(0).bool_value());
+  }
+  ASSERT_OK(WriteToRocksDB(doc_write_batch, t1));
+
+  QLRowBlock row_block = ReadQLRow(schema, 1, t1);
+  ASSERT_EQ(1, row_block.row_count());
+  EXPECT_EQ(1, row_block.row(0).column(1).int32_value());
+  EXPECT_EQ(20, row_block.row(0).column(2).int32_value());
+  EXPECT_EQ(30, row_block.row(0).column(3).int32_value());
+}
+
 namespace {
 
 size_t GenerateFiles(int total_batches, DocOperationTest* test) {
@@ -764,6 +1098,154 @@ void WaitCompactionsDone(rocksdb::DB* db) {
 
 } // namespace
 
+TEST_F(DocOperationTest, TestQLReadSkipsFilesByHybridTime) {
+  ASSERT_OK(DisableCompactions());
+  Schema schema = CreateSchema();
+
+  // Write row i at i seconds with a TTL of 1.5 seconds, each row into its own file.
+  constexpr int32_t kNumRows = 5;
+  for (int32_t i = 1; i <= kNumRows; ++i) {
+    WriteQLRow(QLWriteRequestPB_QLStmtType_QL_STMT_INSERT, schema, {i, i, i, i}, 1500,
+               HybridTime::FromMicros(i * 1000000));
+    ASSERT_OK(FlushRocksDB());
+  }
+
+  // At 3.2 seconds row 1 has expired and rows 4 and 5 are not written yet.
+  const auto read_time = ReadHybridTime::FromMicros(3200000);
+  auto statistics = rocksdb()->GetDBOptions().statistics;
+  for (bool skip_expired : { false, true }) {
+    FLAGS_skip_expired_files_on_read = skip_expired;
+    const auto old_iterators = statistics->getTickerCount(rocksdb::NO_TABLE_CACHE_ITERATORS);
+
+    std::vector<PrimitiveValue> hashed_components;
+    DocQLScanSpec ql_scan_spec(schema, -1, -1, hashed_components, nullptr,
+                               rocksdb::kDefaultQueryId);
+    DocRowwiseIterator ql_iter(schema, schema, kNonTransactionalOperationContext, rocksdb(),
+                               read_time);
+    ASSERT_OK(ql_iter.Init(ql_scan_spec));
+    std::set<int32_t> keys;
+    while (ql_iter.HasNext()) {
+      QLTableRow value_map;
+      ASSERT_OK(ql_iter.NextRow(&value_map));
+      keys.insert(value_map.TestValue(0_ColId).value.int32_value());
+    }
+    ASSERT_EQ((std::set<int32_t>{2, 3}), keys);
+
+    // Files written after the read time are always skipped, the file with expired row 1 only if
+    // expired files are skipped.
+    const auto new_iterators = statistics->getTickerCount(rocksdb::NO_TABLE_CACHE_ITERATORS);
+    ASSERT_EQ(skip_expired ? 2 : 3, new_iterators - old_iterators);
+  }
+}
+
+// Compactions drop the SST files whose values have all expired at the history cutoff, and keep the
+// files with live values.
+TEST_F(DocOperationTest, TestCompactionDropsExpiredFiles) {
+  ASSERT_OK(EnableDropExpiredFiles());
+  // Files are grouped into time windows of 1 second.
+  SetTableTTL(4000);
+  Schema schema = CreateSchema();
+
+  // Rows 1 and 2 expire at 2 and 3 seconds, row 3 lives for 100 seconds. Each row is written into
+  // its own file, in its own time window.
+  const std::vector<std::pair<int32_t, int>> rows = { {1, 1000}, {2, 1000}, {3, 100000} };
+  for (const auto& row : rows) {
+    WriteQLRow(QLWriteRequestPB_QLStmtType_QL_STMT_INSERT, schema,
+               {row.first, row.first, row.first, row.first}, row.second,
+               HybridTime::FromMicros(row.first * 1000000));
+    ASSERT_OK(FlushRocksDB());
+  }
+  std::vector<rocksdb::LiveFileMetaData> files;
+  rocksdb()->GetLiveFilesMetaData(&files);
+  ASSERT_EQ(3U, files.size());
+
+  // Nothing is dropped while the history cutoff is before the expiration.
+  SetHistoryCutoffHybridTime(HybridTime::FromMicros(1500000));
+  WriteQLRow(QLWriteRequestPB_QLStmtType_QL_STMT_INSERT, schema, {4, 4, 4, 4}, 100000,
+             HybridTime::FromMicros(11000000));
+  ASSERT_OK(FlushRocksDB());
+  WaitCompactionsDone(rocksdb());
+  files.clear();
+  rocksdb()->GetLiveFilesMetaData(&files);
+  ASSERT_EQ(4U, files.size());
+
+  // Once the history cutoff passes the expiration of rows 1 and 2, the next flush schedules a
+  // compaction that drops their files.
+  SetHistoryCutoffHybridTime(HybridTime::FromMicros(5000000));
+  WriteQLRow(QLWriteRequestPB_QLStmtType_QL_STMT_INSERT, schema, {5, 5, 5, 5}, 100000,
+             HybridTime::FromMicros(12000000));
+  ASSERT_OK(FlushRocksDB());
+  ASSERT_OK(WaitFor([this]() -> Result<bool> {
+    std::vector<rocksdb::LiveFileMetaData> live_files;
+    rocksdb()->GetLiveFilesMetaData(&live_files);
+    return live_files.size() == 3;
+  }, MonoDelta::FromSeconds(10), "Drop expired files"));
+
+  // The remaining files are the ones with the live rows. Row 1 would still be visible at 1.5 seconds
+  // if its file was kept.
+  std::vector<PrimitiveValue> hashed_components;
+  DocQLScanSpec ql_scan_spec(schema, -1, -1, hashed_components, nullptr,
+                             rocksdb::kDefaultQueryId);
+  DocRowwiseIterator ql_iter(schema, schema, kNonTransactionalOperationContext, rocksdb(),
+                             ReadHybridTime::FromMicros(1500000));
+  ASSERT_OK(ql_iter.Init(ql_scan_spec));
+  ASSERT_FALSE(ql_iter.HasNext());
+  DocRowwiseIterator live_iter(schema, schema, kNonTransactionalOperationContext, rocksdb(),
+                               ReadHybridTime::FromMicros(13000000));
+  ASSERT_OK(live_iter.Init(ql_scan_spec));
+  std::set<int32_t> keys;
+  while (live_iter.HasNext()) {
+    QLTableRow value_map;
+    ASSERT_OK(live_iter.NextRow(&value_map));
+    keys.insert(value_map.TestValue(0_ColId).value.int32_value());
+  }
+  ASSERT_EQ((std::set<int32_t>{3, 4, 5}), keys);
+}
+
+// Scans that are not restricted to a single hash key only bypass the block cache when they could
+// return many rows.
+TEST_F(DocOperationTest, TestQLScanFillsBlockCacheOnlyForSmallScans) {
+  Schema schema = CreateSchema();
+  constexpr int32_t kNumRows = 10;
+  for (int32_t i = 1; i <= kNumRows; ++i) {
+    WriteQLRow(QLWriteRequestPB_QLStmtType_QL_STMT_INSERT, schema, {i, i, i, i}, 1000,
+               HybridTime::FromMicros(1000));
+  }
+  ASSERT_OK(FlushRocksDB());
+
+  auto statistics = rocksdb()->GetDBOptions().statistics;
+  // Scans the whole table twice and returns the number of data blocks the second scan found in
+  // the block cache.
+  auto scan_twice = [&](size_t max_rows) -> uint64_t {
+    uint64_t hits = 0;
+    for (int i = 0; i != 2; ++i) {
+      hits = statistics->getTickerCount(rocksdb::BLOCK_CACHE_DATA_HIT);
+      std::vector<PrimitiveValue> hashed_components;
+      DocQLScanSpec ql_scan_spec(schema, -1, -1, hashed_components, nullptr,
+                                 rocksdb::kDefaultQueryId, true /* is_forward_scan */,
+                                 false /* include_static_columns */, DocKey(), max_rows);
+      DocRowwiseIterator ql_iter(schema, schema, kNonTransactionalOperationContext, rocksdb(),
+                                 ReadHybridTime::FromMicros(2000));
+      EXPECT_OK(ql_iter.Init(ql_scan_spec));
+      int32_t num_rows = 0;
+      while (ql_iter.HasNext()) {
+        QLTableRow value_map;
+        EXPECT_OK(ql_iter.NextRow(&value_map));
+        ++num_rows;
+      }
+      EXPECT_EQ(kNumRows, num_rows);
+      hits = statistics->getTickerCount(rocksdb::BLOCK_CACHE_DATA_HIT) - hits;
+    }
+    return hits;
+  };
+
+  // A scan without a small limit does not add the blocks it reads to the block cache.
+  ASSERT_EQ(0U, scan_twice(std::numeric_limits<size_t>::max()));
+  ASSERT_EQ(0U, scan_twice(FLAGS_docdb_small_scan_max_rows + 1));
+  // A scan limited to a few rows does.
+  ASSERT_GT(scan_twice(FLAGS_docdb_small_scan_max_rows), 0U);
+}
+
 TEST_F(DocOperationTest, MaxFileSizeForCompaction) {
   google::FlagSaver flag_saver;
 
@@ -23,6 +23,8 @@
 #include "yb/docdb/doc_expr.h"
 #include "yb/docdb/doc_rowwise_iterator.h"
 #include "yb/docdb/doc_ql_scanspec.h"
+#include "yb/docdb/packed_row.h"
+#include "yb/docdb/range_tombstone.h"
 #include "yb/docdb/subdocument.h"
 #include "yb/server/hybrid_clock.h"
 #include "yb/gutil/strings/substitute.h"
@@ -40,6 +42,10 @@ DEFINE_bool(emulate_redis_responses,
     "and HDEL. If emulate_redis_responses is true, we read the required records to compute the "
     "response as specified by the official Redis API documentation. https://redis.io/commands");
 
+DEFINE_int32(ql_read_filter_batch_size, 128,
+             "Number of rows a QL scan reads before evaluating its WHERE condition over all of them "
+             "at once. 0 evaluates the condition one row at a time.");
+
 namespace yb {
 namespace docdb {
 
@@ -1456,7 +1462,7 @@ bool JoinNonStaticRow(
 
 
 
-} // namespace
+}  // namespace
 
 Status QLWriteOperation::Init(QLWriteRequestPB* request, QLResponsePB* response) {
   response_ = response;
@@ -1538,6 +1544,41 @@ void QLWriteOperation::GetDocPathsToLock(list<DocPath> *paths, IsolationLevel *l
                          : IsolationLevel::SERIALIZABLE_ISOLATION;
 }
 
+std::string QLRowReadCache::MakeKey(const ReadHybridTime& read_time,
+                                   const DocKey& doc_key,
+                                   const Schema& projection) {
+  std::string key;
+  for (const HybridTime& ht : {read_time.read, read_time.local_limit, read_time.global_limit}) {
+    const uint64_t value = ht.ToUint64();
+    key.append(reinterpret_cast<const char*>(&value), sizeof(value));
+  }
+  const uint64_t num_columns = projection.column_ids().size();
+  key.append(reinterpret_cast<const char*>(&num_columns), sizeof(num_columns));
+  for (const ColumnId& column_id : projection.column_ids()) {
+    const ColumnIdRep rep = column_id.rep();
+    key.append(reinterpret_cast<const char*>(&rep), sizeof(rep));
+  }
+  // Everything before the doc key is either fixed-size or length-prefixed, so keys cannot collide.
+  key.append(doc_key.Encode().AsStringRef());
+  return key;
+}
+
+const QLRowReadCache::Entry* QLRowReadCache::Get(const ReadHybridTime& read_time,
+                                                 const DocKey& doc_key,
+                                                 const Schema& projection) const {
+  auto it = entries_.find(MakeKey(read_time, doc_key, projection));
+  return it != entries_.end() ? &it->second : nullptr;
+}
+
+const QLRowReadCache::Entry* QLRowReadCache::Put(const ReadHybridTime& read_time,
+                                                 const DocKey& doc_key,
+                                                 const Schema& projection,
+                                                 Entry entry) {
+  Entry& cached = entries_[MakeKey(read_time, doc_key, projection)];
+  cached = std::move(entry);
+  return &cached;
+}
+
 Status QLWriteOperation::ReadColumns(const DocOperationApplyData& data,
                                      Schema *param_static_projection,
                                      Schema *param_non_static_projection,
@@ -1565,33 +1606,61 @@ Status QLWriteOperation::ReadColumns(const DocOperationApplyData& data,
 
   // Scan docdb for the static and non-static columns of the row using the hashed / primary key.
   if (hashed_doc_key_ != nullptr) {
-    DocQLScanSpec spec(*static_projection, *hashed_doc_key_, request_.query_id());
-    DocRowwiseIterator iterator(*static_projection, schema_, txn_op_context_,
-                                data.doc_write_batch->rocksdb(), data.read_time);
-    RETURN_NOT_OK(iterator.Init(spec));
-    if (iterator.HasNext()) {
-      RETURN_NOT_OK(iterator.NextRow(table_row));
-    }
-    data.restart_read_ht->MakeAtLeast(iterator.RestartReadHt());
+    bool found = false;
+    RETURN_NOT_OK(ReadRow(data, *static_projection, *hashed_doc_key_, table_row, &found));
   }
   if (pk_doc_key_ != nullptr) {
-    DocQLScanSpec spec(*non_static_projection, *pk_doc_key_, request_.query_id());
-    DocRowwiseIterator iterator(*non_static_projection, schema_, txn_op_context_,
-                                data.doc_write_batch->rocksdb(), data.read_time);
-    RETURN_NOT_OK(iterator.Init(spec));
-    if (iterator.HasNext()) {
-      RETURN_NOT_OK(iterator.NextRow(table_row));
-    } else {
+    bool found = false;
+    RETURN_NOT_OK(ReadRow(data, *non_static_projection, *pk_doc_key_, table_row, &found));
+    if (!found) {
       // If no non-static column is found, the row does not exist and we should clear the static
       // columns in the map to indicate the row does not exist.
       table_row->Clear();
     }
-    data.restart_read_ht->MakeAtLeast(iterator.RestartReadHt());
   }
 
   return Status::OK();
 }
 
+Status QLWriteOperation::ReadRow(const DocOperationApplyData& data,
+                                 const Schema& projection,
+                                 const DocKey& doc_key,
+                                 QLTableRow* table_row,
+                                 bool* found) {
+  QLRowReadCache* cache = data.row_read_cache;
+  const QLRowReadCache::Entry* cached =
+      cache != nullptr ? cache->Get(data.read_time, doc_key, projection) : nullptr;
+  if (cached == nullptr) {
+    QLRowReadCache::Entry entry;
+    // Without a cache, read straight into the caller's row.
+    QLTableRow* row = cache != nullptr ? &entry.row : table_row;
+    DocQLScanSpec spec(projection, doc_key, request_.query_id());
+    DocRowwiseIterator iterator(projection, schema_, txn_op_context_,
+                                data.doc_write_batch->rocksdb(), data.read_time);
+    RETURN_NOT_OK(iterator.Init(spec));
+    entry.found = iterator.HasNext();
+    if (entry.found) {
+      RETURN_NOT_OK(iterator.NextRow(row));
+    }
+    entry.restart_read_ht = iterator.RestartReadHt();
+    data.restart_read_ht->MakeAtLeast(entry.restart_read_ht);
+    *found = entry.found;
+    if (cache == nullptr) {
+      return Status::OK();
+    }
+    cached = cache->Put(data.read_time, doc_key, projection, std::move(entry));
+  } else {
+    // The read is shared with an earlier operation, but it still bounds this operation's read.
+    data.restart_read_ht->MakeAtLeast(cached->restart_read_ht);
+    *found = cached->found;
+  }
+
+  for (size_t i = 0; i < schema_.num_columns(); ++i) {
+    RETURN_NOT_OK(table_row->CopyColumn(schema_.column_id(i), cached->row));
+  }
+  return Status::OK();
+}
+
 Status QLWriteOperation::IsConditionSatisfied(const QLConditionPB& condition,
                                               const DocOperationApplyData& data,
                                               bool* should_apply,
@@ -1656,6 +1725,16 @@ Status QLWriteOperation::Apply(const DocOperationApplyData& data) {
         // We never use init markers for QL to ensure we perform writes without any reads to
         // ensure our write path is fast while complicating the read path a bit.
         if (request_.type() == QLWriteRequestPB::QL_STMT_INSERT && pk_doc_path_ != nullptr) {
+          // Writes with a user timestamp need to compare it with the existing value of every
+          // column, so they are always written column by column.
+          if (schema_.table_properties().use_packed_rows() &&
+              user_timestamp == Value::kInvalidUserTimestamp) {
+            auto packed = ApplyPackedInsert(data, table_row, ttl);
+            RETURN_NOT_OK(packed);
+            if (*packed) {
+              break;
+            }
+          }
           const DocPath sub_path(pk_doc_path_->encoded_doc_key(),
                                  PrimitiveValue::SystemColumnId(SystemColumnIds::kLivenessColumn));
           const auto value = Value(PrimitiveValue(), ttl, user_timestamp);
@@ -1797,6 +1876,12 @@ Status QLWriteOperation::Apply(const DocOperationApplyData& data) {
                                                              request_.query_id(), user_timestamp));
           }
         } else if (IsRangeOperation(request_, schema_)) {
+          auto range_deleted = ApplyRangeTombstone(data);
+          RETURN_NOT_OK(range_deleted);
+          if (*range_deleted) {
+            break;
+          }
+
           // If the range columns are not specified, we read everything and delete all rows for
           // which the where condition matches.
 
@@ -1854,6 +1939,80 @@ Status QLWriteOperation::Apply(const DocOperationApplyData& data) {
   return Status::OK();
 }
 
+namespace {
+
+// Whether the column is stored as a single primitive value, so that it can be part of a packed row.
+bool IsPackableColumn(const ColumnSchema& column) {
+  return !column.is_static() && !column.is_counter() && !column.type()->HasComplexValues();
+}
+
+}  // namespace
+
+Result<bool> QLWriteOperation::ApplyPackedInsert(const DocOperationApplyData& data,
+                                                 const QLTableRow& table_row,
+                                                 MonoDelta ttl) {
+  int num_packable_columns = 0;
+  for (size_t i = schema_.num_key_columns(); i < schema_.num_columns(); i++) {
+    if (IsPackableColumn(schema_.column(i))) {
+      num_packable_columns++;
+    }
+  }
+  // A packed row must hold every scalar column of the row, so that the latest packed row of a row
+  // always supersedes the earlier ones.
+  if (request_.column_values_size() != num_packable_columns) {
+    return false;
+  }
+
+  PackedRow packed_row;
+  packed_row.AddColumn(PrimitiveValue::SystemColumnId(SystemColumnIds::kLivenessColumn),
+                       PrimitiveValue());
+  for (const auto& column_value : request_.column_values()) {
+    if (!column_value.has_column_id() || !column_value.subscript_args().empty() ||
+        GetTSWriteInstruction(column_value.expr()) != TSOpcode::kScalarInsert) {
+      return false;
+    }
+    const ColumnId column_id(column_value.column_id());
+    const auto maybe_column = schema_.column_by_id(column_id);
+    RETURN_NOT_OK(maybe_column);
+    const ColumnSchema& column = *maybe_column;
+    if (!IsPackableColumn(column)) {
+      return false;
+    }
+
+    QLValue expr_result;
+    RETURN_NOT_OK(EvalExpr(column_value.expr(), table_row, &expr_result));
+    packed_row.AddColumn(PrimitiveValue(column_id),
+                         PrimitiveValue::FromQLValuePB(expr_result.value(), column.sorting_type()));
+  }
+
+  const DocPath sub_path(pk_doc_path_->encoded_doc_key(), PrimitiveValue(ValueType::kPackedRow));
+  RETURN_NOT_OK(data.doc_write_batch->SetPrimitive(
+      sub_path, Value(packed_row.Encode(), ttl), request_.query_id()));
+  return true;
+}
+
+Result<bool> QLWriteOperation::ApplyRangeTombstone(const DocOperationApplyData& data) {
+  // Range tombstones are not resolved against the intents of other transactions, and a user
+  // timestamp has to be compared with the existing value of every column of every row.
+  if (!schema_.table_properties().use_range_tombstones() ||
+      schema_.num_hash_key_columns() == 0 || hashed_doc_key_ == nullptr ||
+      txn_op_context_ || request_.has_user_timestamp_usec() || request_.has_if_expr()) {
+    return false;
+  }
+  std::string lower;
+  std::string upper;
+  auto has_bounds = GetRangeTombstoneBounds(
+      schema_, request_.has_where_expr() ? &request_.where_expr().condition() : nullptr,
+      &lower, &upper);
+  RETURN_NOT_OK(has_bounds);
+  if (!*has_bounds) {
+    return false;
+  }
+  RETURN_NOT_OK(data.doc_write_batch->DeleteSubDoc(
+      RangeTombstonePath(*hashed_doc_key_, lower, upper), request_.query_id()));
+  return true;
+}
+
 Status QLWriteOperation::DeleteRow(DocWriteBatch* doc_write_batch,
                                    const DocPath row_path) {
   if (request_.has_user_timestamp_usec()) {
@@ -1938,6 +2097,14 @@ Status QLReadOperation::Execute(const common::QLStorageIf& ql_storage,
   // Begin the normal fetch.
   int match_count = 0;
   bool static_dealt_with = true;
+
+  // Without static columns or DISTINCT every row is filtered independently, so the rows can be
+  // filtered in batches. The row-at-a-time loop below then finds nothing left to read.
+  if (FLAGS_ql_read_filter_batch_size > 0 && spec->has_condition() && !read_static_columns &&
+      !read_distinct_columns && !schema.has_statics()) {
+    RETURN_NOT_OK(AddRowBatchesToResult(
+        *spec, non_static_projection, row_count_limit, iter.get(), resultset, &match_count));
+  }
   while (resultset->rsrow_count() < row_count_limit && iter->HasNext()) {
     const bool last_read_static = iter->IsNextStaticColumn();
 
@@ -2087,5 +2254,39 @@ CHECKED_STATUS QLReadOperation::AddRowToResult(const std::unique_ptr<common::QLS
 
   return Status::OK();
 }
+
+CHECKED_STATUS QLReadOperation::AddRowBatchesToResult(const common::QLScanSpec& spec,
+                                                      const Schema& projection,
+                                                      const size_t row_count_limit,
+                                                      common::QLRowwiseIteratorIf* iter,
+                                                      QLResultSet* resultset,
+                                                      int* match_count) {
+  std::vector<QLTableRow> rows(FLAGS_ql_read_filter_batch_size);
+  std::vector<size_t> selection;
+  while (resultset->rsrow_count() < row_count_limit && iter->HasNext()) {
+    // Do not read more rows than could still be added to the result set, so that the iterator stops
+    // at the same row, and the paging state is the same, as when filtering one row at a time.
+    const size_t batch_size = std::min(rows.size(), row_count_limit - resultset->rsrow_count());
+    size_t num_rows = 0;
+    while (num_rows < batch_size && iter->HasNext()) {
+      QLTableRow& row = rows[num_rows++];
+      row.Clear();
+      RETURN_NOT_OK(iter->NextRow(projection, &row));
+    }
+
+    RETURN_NOT_OK(spec.MatchBatch(rows, num_rows, &selection));
+    for (const size_t index : selection) {
+      (*match_count)++;
+      if (request_.is_aggregate()) {
+        RETURN_NOT_OK(EvalAggregate(rows[index]));
+      } else {
+        RETURN_NOT_OK(PopulateResultSet(rows[index], resultset));
+      }
+    }
+  }
+
+  return Status::OK();
+}
+
 }  // namespace docdb
 }  // namespace yb
@@ -15,6 +15,9 @@
 #define YB_DOCDB_DOC_OPERATION_H_
 
 #include <list>
+#include <string>
+#include <unordered_map>
+
 #include <boost/optional.hpp>
 
 #include "yb/rocksdb/db.h"
@@ -35,11 +38,51 @@ namespace yb {
 namespace docdb {
 
 class DocWriteBatch;
+class QLRowReadCache;
 
 struct DocOperationApplyData {
   DocWriteBatch* doc_write_batch;
   ReadHybridTime read_time;
   HybridTime* restart_read_ht;
+  // Rows already read by operations of the same write batch. May be null.
+  QLRowReadCache* row_read_cache = nullptr;
+};
+
+// Caches the rows read by the read-modify-write QL operations (conditional DML, counter updates,
+// collection updates that need the current value) of a single write batch. All operations of the
+// batch read RocksDB at the same read time and RocksDB does not change until the batch is
+// applied, so repeated reads of the same columns of the same row return the same result and do
+// not need to seek RocksDB again. Entries are keyed on the read time, the encoded doc key and the
+// projected column ids.
+//
+// This class is not thread-safe.
+class QLRowReadCache {
+ public:
+  struct Entry {
+    // Key and projected columns of the row. Empty if the row was not found.
+    QLTableRow row;
+    bool found = false;
+    // Restart read time reported by the iterator that read the row.
+    HybridTime restart_read_ht;
+  };
+
+  // Returns the row read at the given read time, or null if it has not been read yet.
+  const Entry* Get(const ReadHybridTime& read_time,
+                   const DocKey& doc_key,
+                   const Schema& projection) const;
+
+  // Records the row read at the given read time and returns the cached copy.
+  const Entry* Put(const ReadHybridTime& read_time,
+                   const DocKey& doc_key,
+                   const Schema& projection,
+                   Entry entry);
+
+ private:
+  static std::string MakeKey(const ReadHybridTime& read_time,
+                             const DocKey& doc_key,
+                             const Schema& projection);
+
+  std::unordered_map<std::string, Entry> entries_;
 };
 
 class DocOperation {
@@ -169,6 +212,15 @@ class QLWriteOperation : public DocOperation, public DocExprExecutor {
                              Schema *non_static_projection,
                              QLTableRow* table_row);
 
+  // Reads the projected columns of the row with the given doc key into table_row, serving the
+  // read from data.row_read_cache when another operation of the batch has read it already. Sets
+  // found to whether the row exists.
+  CHECKED_STATUS ReadRow(const DocOperationApplyData& data,
+                         const Schema& projection,
+                         const DocKey& doc_key,
+                         QLTableRow* table_row,
+                         bool* found);
+
   CHECKED_STATUS IsConditionSatisfied(const QLConditionPB& condition,
                                       const DocOperationApplyData& data,
                                       bool* should_apply,
@@ -178,6 +230,18 @@ class QLWriteOperation : public DocOperation, public DocExprExecutor {
   CHECKED_STATUS DeleteRow(DocWriteBatch* doc_write_batch,
                            const DocPath row_path);
 
+  // Writes an INSERT as a single packed row holding the liveness column and every scalar column of
+  // the row. Returns false without writing anything if the INSERT cannot be packed, e.g. because it
+  // sets a static or collection column or does not set all scalar columns of the row.
+  Result<bool> ApplyPackedInsert(const DocOperationApplyData& data,
+                                 const QLTableRow& table_row,
+                                 MonoDelta ttl);
+
+  // Writes a range DELETE as a single range tombstone covering all rows it deletes. Returns false
+  // without writing anything if the table does not use range tombstones or the DELETE cannot be
+  // written as one, e.g. because it is transactional or its WHERE clause is not a single range.
+  Result<bool> ApplyRangeTombstone(const DocOperationApplyData& data);
+
   const Schema& schema_;
 
   // Doc key and doc path for hashed key (i.e. without range columns). Present when there is a
@@ -229,6 +293,16 @@ class QLReadOperation : public DocExprExecutor {
                                 QLResultSet* resultset,
                                 int* match_count);
 
+  // Reads the remaining rows from the iterator in batches and adds those matching the scan spec to
+  // the result, until row_count_limit rows are in the result. Only valid for scans that read no
+  // static columns and are not DISTINCT.
+  CHECKED_STATUS AddRowBatchesToResult(const common::QLScanSpec& spec,
+                                       const Schema& projection,
+                                       const size_t row_count_limit,
+                                       common::QLRowwiseIteratorIf* iter,
+                                       QLResultSet* resultset,
+                                       int* match_count);
+
   QLResponsePB& response() { return response_; }
 
  private:
@@ -12,9 +12,24 @@
 //
 
 #include "yb/docdb/doc_expr.h"
+#include "yb/docdb/doc_kv_util.h"
 #include "yb/docdb/doc_ql_scanspec.h"
+#include "yb/docdb/value.h"
 #include "yb/rocksdb/db/compaction.h"
 
+DEFINE_int32(max_scan_key_ranges, 1024,
+             "Maximum number of disjoint key ranges a scan is split into when its WHERE condition "
+             "restricts range columns to a set of values, e.g. with IN. Scans that would need "
+             "more ranges use fewer range columns to build them.");
+TAG_FLAG(max_scan_key_ranges, advanced);
+
+DEFINE_bool(skip_expired_files_on_read, false,
+            "Whether QL scans skip SST files whose values have all expired. An expired value hides "
+            "older values of the same column, so this is only correct if no value is written with "
+            "a TTL longer than the TTLs of the values written after it, e.g. if all values use "
+            "the table TTL.");
+TAG_FLAG(skip_expired_files_on_read, advanced);
+
 namespace yb {
 namespace docdb {
 
@@ -33,7 +48,9 @@ DocQLScanSpec::DocQLScanSpec(const Schema& schema,
       lower_doc_key_(DocKey()),
       upper_doc_key_(DocKey()),
       include_static_columns_(false),
-      query_id_(query_id) {
+      key_ranges_(),
+      query_id_(query_id),
+      max_rows_(std::numeric_limits<size_t>::max()) {
 }
 
 DocQLScanSpec::DocQLScanSpec(const Schema& schema,
@@ -44,7 +61,8 @@ DocQLScanSpec::DocQLScanSpec(const Schema& schema,
                              const rocksdb::QueryId query_id,
                              const bool is_forward_scan,
                              const bool include_static_columns,
-                             const DocKey& start_doc_key)
+                             const DocKey& start_doc_key,
+                             const size_t max_rows)
     : QLScanSpec(condition, is_forward_scan, std::make_shared<DocExprExecutor>()),
       range_(condition ? new common::QLScanRange(schema, *condition) : nullptr),
       schema_(schema),
@@ -56,7 +74,9 @@ DocQLScanSpec::DocQLScanSpec(const Schema& schema,
       lower_doc_key_(bound_key(true)),
       upper_doc_key_(bound_key(false)),
       include_static_columns_(include_static_columns),
-      query_id_(query_id) {
+      key_ranges_(BuildKeyRanges()),
+      query_id_(query_id),
+      max_rows_(max_rows) {
 }
 
 DocKey DocQLScanSpec::bound_key(const bool lower_bound) const {
@@ -108,6 +128,62 @@ std::vector<PrimitiveValue> DocQLScanSpec::range_components(const bool lower_bou
   return result;
 }
 
+std::vector<DocKeyRange> DocQLScanSpec::BuildKeyRanges() const {
+  std::vector<DocKeyRange> result;
+  // Static columns are stored under the hash key alone, outside of any range of range columns.
+  if (range_ == nullptr || include_static_columns_ || hashed_components_->empty() ||
+      hash_code_ == kUnspecifiedHashCode_) {
+    return result;
+  }
+
+  // Use as many leading range columns as the limit on the number of key ranges allows.
+  const auto options = range_->range_options();
+  const size_t max_ranges = std::max(FLAGS_max_scan_key_ranges, 1);
+  size_t num_columns = 0;
+  size_t num_ranges = 1;
+  while (num_columns < options.size() &&
+         num_ranges * options[num_columns].size() <= max_ranges) {
+    num_ranges *= options[num_columns].size();
+    ++num_columns;
+  }
+  // A single key range is not narrower than the lower and upper bounds of the scan.
+  if (num_ranges <= 1) {
+    return result;
+  }
+
+  // Each key range fixes the leading range columns to one combination of their values and keeps
+  // the bounds of the remaining range columns.
+  auto lower_components = range_components(true);
+  auto upper_components = range_components(false);
+  const auto hash = static_cast<DocKeyHash>(hash_code_);
+  const size_t first_column_idx = schema_.num_hash_key_columns();
+  std::vector<size_t> indexes(num_columns, 0);
+  result.reserve(num_ranges);
+  for (size_t n = 0; n != num_ranges; ++n) {
+    for (size_t i = 0; i != num_columns; ++i) {
+      const auto& column = schema_.column(first_column_idx + i);
+      lower_components[i] =
+          PrimitiveValue::FromQLValuePB(options[i][indexes[i]], column.sorting_type());
+      upper_components[i] = lower_components[i];
+    }
+    result.push_back({DocKey(hash, *hashed_components_, lower_components),
+                      DocKey(hash, *hashed_components_, upper_components)});
+    // Move to the next combination of values, the last column changing fastest.
+    for (size_t i = num_columns; i-- > 0;) {
+      if (++indexes[i] != options[i].size()) {
+        break;
+      }
+      indexes[i] = 0;
+    }
+  }
+
+  // Descending columns order the keys differently from the values.
+  std::sort(result.begin(), result.end(), [](const DocKeyRange& lhs, const DocKeyRange& rhs) {
+    return lhs.lower < rhs.lower;
+  });
+  return result;
+}
+
 namespace {
 
 bool KeyWithinRange(const DocKey& key, const DocKey& lower_key, const DocKey& upper_key) {
@@ -167,6 +243,9 @@ Status DocQLScanSpec::GetBoundKey(const bool lower_bound, DocKey* key) const {
 }
 
 rocksdb::UserBoundaryTag TagForRangeComponent(size_t index);
+rocksdb::UserBoundaryTag TagForDocHybridTime();
+rocksdb::UserBoundaryTag TagForValueTtl();
+MonoDelta MaxValueTtl(const Slice* smallest, const Slice* largest, const MonoDelta& table_ttl);
 
 namespace {
 
@@ -192,15 +271,30 @@ bool GreaterOrEquals(const Slice& lhs, const Slice& rhs) {
   return lhs.compare(rhs) >= 0;
 }
 
-class RangeBasedFileFilter : public rocksdb::ReadFileFilter {
+// Skips SST files that cannot contain values visible to a scan, based on the boundary values
+// recorded for each file by the DocDB boundary values extractor:
+// - files whose range components are all outside the bounds of the scan,
+// - files whose records were all written after the read time limit,
+// - files whose values have all expired at the read time, if --skip_expired_files_on_read is set.
+class QLScanFileFilter : public rocksdb::ReadFileFilter {
  public:
-  RangeBasedFileFilter(const std::vector<PrimitiveValue>& lower_bounds,
-      const std::vector<PrimitiveValue>& upper_bounds)
+  QLScanFileFilter(const std::vector<PrimitiveValue>& lower_bounds,
+                   const std::vector<PrimitiveValue>& upper_bounds,
+                   const ReadHybridTime& read_time,
+                   const MonoDelta& table_ttl)
       : lower_bounds_(EncodePrimitiveValues(lower_bounds, upper_bounds.size())),
-      upper_bounds_(EncodePrimitiveValues(upper_bounds, lower_bounds.size())) {
+        upper_bounds_(EncodePrimitiveValues(upper_bounds, lower_bounds.size())),
+        read_time_(read_time),
+        table_ttl_(table_ttl),
+        skip_expired_(FLAGS_skip_expired_files_on_read) {
   }
 
   bool Filter(const rocksdb::FdWithBoundaries& file) const override {
+    return MatchesRangeComponents(file) && !WrittenAfterReadTime(file) && !Expired(file);
+  }
+
+ private:
+  bool MatchesRangeComponents(const rocksdb::FdWithBoundaries& file) const {
     for (size_t i = 0; i != lower_bounds_.size(); ++i) {
       auto lower_bound = lower_bounds_[i].AsSlice();
       auto upper_bound = upper_bounds_[i].AsSlice();
@@ -213,21 +307,49 @@ class RangeBasedFileFilter : public rocksdb::ReadFileFilter {
     }
     return true;
   }
- private:
+
+  // Records written after the global limit are neither visible nor cause a read restart.
+  bool WrittenAfterReadTime(const rocksdb::FdWithBoundaries& file) const {
+    DocHybridTime min_ht;
+    return read_time_.global_limit.is_valid() && DecodeHybridTime(file.smallest, &min_ht) &&
+           min_ht.hybrid_time() > read_time_.global_limit;
+  }
+
+  bool Expired(const rocksdb::FdWithBoundaries& file) const {
+    if (!skip_expired_ || !read_time_.read.is_valid()) {
+      return false;
+    }
+    DocHybridTime max_ht;
+    if (!DecodeHybridTime(file.largest, &max_ht)) {
+      return false;
+    }
+    const rocksdb::UserBoundaryTag tag = TagForValueTtl();
+    const MonoDelta max_ttl = MaxValueTtl(
+        file.smallest.user_value_with_tag(tag), file.largest.user_value_with_tag(tag), table_ttl_);
+    bool has_expired = false;
+    return HasExpiredTTL(max_ht.hybrid_time(), max_ttl, read_time_.read, &has_expired).ok() &&
+           has_expired;
+  }
+
+  static bool DecodeHybridTime(const rocksdb::LightweightBoundaries& boundaries,
+                               DocHybridTime* doc_ht) {
+    const Slice* encoded = boundaries.user_value_with_tag(TagForDocHybridTime());
+    return encoded != nullptr && doc_ht->FullyDecodeFrom(*encoded).ok();
+  }
+
   std::vector<KeyBytes> lower_bounds_;
   std::vector<KeyBytes> upper_bounds_;
+  const ReadHybridTime read_time_;
+  const MonoDelta table_ttl_;
+  const bool skip_expired_;
 };
 
 } // namespace
 
-std::shared_ptr<rocksdb::ReadFileFilter> DocQLScanSpec::CreateFileFilter() const {
-  auto lower_bound = range_components(true);
-  auto upper_bound = range_components(false);
-  if (lower_bound.empty() && upper_bound.empty()) {
-    return std::shared_ptr<rocksdb::ReadFileFilter>();
-  } else {
-    return std::make_shared<RangeBasedFileFilter>(std::move(lower_bound), std::move(upper_bound));
-  }
+std::shared_ptr<rocksdb::ReadFileFilter> DocQLScanSpec::CreateFileFilter(
+    const ReadHybridTime& read_time) const {
+  return std::make_shared<QLScanFileFilter>(
+      range_components(true), range_components(false), read_time, TableTTL(schema_));
 }
 
 }  // namespace docdb
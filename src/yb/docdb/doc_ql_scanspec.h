@@ -14,15 +14,24 @@
 #ifndef YB_DOCDB_DOC_QL_SCANSPEC_H
 #define YB_DOCDB_DOC_QL_SCANSPEC_H
 
+#include <limits>
+
 #include "yb/rocksdb/options.h"
 
 #include "yb/common/ql_scanspec.h"
+#include "yb/common/read_hybrid_time.h"
 #include "yb/docdb/doc_key.h"
 #include "yb/docdb/primitive_value.h"
 
 namespace yb {
 namespace docdb {
 
+// An inclusive range of doc keys to scan.
+struct DocKeyRange {
+  DocKey lower;
+  DocKey upper;
+};
+
 // DocDB variant of QL scanspec.
 class DocQLScanSpec : public common::QLScanSpec {
  public:
@@ -35,11 +44,13 @@ class DocQLScanSpec : public common::QLScanSpec {
 
   // Scan for the given hash key and a condition. If a start_doc_key is specified, the scan spec
   // will not include any static column for the start key. If the static columns are needed, a
-  // separate scan spec can be used to read just those static columns.
+  // separate scan spec can be used to read just those static columns. max_rows is the most rows
+  // the scan returns, e.g. the LIMIT or page size of the request.
   DocQLScanSpec(const Schema& schema, int32_t hash_code, int32_t max_hash_code,
       const std::vector<PrimitiveValue>& hashed_components, const QLConditionPB* req,
       const rocksdb::QueryId query_id, const bool is_forward_scan = true,
-      bool include_static_columns = false, const DocKey& start_doc_key = DocKey());
+      bool include_static_columns = false, const DocKey& start_doc_key = DocKey(),
+      size_t max_rows = std::numeric_limits<size_t>::max());
 
   // Return the inclusive lower and upper bounds of the scan.
   CHECKED_STATUS lower_bound(DocKey* key) const {
@@ -50,14 +61,28 @@ class DocQLScanSpec : public common::QLScanSpec {
     return GetBoundKey(false /* upper_bound */, key);
   }
 
-  // Create file filter based on range components.
-  std::shared_ptr<rocksdb::ReadFileFilter> CreateFileFilter() const;
+  // Create a filter that skips the SST files that cannot contain rows visible to a scan at the
+  // given read time, based on the range components and hybrid times recorded for each file.
+  std::shared_ptr<rocksdb::ReadFileFilter> CreateFileFilter(const ReadHybridTime& read_time) const;
+
+  // Disjoint doc key ranges to scan, sorted in ascending key order. Built when the WHERE condition
+  // restricts the leading range columns to a few values (e.g. "r IN (1, 500, 9000)"), so the scan
+  // can skip the keys between them. Empty if the scan is a single range from lower_bound() to
+  // upper_bound().
+  const std::vector<DocKeyRange>& key_ranges() const {
+    return key_ranges_;
+  }
 
   // Gets the query id.
   const rocksdb::QueryId QueryId() const {
     return query_id_;
   }
 
+  // Gets the most rows the scan returns.
+  size_t max_rows() const {
+    return max_rows_;
+  }
+
  private:
 
   // Return inclusive lower/upper range doc key considering the start_doc_key.
@@ -69,6 +94,9 @@ class DocQLScanSpec : public common::QLScanSpec {
   // Returns the lower/upper range components of the key.
   std::vector<PrimitiveValue> range_components(const bool lower_bound) const;
 
+  // Returns the disjoint key ranges to scan based on the range options of the condition.
+  std::vector<DocKeyRange> BuildKeyRanges() const;
+
   // The scan range within the hash key when a WHERE condition is specified.
   const std::unique_ptr<const common::QLScanRange> range_;
 
@@ -102,8 +130,14 @@ class DocQLScanSpec : public common::QLScanSpec {
   // Does the scan include static columns also?
   const bool include_static_columns_;
 
+  // Disjoint key ranges to scan, see key_ranges().
+  const std::vector<DocKeyRange> key_ranges_;
+
   // Query ID of this scan.
   const rocksdb::QueryId query_id_;
+
+  // The most rows the scan returns.
+  const size_t max_rows_;
 };
 
 }  // namespace docdb
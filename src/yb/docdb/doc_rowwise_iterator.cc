@@ -26,6 +26,14 @@
 #include "yb/gutil/strings/substitute.h"
 #include "yb/rocksdb/db/compaction.h"
 #include "yb/rocksutil/yb_rocksdb.h"
+#include "yb/util/flag_tags.h"
+
+DEFINE_uint64(docdb_small_scan_max_rows, 100,
+              "DocDB scans that are not restricted to a single hash key, but return at most this "
+              "many rows because of their limit or page size, read like point reads. In "
+              "particular they add the blocks they read to the block cache regardless of "
+              "--docdb_scan_fill_block_cache.");
+TAG_FLAG(docdb_small_scan_max_rows, advanced);
 
 using std::string;
 
@@ -49,8 +57,11 @@ DocRowwiseIterator::DocRowwiseIterator(
       has_bound_key_(false),
       pending_op_(pending_op_counter),
       done_(false) {
-  projection_subkeys_.reserve(projection.num_columns() + 1);
+  projection_subkeys_.reserve(projection.num_columns() + 2);
   projection_subkeys_.push_back(PrimitiveValue::SystemColumnId(SystemColumnIds::kLivenessColumn));
+  if (schema_.table_properties().use_packed_rows()) {
+    projection_subkeys_.emplace_back(ValueType::kPackedRow);
+  }
   for (size_t i = projection_.num_key_columns(); i < projection.num_columns(); i++) {
     projection_subkeys_.emplace_back(projection.column_id(i));
   }
@@ -65,12 +76,16 @@ Status DocRowwiseIterator::Init() {
 
   db_iter_ = CreateIntentAwareIterator(
       db_, BloomFilterMode::DONT_USE_BLOOM_FILTER, boost::none /* user_key_for_filter */,
-      query_id, txn_op_context_, read_time_);
+      query_id, txn_op_context_, read_time_, nullptr /* file_filter */, ReadAccessPattern::kScan);
+  if (schema_.table_properties().use_range_tombstones()) {
+    db_iter_->UseRangeTombstones();
+  }
 
   row_key_ = DocKey();
   db_iter_->Seek(row_key_);
   row_ready_ = false;
   has_bound_key_ = false;
+  key_ranges_.clear();
 
   return Status::OK();
 }
@@ -92,13 +107,22 @@ Status DocRowwiseIterator::Init(const common::QLScanSpec& spec) {
       upper_doc_key.HashedComponentsEqual(lower_doc_key);
   const auto mode = is_fixed_point_get ? BloomFilterMode::USE_BLOOM_FILTER :
       BloomFilterMode::DONT_USE_BLOOM_FILTER;
+  // Scans that are not restricted to a single hash key, such as full table scans, could read a
+  // large part of the table, unless they only return a few rows.
+  const bool is_small_scan = is_fixed_point_get ||
+      doc_spec.max_rows() <= FLAGS_docdb_small_scan_max_rows;
+  const auto access_pattern = is_small_scan ? ReadAccessPattern::kPointRead :
+      ReadAccessPattern::kScan;
 
   const KeyBytes row_key_encoded = lower_doc_key.Encode();
   const Slice row_key_encoded_as_slice = row_key_encoded.AsSlice();
 
   db_iter_ = CreateIntentAwareIterator(
       db_, mode, row_key_encoded_as_slice, doc_spec.QueryId(), txn_op_context_, read_time_,
-      doc_spec.CreateFileFilter());
+      doc_spec.CreateFileFilter(read_time_), access_pattern);
+  if (schema_.table_properties().use_range_tombstones()) {
+    db_iter_->UseRangeTombstones();
+  }
 
   db_iter_->SeekWithoutHt(row_key_encoded);
   row_ready_ = false;
@@ -127,9 +151,44 @@ Status DocRowwiseIterator::Init(const common::QLScanSpec& spec) {
     }
   }
 
+  key_ranges_ = doc_spec.key_ranges();
+  key_ranges_passed_ = 0;
+
   return Status::OK();
 }
 
+bool DocRowwiseIterator::AdvanceToKeyRange(bool* repositioned) const {
+  *repositioned = false;
+  if (is_forward_scan_) {
+    while (key_ranges_passed_ < key_ranges_.size() &&
+           row_key_ >= key_ranges_[key_ranges_passed_].upper) {
+      ++key_ranges_passed_;
+    }
+    if (key_ranges_passed_ == key_ranges_.size()) {
+      return false;
+    }
+    const auto& lower = key_ranges_[key_ranges_passed_].lower;
+    if (row_key_ < lower) {
+      db_iter_->Seek(lower);
+      *repositioned = true;
+    }
+  } else {
+    while (key_ranges_passed_ < key_ranges_.size() &&
+           row_key_ < key_ranges_[key_ranges_.size() - 1 - key_ranges_passed_].lower) {
+      ++key_ranges_passed_;
+    }
+    if (key_ranges_passed_ == key_ranges_.size()) {
+      return false;
+    }
+    const auto& upper = key_ranges_[key_ranges_.size() - 1 - key_ranges_passed_].upper;
+    if (row_key_ >= upper) {
+      db_iter_->PrevDocKey(upper);
+      *repositioned = true;
+    }
+  }
+  return true;
+}
+
 Status DocRowwiseIterator::EnsureIteratorPositionCorrect() const {
   if (!is_forward_scan_) {
     db_iter_->PrevDocKey(row_key_);
@@ -172,6 +231,18 @@ bool DocRowwiseIterator::HasNext() const {
       return false;
     }
 
+    if (!key_ranges_.empty()) {
+      bool repositioned = false;
+      if (!AdvanceToKeyRange(&repositioned)) {
+        done_ = true;
+        return false;
+      }
+      if (repositioned) {
+        // Skipped the keys between two key ranges, look at the first row of the next one.
+        continue;
+      }
+    }
+
     KeyBytes old_key(*fetched_key);
     // The iterator is positioned by the previous GetSubDocument call
     // (which places the iterator outside the previous doc_key).
@@ -122,6 +122,11 @@ class DocRowwiseIterator : public common::QLRowwiseIteratorIf {
                                      const Value& value,
                                      bool* is_valid) const;
 
+  // Moves to the key range that contains row_key_ or follows it in the scan direction. If row_key_
+  // is between two key ranges, repositions the iterator at the start of the next one and sets
+  // *repositioned. Returns false if row_key_ is past the last key range.
+  bool AdvanceToKeyRange(bool* repositioned) const;
+
   // For reverse scans, moves the iterator to the first kv-pair of the previous row after having
   // constructed the current row. For forward scans nothing is necessary because GetSubDocument
   // ensures that the iterator will be positioned on the first kv-pair of the next row.
@@ -152,6 +157,9 @@ class DocRowwiseIterator : public common::QLRowwiseIteratorIf {
   bool has_bound_key_;
   DocKey bound_key_;
 
+  // Disjoint key ranges to scan (see DocQLScanSpec::key_ranges()), empty for a single range scan.
+  std::vector<DocKeyRange> key_ranges_;
+
   std::unique_ptr<IntentAwareIterator> db_iter_;
 
   // We keep the "pending operation" counter incremented for the lifetime of this iterator so that
@@ -174,6 +182,9 @@ class DocRowwiseIterator : public common::QLRowwiseIteratorIf {
   // It is initialized to false, to make sure first HasNext constructs a new row.
   mutable bool row_ready_;
 
+  // The number of key ranges passed so far in the scan direction.
+  mutable size_t key_ranges_passed_ = 0;
+
   mutable std::vector<PrimitiveValue> projection_subkeys_;
 
   // Used for keeping track of errors that happen in HasNext. Returned
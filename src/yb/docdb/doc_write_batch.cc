@@ -165,7 +165,7 @@ CHECKED_STATUS DocWriteBatch::SetPrimitiveInternal(
 
       // Update our local cache to record the fact that we're adding this subdocument, so that
       // future operations in this DocWriteBatch don't have to add it or look for it in RocksDB.
-      cache_.Put(KeyBytes(doc_iter->key_prefix().AsSlice()), hybrid_time, ValueType::kObject);
+      cache_.Put(doc_iter->key_prefix().AsSlice(), hybrid_time, ValueType::kObject);
 
       doc_iter->AppendToPrefix(subkey);
     }
@@ -181,7 +181,7 @@ CHECKED_STATUS DocWriteBatch::SetPrimitiveInternal(
 
     // The key we use in the DocWriteBatchCache does not have a final hybrid_time, because that's
     // the key we expect to look up.
-    cache_.Put(doc_iter->key_prefix(), hybrid_time, value.primitive_value().value_type(),
+    cache_.Put(doc_iter->key_prefix().AsSlice(), hybrid_time, value.primitive_value().value_type(),
                value.user_timestamp());
   }
 
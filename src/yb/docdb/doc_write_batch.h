@@ -131,7 +131,7 @@ class DocWriteBatch {
 
   rocksdb::DB* rocksdb() { return rocksdb_; }
 
-  boost::optional<DocWriteBatchCache::Entry> LookupCache(const KeyBytes& encoded_key_prefix) {
+  boost::optional<DocWriteBatchCache::Entry> LookupCache(const Slice& encoded_key_prefix) {
     return cache_.Get(encoded_key_prefix);
   }
 
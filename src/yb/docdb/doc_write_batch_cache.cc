@@ -17,13 +17,13 @@
 #include <algorithm>
 #include <sstream>
 
+#include <glog/logging.h>
+
 #include "yb/docdb/doc_key.h"
 #include "yb/docdb/docdb-internal.h"
 #include "yb/docdb/primitive_value.h"
 #include "yb/util/bytes_formatter.h"
 
-using std::back_inserter;
-using std::copy;
 using std::endl;
 using std::ostringstream;
 using std::pair;
@@ -37,30 +37,42 @@ using yb::util::FormatBytesAsStr;
 namespace yb {
 namespace docdb {
 
-void DocWriteBatchCache::Put(const KeyBytes& key_bytes,
+DocWriteBatchCache::DocWriteBatchCache()
+    : arena_(std::make_unique<Arena>(1024, 64 * 1024)) {
+}
+
+void DocWriteBatchCache::Put(const Slice& encoded_key_prefix,
                              DocHybridTime gen_ht,
                              ValueType value_type,
                              UserTimeMicros user_timestamp,
                              bool found_exact_key_prefix) {
   DOCDB_DEBUG_LOG(
       "Writing to DocWriteBatchCache: encoded_key_prefix=$0, gen_ht=$1, value_type=$2",
-      BestEffortDocDBKeyToStr(key_bytes),
+      BestEffortDocDBKeyToStr(KeyBytes(encoded_key_prefix)),
       gen_ht.ToString(),
       ToString(value_type));
-  prefix_to_gen_ht_[key_bytes.AsStringRef()] =
-      {gen_ht, value_type, user_timestamp, found_exact_key_prefix};
+  const Entry entry = {gen_ht, value_type, user_timestamp, found_exact_key_prefix};
+  auto iter = prefix_to_gen_ht_.find(encoded_key_prefix);
+  if (iter != prefix_to_gen_ht_.end()) {
+    iter->second = entry;
+    return;
+  }
+  Slice key;
+  CHECK(arena_->RelocateSlice(encoded_key_prefix, &key));
+  prefix_to_gen_ht_.emplace(key, entry);
 }
 
 boost::optional<DocWriteBatchCache::Entry> DocWriteBatchCache::Get(
-    const KeyBytes& encoded_key_prefix) {
-  auto iter = prefix_to_gen_ht_.find(encoded_key_prefix.AsStringRef());
+    const Slice& encoded_key_prefix) {
+  auto iter = prefix_to_gen_ht_.find(encoded_key_prefix);
 #ifdef DOCDB_DEBUG
   if (iter == prefix_to_gen_ht_.end()) {
     DOCDB_DEBUG_LOG("DocWriteBatchCache contained no entry for $0",
-                    BestEffortDocDBKeyToStr(encoded_key_prefix));
+                    BestEffortDocDBKeyToStr(KeyBytes(encoded_key_prefix)));
   } else {
     DOCDB_DEBUG_LOG("DocWriteBatchCache entry found for key $0: $1",
-                    BestEffortDocDBKeyToStr(encoded_key_prefix), EntryToStr(iter->second));
+                    BestEffortDocDBKeyToStr(KeyBytes(encoded_key_prefix)),
+                    EntryToStr(iter->second));
   }
 #endif
   return iter == prefix_to_gen_ht_.end() ? boost::optional<Entry>() : iter->second;
@@ -68,7 +80,9 @@ boost::optional<DocWriteBatchCache::Entry> DocWriteBatchCache::Get(
 
 string DocWriteBatchCache::ToDebugString() {
   vector<pair<string, Entry>> sorted_contents;
-  copy(prefix_to_gen_ht_.begin(), prefix_to_gen_ht_.end(), back_inserter(sorted_contents));
+  for (const auto& kv : prefix_to_gen_ht_) {
+    sorted_contents.emplace_back(kv.first.ToBuffer(), kv.second);
+  }
   sort(sorted_contents.begin(), sorted_contents.end());
   ostringstream ss;
   ss << "DocWriteBatchCache[" << endl;
@@ -95,6 +109,7 @@ string DocWriteBatchCache::EntryToStr(const Entry& entry) {
 
 void DocWriteBatchCache::Clear() {
   prefix_to_gen_ht_.clear();
+  arena_->Reset();
 }
 
 }  // namespace docdb
@@ -14,6 +14,7 @@
 #ifndef YB_DOCDB_DOC_WRITE_BATCH_CACHE_H_
 #define YB_DOCDB_DOC_WRITE_BATCH_CACHE_H_
 
+#include <memory>
 #include <unordered_map>
 #include <string>
 
@@ -23,19 +24,26 @@
 #include "yb/docdb/key_bytes.h"
 #include "yb/docdb/value_type.h"
 #include "yb/docdb/value.h"
+#include "yb/util/memory/arena.h"
+#include "yb/util/slice.h"
 
 namespace yb {
 namespace docdb {
 
 // A utility used by DocWriteBatch. Caches generation hybrid_times (hybrid_times of full overwrite
 // or deletion) for key prefixes that were read from RocksDB or created by previous operations
-// performed on the DocWriteBatch.
+// performed on the DocWriteBatch, as well as key prefixes that were not found in RocksDB. The
+// DocWriteBatch is shared by all operations of a write batch, so that e.g. repeated updates of
+// the same document do not seek RocksDB again. Keys are copied into an arena owned by the cache.
 //
 // This class is not thread-safe.
 class DocWriteBatchCache {
  public:
+  DocWriteBatchCache();
+
   struct Entry {
     DocHybridTime doc_hybrid_time;
+    // kInvalidValueType if no key starting with the key prefix was found.
     ValueType value_type;
     UserTimeMicros user_timestamp = Value::kInvalidUserTimestamp;
     // We found a key which matched the exact key_prefix_ we were searching for (excluding the
@@ -51,14 +59,19 @@ class DocWriteBatchCache {
 
   // Records the generation hybrid_time corresponding to the given encoded key prefix, which is
   // assumed not to include the hybrid_time at the end.
-  void Put(const KeyBytes& encoded_key_prefix, DocHybridTime gen_ht, ValueType value_type,
+  void Put(const Slice& encoded_key_prefix, DocHybridTime gen_ht, ValueType value_type,
            UserTimeMicros user_timestamp = Value::kInvalidUserTimestamp,
            bool found_exact_key_prefix = true);
 
+  // Records that no key starting with the given encoded key prefix was found in RocksDB.
+  void PutNotFound(const Slice& encoded_key_prefix) {
+    Put(encoded_key_prefix, DocHybridTime::kInvalid, ValueType::kInvalidValueType,
+        Value::kInvalidUserTimestamp, false /* found_exact_key_prefix */);
+  }
+
   // Returns the latest generation hybrid_time for the document/subdocument identified by the given
   // encoded key prefix.
-  // TODO: switch to taking a slice as an input to avoid making a copy on lookup.
-  boost::optional<Entry> Get(const KeyBytes& encoded_key_prefix);
+  boost::optional<Entry> Get(const Slice& encoded_key_prefix);
 
   std::string ToDebugString();
 
@@ -67,7 +80,9 @@ class DocWriteBatchCache {
   void Clear();
 
  private:
-  std::unordered_map<std::string, Entry> prefix_to_gen_ht_;
+  // Holds the keys of prefix_to_gen_ht_. Allocated separately so that the cache stays movable.
+  std::unique_ptr<Arena> arena_;
+  std::unordered_map<Slice, Entry, Slice::Hash> prefix_to_gen_ht_;
 };
 
 
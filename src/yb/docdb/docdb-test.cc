@@ -1309,6 +1309,32 @@ TEST_F(DocDBTest, MultiOperationDocWriteBatch) {
       )#", dwb_str);
 }
 
+TEST_F(DocDBTest, DocWriteBatchCacheNotFound) {
+  const auto encoded_doc_key = DocKey(PrimitiveValues("a")).Encode();
+  auto dwb = MakeDocWriteBatch(InitMarkerBehavior::kRequired);
+
+  // Only the first deletion from a missing document seeks RocksDB.
+  ASSERT_OK(dwb.DeleteSubDoc(DocPath(encoded_doc_key, "b")));
+  ASSERT_EQ(1, dwb.GetAndResetNumRocksDBSeeks());
+  ASSERT_OK(dwb.DeleteSubDoc(DocPath(encoded_doc_key, "c")));
+  ASSERT_EQ(0, dwb.GetAndResetNumRocksDBSeeks());
+  ASSERT_TRUE(dwb.IsEmpty());
+
+  // Later operations see the document created by an earlier operation without seeking RocksDB.
+  ASSERT_OK(dwb.SetPrimitive(DocPath(encoded_doc_key, "b"), PrimitiveValue("v1")));
+  ASSERT_OK(dwb.DeleteSubDoc(DocPath(encoded_doc_key, "b")));
+  ASSERT_EQ(0, dwb.GetAndResetNumRocksDBSeeks());
+
+  string dwb_str;
+  ASSERT_OK(FormatDocWriteBatch(dwb, &dwb_str));
+  EXPECT_STR_EQ_VERBOSE_TRIMMED(
+      R"#(
+          1. PutCF('Sa\x00\x00!', '{')
+          2. PutCF('Sa\x00\x00!Sb\x00\x00', 'Sv1')
+          3. PutCF('Sa\x00\x00!Sb\x00\x00', 'X')
+      )#", dwb_str);
+}
+
 class DocDBTestBoundaryValues: public DocDBTest {
  protected:
   void TestBoundaryValues(size_t flush_rate) {
@@ -1524,6 +1550,31 @@ TEST_F(DocDBTest, MergingIterator) {
   VerifySubDocument(SubDocKey(key2), ht, "\"value2\"");
 }
 
+TEST_F(DocDBTest, SkipVersionsAfterReadTime) {
+  const DocKey doc_key(PrimitiveValues("counter"));
+  const KeyBytes encoded_doc_key = doc_key.Encode();
+  const DocPath path(encoded_doc_key, PrimitiveValue("v"));
+  constexpr int kNumUpdates = 1000;
+  for (int i = 0; i != kNumUpdates; ++i) {
+    ASSERT_OK(SetPrimitive(path, Value(PrimitiveValue("v" + std::to_string(i))),
+                           HybridTime::FromMicros(1000 + i)));
+  }
+  ASSERT_OK(FlushRocksDB());
+
+  // Reading at an old hybrid time should seek past the newer versions instead of stepping over
+  // each of them.
+  const auto old_nexts = options().statistics->getTickerCount(rocksdb::NUMBER_DB_NEXT);
+  VerifySubDocument(SubDocKey(doc_key, PrimitiveValue("v")), HybridTime::FromMicros(1010),
+                    "\"v10\"");
+  VerifySubDocument(SubDocKey(doc_key), HybridTime::FromMicros(1020), R"#(
+{
+  "v": "v20"
+}
+      )#");
+  const auto nexts = options().statistics->getTickerCount(rocksdb::NUMBER_DB_NEXT) - old_nexts;
+  ASSERT_LT(nexts, kNumUpdates / 10);
+}
+
 TEST_F(DocDBTest, SetPrimitiveWithInitMarker) {
   // Both required and optional init marker should be ok.
   for (auto init_marker_behavior : kInitMarkerBehaviorList) {
@@ -31,6 +31,7 @@
 #include "yb/docdb/intent.h"
 #include "yb/docdb/intent_aware_iterator.h"
 #include "yb/docdb/internal_doc_iterator.h"
+#include "yb/docdb/packed_row.h"
 #include "yb/docdb/shared_lock_manager.h"
 #include "yb/docdb/subdocument.h"
 #include "yb/docdb/value.h"
@@ -154,7 +155,8 @@ Status ExecuteDocWriteOperation(const vector<unique_ptr<DocOperation>>& doc_writ
                                 HybridTime* restart_read_ht) {
   DCHECK_ONLY_NOTNULL(restart_read_ht);
   DocWriteBatch doc_write_batch(rocksdb, init_marker_behavior, monotonic_counter);
-  DocOperationApplyData data = {&doc_write_batch, read_time, restart_read_ht};
+  QLRowReadCache row_read_cache;
+  DocOperationApplyData data = {&doc_write_batch, read_time, restart_read_ht, &row_read_cache};
   for (const unique_ptr<DocOperation>& doc_op : doc_write_ops) {
     RETURN_NOT_OK(doc_op->Apply(data));
   }
@@ -358,6 +360,32 @@ void SeekToLowerBound(const SubDocKeyBound& lower_bound, IntentAwareIterator* it
   }
 }
 
+// Sets the remaining TTL and the write time reported to the user on a primitive value written at
+// write_time, that is read at read_time.
+void SetTtlAndWriteTime(const MonoDelta& ttl,
+                        UserTimeMicros user_timestamp,
+                        const DocHybridTime& write_time,
+                        const HybridTime& read_time,
+                        PrimitiveValue* value) {
+  if (ttl.Equals(Value::kMaxTtl)) {
+    value->SetTtl(-1);
+  } else {
+    int64_t time_since_write_seconds = (
+        server::HybridClock::GetPhysicalValueMicros(read_time) -
+        server::HybridClock::GetPhysicalValueMicros(write_time.hybrid_time())) /
+        MonoTime::kMicrosecondsPerSecond;
+    int64_t ttl_seconds = std::max(static_cast<int64_t>(0),
+        ttl.ToMilliseconds() / MonoTime::kMillisecondsPerSecond - time_since_write_seconds);
+    value->SetTtl(ttl_seconds);
+  }
+
+  // Choose the user supplied timestamp if present.
+  value->SetWritetime(
+      user_timestamp == Value::kInvalidUserTimestamp
+          ? write_time.hybrid_time().GetPhysicalValueMicros()
+          : user_timestamp);
+}
+
 // This works similar to the ScanSubDocument function, but doesn't assume that object init_markers
 // are present. If no init marker is present, or if a tombstone is found at some level,
 // it still looks for subkeys inside it if they have larger timestamps.
@@ -386,35 +414,35 @@ CHECKED_STATUS BuildSubDocument(
         << "iter: " << iter_key->ToDebugString()
         << ", key: " << encoded_key.ToString();
 
-    SubDocKey found_key;
-    RETURN_NOT_OK(found_key.FullyDecodeFrom(*iter_key));
+    // Most entries are either skipped or read as primitive values, which only requires the
+    // boundaries of the key. The key is fully decoded only when needed.
+    SubDocKeyView found_key_view;
+    RETURN_NOT_OK(found_key_view.Decode(*iter_key));
 
     rocksdb::Slice value = iter->value();
 
     // Checking that intent aware iterator returns entry with correct time.
-    DCHECK_GE(iter->read_time().global_limit, found_key.hybrid_time())
-        << "Found key: " << found_key.ToString();
+    DCHECK_GE(iter->read_time().global_limit, found_key_view.hybrid_time())
+        << "Found key: " << found_key_view.ToString();
 
-    if (low_ts > found_key.doc_hybrid_time()) {
-      VLOG(3) << "SeekPastSubKey: $0" << found_key.ToString();
-      iter->SeekPastSubKey(found_key);
+    if (low_ts > found_key_view.doc_hybrid_time()) {
+      VLOG(3) << "SeekPastSubKey: " << found_key_view.ToString();
+      iter->SeekPastSubKeyWithoutHt(found_key_view.key_without_ht());
       continue;
     }
 
     Value doc_value;
     RETURN_NOT_OK(doc_value.Decode(value));
 
-    bool only_lacks_ht = false;
-    RETURN_NOT_OK(encoded_key.OnlyLacksHybridTimeFrom(*iter_key, &only_lacks_ht));
-    if (only_lacks_ht) {
+    if (found_key_view.key_without_ht() == encoded_key.AsSlice()) {
       const MonoDelta ttl = ComputeTTL(doc_value.ttl(), data.table_ttl);
 
-      DocHybridTime write_time = found_key.doc_hybrid_time();
+      DocHybridTime write_time = found_key_view.doc_hybrid_time();
 
       bool has_expired = false;
       if (!ttl.Equals(Value::kMaxTtl)) {
         const HybridTime expiry =
-            server::HybridClock::AddPhysicalTimeToHybridTime(found_key.hybrid_time(), ttl);
+            server::HybridClock::AddPhysicalTimeToHybridTime(found_key_view.hybrid_time(), ttl);
         if (iter->read_time().read.CompareTo(expiry) > 0) {
           has_expired = true;
           if (low_ts.hybrid_time() > expiry) {
@@ -450,14 +478,18 @@ CHECKED_STATUS BuildSubDocument(
         // If the low subkey cannot include the found key, we want to skip to the low subkey,
         // but if it can, we want to seek to the next key. This prevents an infinite loop
         // where the iterator keeps seeking to itself if the found key matches the low subkey.
-        if (IsObjectType(doc_value.value_type()) &&
-        data.low_subkey->IsValid() &&
-        !data.low_subkey->CanInclude(found_key)) {
+        bool seek_to_low_subkey = false;
+        if (IsObjectType(doc_value.value_type()) && data.low_subkey->IsValid()) {
+          SubDocKey found_key;
+          RETURN_NOT_OK(found_key.FullyDecodeFrom(found_key_view.encoded()));
+          seek_to_low_subkey = !data.low_subkey->CanInclude(found_key);
+        }
+        if (seek_to_low_subkey) {
           // Try to seek to the low_subkey for efficiency.
           SeekToLowerBound(*data.low_subkey, iter);
         } else {
-          VLOG(3) << "SeekPastSubKey: " << found_key.ToString();
-          iter->SeekPastSubKey(found_key);
+          VLOG(3) << "SeekPastSubKey: " << found_key_view.ToString();
+          iter->SeekPastSubKeyWithoutHt(found_key_view.key_without_ht());
         }
         continue;
       } else {
@@ -467,38 +499,23 @@ CHECKED_STATUS BuildSubDocument(
         }
 
         DCHECK_GE(iter->read_time().global_limit, write_time.hybrid_time());
-        if (ttl.Equals(Value::kMaxTtl)) {
-          doc_value.mutable_primitive_value()->SetTtl(-1);
-        } else {
-          int64_t time_since_write_seconds = (
-              server::HybridClock::GetPhysicalValueMicros(iter->read_time().read) -
-              server::HybridClock::GetPhysicalValueMicros(write_time.hybrid_time())) /
-              MonoTime::kMicrosecondsPerSecond;
-          int64_t ttl_seconds = std::max(static_cast<int64_t>(0),
-              ttl.ToMilliseconds() / MonoTime::kMillisecondsPerSecond - time_since_write_seconds);
-          doc_value.mutable_primitive_value()->SetTtl(ttl_seconds);
-        }
-
-        // Choose the user supplied timestamp if present.
-        const UserTimeMicros user_timestamp = doc_value.user_timestamp();
-        doc_value.mutable_primitive_value()->SetWritetime(
-            user_timestamp == Value::kInvalidUserTimestamp
-                ? write_time.hybrid_time().GetPhysicalValueMicros()
-                : doc_value.user_timestamp());
+        SetTtlAndWriteTime(ttl, doc_value.user_timestamp(), write_time, iter->read_time().read,
+                           doc_value.mutable_primitive_value());
         *data.result = SubDocument(doc_value.primitive_value());
-        VLOG(3) << "SeekForward: " << found_key.ToString() << ".AdvanceOutOfSubDoc() = "
-                << found_key.AdvanceOutOfSubDoc().ToString();
-        iter->SeekOutOfSubDoc(found_key);
+        VLOG(3) << "SeekOutOfSubDoc: " << found_key_view.ToString();
+        iter->SeekOutOfSubDocWithoutHt(found_key_view.key_without_ht());
         return Status::OK();
       }
     }
 
     SubDocument descendant = SubDocument(PrimitiveValue(ValueType::kInvalidValueType));
+    SubDocKey found_key;
+    RETURN_NOT_OK(found_key.FullyDecodeFrom(found_key_view.key_without_ht(),
+                                            HybridTimeRequired::kFalse));
     // TODO: what if found_key is the same as before? We'll get into an infinite recursion then.
-    found_key.remove_hybrid_time();
 
     {
-      auto encoded_found_key = found_key.Encode();
+      KeyBytes encoded_found_key(found_key_view.key_without_ht());
       IntentAwareIteratorPrefixScope prefix_scope(encoded_found_key, iter);
       RETURN_NOT_OK(BuildSubDocument(iter, data.Adjusted(&found_key, &descendant), low_ts));
     }
@@ -540,6 +557,40 @@ CHECKED_STATUS BuildSubDocument(
   return Status::OK();
 }
 
+// The latest packed row of a document, see PackedRow.
+struct PackedRowData {
+  PackedRow row;
+  DocHybridTime write_time = DocHybridTime::kMin;
+  MonoDelta ttl = Value::kMaxTtl;
+  // An expired packed row is treated as a deletion of all of its columns at the time it was
+  // written.
+  bool expired = false;
+};
+
+// Reads the latest packed row stored at packed_row_key if it was written after max_deleted_ts.
+// Otherwise leaves packed_row->row empty.
+CHECKED_STATUS ReadPackedRow(IntentAwareIterator* iter,
+                             const GetSubDocumentData& data,
+                             const KeyBytes& packed_row_key,
+                             DocHybridTime max_deleted_ts,
+                             PackedRowData* packed_row) {
+  packed_row->row.Clear();
+  DocHybridTime write_time = max_deleted_ts;
+  Value value;
+  RETURN_NOT_OK(iter->FindLastWriteTime(packed_row_key, &write_time, &value));
+  if (write_time == max_deleted_ts) {
+    return Status::OK();
+  }
+  if (value.value_type() != ValueType::kString) {
+    return STATUS_FORMAT(Corruption, "Expected packed row, got $0", value.value_type());
+  }
+  RETURN_NOT_OK(packed_row->row.DecodeFrom(value.mutable_primitive_value()->GetStringAsSlice()));
+  packed_row->write_time = write_time;
+  packed_row->ttl = ComputeTTL(value.ttl(), data.table_ttl);
+  return HasExpiredTTL(write_time.hybrid_time(), packed_row->ttl, iter->read_time().read,
+                       &packed_row->expired);
+}
+
 }  // namespace
 
 yb::Status GetSubDocument(
@@ -625,8 +676,10 @@ yb::Status GetSubDocument(
 
     return Status::OK();
   }
-  // For each subkey in the projection, build subdocument.
+  // For each subkey in the projection, build subdocument. The packed row subkey, if projected,
+  // sorts before all columns, so the packed row is read before any of the columns it holds.
   *data.result = SubDocument();
+  PackedRowData packed_row;
   for (const PrimitiveValue& subkey : *projection) {
     SubDocKey projection_subdockey = *data.subdocument_key;
     projection_subdockey.AppendSubKeysAndMaybeHybridTime(subkey);
@@ -636,9 +689,35 @@ yb::Status GetSubDocument(
     IntentAwareIteratorPrefixScope prefix_scope(encoded_projection_subdockey, db_iter);
     db_iter->SeekForwardWithoutHt(encoded_projection_subdockey);
 
+    if (subkey.value_type() == ValueType::kPackedRow) {
+      RETURN_NOT_OK(ReadPackedRow(
+          db_iter, data, encoded_projection_subdockey, max_deleted_ts, &packed_row));
+      continue;
+    }
+
     SubDocument descendant(ValueType::kInvalidValueType);
-    RETURN_NOT_OK(BuildSubDocument(
-        db_iter, data.Adjusted(&projection_subdockey, &descendant), max_deleted_ts));
+    const PrimitiveValue* packed_value = packed_row.row.GetColumn(subkey);
+    if (packed_value != nullptr) {
+      // The column value in the packed row is only used if the column was not written on its own
+      // after the packed row.
+      DocHybridTime column_write_time = packed_row.write_time;
+      RETURN_NOT_OK(db_iter->FindLastWriteTime(
+          encoded_projection_subdockey, &column_write_time, nullptr));
+      if (column_write_time != packed_row.write_time) {
+        packed_value = nullptr;
+      }
+    }
+    if (packed_value != nullptr) {
+      if (!packed_row.expired && packed_value->value_type() != ValueType::kTombstone) {
+        PrimitiveValue value = *packed_value;
+        SetTtlAndWriteTime(packed_row.ttl, Value::kInvalidUserTimestamp, packed_row.write_time,
+                           db_iter->read_time().read, &value);
+        descendant = SubDocument(std::move(value));
+      }
+    } else {
+      RETURN_NOT_OK(BuildSubDocument(
+          db_iter, data.Adjusted(&projection_subdockey, &descendant), max_deleted_ts));
+    }
     if (descendant.value_type() != ValueType::kInvalidValueType) {
       *data.doc_found = true;
     }
@@ -715,8 +794,23 @@ Result<std::string> DocDBValueToDebugStr(Slice value_slice, const KeyType& key_t
   }
 }
 
-Result<std::string> DocDBValueToDebugStr(
-    KeyType key_type, const std::string& key_str, Slice value) {
+// Formats the columns of a packed row instead of its encoded payload.
+Result<std::string> PackedRowValueToDebugStr(Slice value_slice) {
+  Value v;
+  RETURN_NOT_OK_PREPEND(v.Decode(value_slice), "Error: failed to decode packed row value");
+  if (v.value_type() != ValueType::kString) {
+    return STATUS_FORMAT(Corruption, "Expected packed row, got $0", v.value_type());
+  }
+  PackedRow packed_row;
+  RETURN_NOT_OK(packed_row.DecodeFrom(v.mutable_primitive_value()->GetStringAsSlice()));
+  std::string result = packed_row.ToString();
+  if (v.has_ttl()) {
+    result += "; ttl: " + v.ttl().ToString();
+  }
+  return result;
+}
+
+Result<std::string> DocDBValueToDebugStr(KeyType key_type, Slice key, Slice value) {
   switch (key_type) {
     case KeyType::kTransactionMetadata: {
       TransactionMetadataPB metadata_pb;
@@ -731,9 +825,17 @@ Result<std::string> DocDBValueToDebugStr(
       KeyType ignore_key_type;
       return DocDBKeyToDebugStr(value, &ignore_key_type);
     }
+    case KeyType::kValueKey: {
+      SubDocKey subdoc_key;
+      RETURN_NOT_OK(subdoc_key.FullyDecodeFrom(key));
+      if (subdoc_key.num_subkeys() > 0 &&
+          subdoc_key.subkeys().back().value_type() == ValueType::kPackedRow) {
+        return PackedRowValueToDebugStr(value);
+      }
+      return DocDBValueToDebugStr(value, key_type);
+    }
     case KeyType::kEmpty: FALLTHROUGH_INTENDED;
-    case KeyType::kIntentKey: FALLTHROUGH_INTENDED;
-    case KeyType::kValueKey:
+    case KeyType::kIntentKey:
       return DocDBValueToDebugStr(value, key_type);
   }
   FATAL_INVALID_ENUM_VALUE(KeyType, key_type);
@@ -746,7 +848,7 @@ void ProcessDumpEntry(Slice key, Slice value, IncludeBinary include_binary, std:
     *out << key_str.status() << endl;
     return;
   }
-  Result<std::string> value_str = DocDBValueToDebugStr(key_type, *key_str, value);
+  Result<std::string> value_str = DocDBValueToDebugStr(key_type, key, value);
   if (!value_str.ok()) {
     *out << value_str.status().CloneAndAppend(Substitute(". Key: $0", *key_str)) << endl;
     return;
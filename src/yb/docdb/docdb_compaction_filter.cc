@@ -18,12 +18,24 @@
 #include <glog/logging.h>
 
 #include "yb/rocksdb/compaction_filter.h"
+#include "yb/rocksdb/metadata.h"
 #include "yb/rocksdb/util/string_util.h"
 
 #include "yb/docdb/doc_key.h"
+#include "yb/docdb/doc_kv_util.h"
 #include "yb/docdb/docdb-internal.h"
 #include "yb/docdb/value.h"
 #include "yb/rocksutil/yb_rocksdb.h"
+#include "yb/util/flag_tags.h"
+
+DEFINE_int32(expired_files_time_windows_per_ttl, 4,
+             "For tables created with drop_expired_files, SST files are only compacted together "
+             "if their latest writes fall into the same time window, so that old files expire as "
+             "a whole. The table TTL is split into this many time windows. Each closed time window "
+             "can keep up to --rocksdb_level0_file_num_compaction_trigger - 1 files, so when there "
+             "are too many files for the slowdown trigger, the oldest time windows are compacted "
+             "together. 0 disables time windows.");
+TAG_FLAG(expired_files_time_windows_per_ttl, advanced);
 
 using std::shared_ptr;
 using std::unique_ptr;
@@ -34,6 +46,10 @@ using rocksdb::VectorToString;
 namespace yb {
 namespace docdb {
 
+rocksdb::UserBoundaryTag TagForValueTtl();
+MonoDelta MaxValueTtl(const Slice* smallest, const Slice* largest, const MonoDelta& table_ttl);
+Status GetDocHybridTime(const rocksdb::UserBoundaryValues& values, DocHybridTime* out);
+
 // ------------------------------------------------------------------------------------------------
 
 DocDBCompactionFilter::DocDBCompactionFilter(HybridTime history_cutoff,
@@ -73,10 +89,12 @@ bool DocDBCompactionFilter::Filter(int level,
     filter_usage_logged_ = true;
   }
 
-  SubDocKey subdoc_key;
+  // Only the component boundaries of the key are decoded here, individual subkeys are decoded when
+  // needed.
+  SubDocKeyView subdoc_key;
 
   // TODO: Find a better way for handling of data corruption encountered during compactions.
-  const Status key_decode_status = subdoc_key.FullyDecodeFrom(key);
+  const Status key_decode_status = subdoc_key.Decode(key);
   CHECK(key_decode_status.ok())
     << "Error decoding a key during compaction: " << key_decode_status.ToString() << "\n"
     << "    Key (raw): " << FormatRocksDBSliceAsStr(key) << "\n"
@@ -92,6 +110,13 @@ bool DocDBCompactionFilter::Filter(int level,
   // Remove overwrite hybrid_times for components that are no longer relevant for the current
   // SubDocKey.
   overwrite_ht_.resize(min(overwrite_ht_.size(), num_shared_components));
+  if (num_shared_components == 0) {
+    // The packed row of the previous document does not apply to this one.
+    packed_row_.Clear();
+  }
+  if (!range_tombstones_.partition().empty() && !key.starts_with(range_tombstones_.partition())) {
+    range_tombstones_.Clear();
+  }
 
   const DocHybridTime& ht = subdoc_key.doc_hybrid_time();
 
@@ -131,6 +156,22 @@ bool DocDBCompactionFilter::Filter(int level,
     return true;  // Remove this key/value pair.
   }
 
+  // Similarly, a column value written before the packed row that holds this column is overwritten
+  // by it. Packed rows only hold top-level columns, and the packed row of a document sorts before
+  // all of its columns.
+  if (!packed_row_.empty() && subdoc_key.num_subkeys() == 1 && ht < packed_row_ht_) {
+    PrimitiveValue column;
+    CHECK_OK(subdoc_key.DecodeSubkey(0, &column));
+    if (packed_row_.GetColumn(column) != nullptr) {
+      return true;
+    }
+  }
+
+  if (!range_tombstones_.empty() &&
+      ht < range_tombstones_.DeleteTime(subdoc_key.key_without_ht())) {
+    return true;
+  }
+
   const int new_stack_size = subdoc_key.num_subkeys() + 1;
 
   // Every subdocument was fully overwritten at least at the time any of its parents was fully
@@ -156,20 +197,29 @@ bool DocDBCompactionFilter::Filter(int level,
   overwrite_ht_.push_back(ht_at_or_below_cutoff ? max(prev_overwrite_ht, ht) : prev_overwrite_ht);
 
   CHECK_EQ(new_stack_size, overwrite_ht_.size());
-  prev_subdoc_key_ = std::move(subdoc_key);
+  prev_subdoc_key_.AssignCopy(subdoc_key, &prev_key_buffer_);
 
-  if (prev_subdoc_key_.num_subkeys() > 0 &&
-      prev_subdoc_key_.subkeys()[0].value_type() == ValueType::kColumnId) {
+  if (subdoc_key.num_subkeys() > 0 && subdoc_key.subkey_type(0) == ValueType::kColumnId) {
     // Column ID is first subkey in QL tables.
-    ColumnId col_id = prev_subdoc_key_.subkeys()[0].GetColumnId();
+    PrimitiveValue column;
+    CHECK_OK(subdoc_key.DecodeSubkey(0, &column));
 
-    if (deleted_cols_->find(col_id) != deleted_cols_->end()) {
+    if (deleted_cols_->find(column.GetColumnId()) != deleted_cols_->end()) {
       return true;
     }
   }
 
+  if (subdoc_key.num_subkeys() == 1 && subdoc_key.subkey_type(0) == ValueType::kPackedRow) {
+    MaybeProcessPackedRow(ht, ht_at_or_below_cutoff, existing_value, new_value, value_changed);
+  }
+
   ValueType value_type;
   CHECK_OK(Value::DecodePrimitiveValueType(existing_value, &value_type));
+
+  if (ht_at_or_below_cutoff && value_type == ValueType::kTombstone &&
+      subdoc_key.num_subkeys() > 0 && subdoc_key.subkey_type(0) == ValueType::kRangeTombstone) {
+    MaybeAddRangeTombstone(subdoc_key);
+  }
   MonoDelta ttl;
 
   // If the value expires by the time of history cutoff, it is treated as deleted and filtered out.
@@ -207,6 +257,58 @@ bool DocDBCompactionFilter::Filter(int level,
   return value_type == ValueType::kTombstone && ht_at_or_below_cutoff && is_full_compaction_;
 }
 
+void DocDBCompactionFilter::MaybeProcessPackedRow(const DocHybridTime& ht,
+                                                  bool ht_at_or_below_cutoff,
+                                                  const rocksdb::Slice& existing_value,
+                                                  std::string* new_value,
+                                                  bool* value_changed) const {
+  Value value;
+  CHECK_OK(value.Decode(existing_value));
+  CHECK(value.value_type() == ValueType::kString)
+      << "Unexpected packed row value type: " << value.value_type();
+  PackedRow packed_row;
+  CHECK_OK(packed_row.DecodeFrom(value.mutable_primitive_value()->GetStringAsSlice()));
+
+  // Drop the values of deleted columns from the packed row.
+  PackedRow remaining_columns;
+  for (const auto& column : packed_row.columns()) {
+    if (column.subkey.value_type() != ValueType::kColumnId ||
+        deleted_cols_->find(column.subkey.GetColumnId()) == deleted_cols_->end()) {
+      remaining_columns.AddColumn(column.subkey, column.value);
+    }
+  }
+  if (remaining_columns.columns().size() != packed_row.columns().size()) {
+    *value.mutable_primitive_value() = remaining_columns.Encode();
+    *new_value = value.Encode();
+    *value_changed = true;
+  }
+
+  // Earlier versions of the packed row have already been removed using overwrite_ht_, so this is
+  // the version visible at history_cutoff_. This has to be recorded even if the packed row has
+  // expired, since it still hides the earlier column values.
+  if (ht_at_or_below_cutoff) {
+    packed_row_ = std::move(remaining_columns);
+    packed_row_ht_ = ht;
+  }
+}
+
+void DocDBCompactionFilter::MaybeAddRangeTombstone(const SubDocKeyView& subdoc_key) const {
+  RangeTombstone tombstone;
+  const auto is_tombstone = DecodeRangeTombstone(subdoc_key, &tombstone);
+  CHECK_OK(is_tombstone);
+  if (!*is_tombstone) {
+    return;
+  }
+  if (range_tombstones_.partition().empty()) {
+    const auto partition_size = RangeTombstonePartitionSize(subdoc_key.encoded());
+    CHECK_OK(partition_size);
+    CHECK_GT(*partition_size, 0) << "Range tombstone without hashed components: " << subdoc_key;
+    range_tombstones_.Reset(Slice(subdoc_key.encoded().data(), *partition_size));
+  }
+  // Earlier versions of the range tombstone have already been removed using overwrite_ht_.
+  range_tombstones_.Add(std::move(tombstone));
+}
+
 const char* DocDBCompactionFilter::Name() const {
   return "DocDBCompactionFilter";
 }
@@ -234,5 +336,81 @@ const char* DocDBCompactionFilterFactory::Name() const {
   return "DocDBCompactionFilterFactory";
 }
 
+// ------------------------------------------------------------------------------------------------
+
+namespace {
+
+// Returns the encoded value TTL boundary of a file, or an empty slice if there is none. The
+// encoded value is owned by the boundary value.
+Slice EncodedValueTtl(const rocksdb::FileBoundaryValuesBase& boundaries) {
+  auto value = rocksdb::UserValueWithTag(boundaries.user_values, TagForValueTtl());
+  return value ? value->Encode() : Slice();
+}
+
+// Decides whether SST files have expired from the DocDB boundary values recorded for them: the
+// latest hybrid time a record of the file was written at and the range of TTLs of its values.
+class DocDBCompactionFileFilter : public rocksdb::CompactionFileFilter {
+ public:
+  DocDBCompactionFileFilter(HybridTime history_cutoff, MonoDelta table_ttl)
+      : history_cutoff_(history_cutoff), table_ttl_(table_ttl) {
+    if (!table_ttl_.Equals(Value::kMaxTtl) && FLAGS_expired_files_time_windows_per_ttl > 0) {
+      time_window_us_ = table_ttl_.ToMicroseconds() / FLAGS_expired_files_time_windows_per_ttl;
+    }
+  }
+
+  // Values written at or before the history cutoff that have expired at the history cutoff are
+  // not visible to any read.
+  bool Expired(const rocksdb::FileBoundaryValuesBase& smallest,
+               const rocksdb::FileBoundaryValuesBase& largest) const override {
+    DocHybridTime max_ht;
+    if (!GetDocHybridTime(largest.user_values, &max_ht).ok() ||
+        max_ht.hybrid_time() > history_cutoff_) {
+      return false;
+    }
+    const Slice smallest_ttl = EncodedValueTtl(smallest);
+    const Slice largest_ttl = EncodedValueTtl(largest);
+    const MonoDelta max_ttl = MaxValueTtl(smallest_ttl.empty() ? nullptr : &smallest_ttl,
+                                          largest_ttl.empty() ? nullptr : &largest_ttl,
+                                          table_ttl_);
+    bool has_expired = false;
+    return HasExpiredTTL(max_ht.hybrid_time(), max_ttl, history_cutoff_, &has_expired).ok() &&
+           has_expired;
+  }
+
+  uint64_t TimeWindow(const rocksdb::FileBoundaryValuesBase& smallest,
+                      const rocksdb::FileBoundaryValuesBase& largest) const override {
+    DocHybridTime max_ht;
+    if (time_window_us_ <= 0 || !GetDocHybridTime(largest.user_values, &max_ht).ok()) {
+      return 0;
+    }
+    return max_ht.hybrid_time().GetPhysicalValueMicros() / time_window_us_;
+  }
+
+ private:
+  const HybridTime history_cutoff_;
+  const MonoDelta table_ttl_;
+  int64_t time_window_us_ = 0;
+};
+
+} // namespace
+
+DocDBCompactionFileFilterFactory::DocDBCompactionFileFilterFactory(
+    shared_ptr<HistoryRetentionPolicy> retention_policy)
+    : retention_policy_(std::move(retention_policy)) {
+}
+
+DocDBCompactionFileFilterFactory::~DocDBCompactionFileFilterFactory() {
+}
+
+unique_ptr<rocksdb::CompactionFileFilter>
+    DocDBCompactionFileFilterFactory::CreateCompactionFileFilter() {
+  return std::make_unique<DocDBCompactionFileFilter>(
+      retention_policy_->GetHistoryCutoff(), retention_policy_->GetTableTTL());
+}
+
+const char* DocDBCompactionFileFilterFactory::Name() const {
+  return "DocDBCompactionFileFilterFactory";
+}
+
 }  // namespace docdb
 }  // namespace yb
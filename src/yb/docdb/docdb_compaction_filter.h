@@ -23,6 +23,8 @@
 #include "yb/common/schema.h"
 #include "yb/common/hybrid_time.h"
 #include "yb/docdb/doc_key.h"
+#include "yb/docdb/packed_row.h"
+#include "yb/docdb/range_tombstone.h"
 
 namespace yb {
 namespace docdb {
@@ -43,6 +45,17 @@ class DocDBCompactionFilter : public rocksdb::CompactionFilter {
   const char* Name() const override;
 
  private:
+  // Removes deleted columns from a packed row and remembers it if it is visible at the history
+  // cutoff.
+  void MaybeProcessPackedRow(const DocHybridTime& ht,
+                             bool ht_at_or_below_cutoff,
+                             const rocksdb::Slice& existing_value,
+                             std::string* new_value,
+                             bool* value_changed) const;
+
+  // Remembers a range tombstone that is visible at the history cutoff.
+  void MaybeAddRangeTombstone(const SubDocKeyView& subdoc_key) const;
+
   // We will not keep history below this hybrid_time. The view of the database at this hybrid_time
   // is preserved, but after the compaction completes, we should not expect to be able to do
   // consistent scans at DocDB hybrid_times lower than this. Those scans will result in missing
@@ -52,7 +65,9 @@ class DocDBCompactionFilter : public rocksdb::CompactionFilter {
   const bool is_full_compaction_;
 
   mutable bool is_first_key_value_;
-  mutable SubDocKey prev_subdoc_key_;
+  mutable SubDocKeyView prev_subdoc_key_;
+  // Holds a copy of the key prev_subdoc_key_ refers to.
+  mutable std::string prev_key_buffer_;
 
   // A stack of highest hybrid_times lower than or equal to history_cutoff_ at which parent
   // subdocuments of the key that has just been processed, or the subdocument / primitive value
@@ -92,6 +107,19 @@ class DocDBCompactionFilter : public rocksdb::CompactionFilter {
 
   mutable std::vector<DocHybridTime> overwrite_ht_;
 
+  // The packed row of the current document that is visible at history_cutoff_, and the hybrid time
+  // it was written at. Values of the columns it holds that were written at earlier hybrid times
+  // are not visible at history_cutoff_ or later, so they are removed. Empty if there is no such
+  // packed row.
+  mutable PackedRow packed_row_;
+  mutable DocHybridTime packed_row_ht_;
+
+  // The range tombstones at or below history_cutoff_ of the current hash partition. They sort
+  // before all entries of the partition they cover, and entries written before them are removed.
+  // The range tombstones themselves are removed like other tombstones, since a full compaction
+  // removes all entries they cover at the same time.
+  mutable RangeTombstones range_tombstones_;
+
   // We use this to only log a message that the filter is being used once on the first call to
   // the Filter function.
   mutable bool filter_usage_logged_;
@@ -149,6 +177,20 @@ class DocDBCompactionFilterFactory : public rocksdb::CompactionFilterFactory {
   std::shared_ptr<HistoryRetentionPolicy> retention_policy_;
 };
 
+// Creates filters that let compactions delete SST files whose values have all expired at the
+// history cutoff, and that group files into time windows of a fraction of the table TTL.
+class DocDBCompactionFileFilterFactory : public rocksdb::CompactionFileFilterFactory {
+ public:
+  explicit DocDBCompactionFileFilterFactory(
+      std::shared_ptr<HistoryRetentionPolicy> retention_policy);
+  ~DocDBCompactionFileFilterFactory() override;
+  std::unique_ptr<rocksdb::CompactionFileFilter> CreateCompactionFileFilter() override;
+  const char* Name() const override;
+
+ private:
+  std::shared_ptr<HistoryRetentionPolicy> retention_policy_;
+};
+
 }  // namespace docdb
 }  // namespace yb
 
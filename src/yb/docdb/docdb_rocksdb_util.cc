@@ -17,6 +17,7 @@
 
 #include "yb/common/transaction.h"
 
+#include "yb/rocksdb/perf_context.h"
 #include "yb/rocksdb/rate_limiter.h"
 #include "yb/rocksdb/table.h"
 
@@ -52,6 +53,9 @@ DEFINE_uint64(rocksdb_compaction_size_threshold_bytes, 2ULL * 1024 * 1024 * 1024
              "Threshold beyond which compaction is considered large.");
 DEFINE_uint64(rocksdb_max_file_size_for_compaction, 0,
              "Maximal allowed file size to participate in RocksDB compaction. 0 - unlimited.");
+DEFINE_bool(rocksdb_use_direct_io_for_flush_and_compaction, false,
+            "Use O_DIRECT for SST files written by flush and compaction and for compaction "
+            "inputs, so that they do not evict hot pages from the OS page cache.");
 
 DEFINE_int64(db_block_size_bytes, 32 * 1024,
              "Size of RocksDB block (in bytes).");
@@ -64,6 +68,14 @@ DEFINE_bool(use_docdb_aware_bloom_filter, true,
 DEFINE_int32(max_nexts_to_avoid_seek, 8,
              "The number of next calls to try before doing resorting to do a rocksdb seek.");
 DEFINE_bool(trace_docdb_calls, false, "Whether we should trace calls into the docdb.");
+DEFINE_uint64(docdb_scan_readahead_size_bytes, 256 * 1024,
+              "Number of bytes of an SST file that a DocDB scan reads ahead once it reads the "
+              "data blocks of the file sequentially. 0 to disable readahead.");
+DEFINE_bool(docdb_scan_fill_block_cache, false,
+            "Whether DocDB scans that are not restricted to a single hash key (e.g. full table "
+            "scans) and return more than --docdb_small_scan_max_rows rows add the data blocks "
+            "they read to the block cache. Such scans read many blocks once, and would evict the "
+            "blocks used by point reads.");
 
 DEFINE_uint64(initial_seqno, 1ULL << 50, "Initial seqno for new RocksDB instances.");
 
@@ -173,7 +185,11 @@ void SeekForward(const KeyBytes& key_bytes, rocksdb::Iterator *iter) {
 }
 
 void SeekPastSubKey(const SubDocKey& sub_doc_key, rocksdb::Iterator* iter) {
-  KeyBytes key_bytes = sub_doc_key.Encode(/* include_hybrid_time */ false);
+  SeekPastSubKey(sub_doc_key.Encode(/* include_hybrid_time */ false), iter);
+}
+
+void SeekPastSubKey(const Slice& key_without_ht, rocksdb::Iterator* iter) {
+  KeyBytes key_bytes(key_without_ht);
   AppendDocHybridTime(DocHybridTime::kMin, &key_bytes);
   SeekForward(key_bytes, iter);
 }
@@ -182,7 +198,8 @@ void PerformRocksDBSeek(
     rocksdb::Iterator *iter,
     const rocksdb::Slice &seek_key,
     const char* file_name,
-    int line) {
+    int line,
+    int* max_nexts) {
 #ifndef NDEBUG
   {
     // Validating that we're only using keys with a max "write id" component, or no HybridTime at
@@ -218,6 +235,8 @@ void PerformRocksDBSeek(
   }
 #endif
 
+  const int max_nexts_to_avoid_seek =
+      max_nexts != nullptr ? *max_nexts : FLAGS_max_nexts_to_avoid_seek;
   int next_count = 0;
   int seek_count = 0;
   if (seek_key.size() == 0) {
@@ -225,19 +244,27 @@ void PerformRocksDBSeek(
   } else if (!iter->Valid() || iter->key().compare(seek_key) > 0) {
     iter->Seek(seek_key);
   } else {
-    for (int nexts = 0; nexts <= FLAGS_max_nexts_to_avoid_seek; nexts++) {
+    for (int nexts = 0; nexts <= max_nexts_to_avoid_seek; nexts++) {
       if (!iter->Valid() || iter->key().compare(seek_key) >= 0) {
         if (FLAGS_trace_docdb_calls) {
           TRACE("Did $0 Next(s) instead of a Seek", nexts);
         }
+        if (max_nexts != nullptr && nexts > 0) {
+          *max_nexts = std::min(*max_nexts + 1, FLAGS_max_nexts_to_avoid_seek);
+        }
         break;
       }
-      if (nexts < FLAGS_max_nexts_to_avoid_seek) {
+      if (nexts < max_nexts_to_avoid_seek) {
         iter->Next();
         ++next_count;
       } else {
         if (FLAGS_trace_docdb_calls) {
-          TRACE("Forced to do an actual Seek after $0 Next(s)", FLAGS_max_nexts_to_avoid_seek);
+          TRACE("Forced to do an actual Seek after $0 Next(s)", max_nexts_to_avoid_seek);
+        }
+        if (max_nexts != nullptr) {
+          // Keep trying at least one Next(), so that the limit can grow back once there are fewer
+          // keys to skip.
+          *max_nexts = std::min(std::max(*max_nexts / 2, 1), FLAGS_max_nexts_to_avoid_seek);
         }
         iter->Seek(seek_key);
         ++seek_count;
@@ -263,6 +290,17 @@ void PerformRocksDBSeek(
       seek_count);
 }
 
+AdaptiveForwardSeeker::AdaptiveForwardSeeker()
+    : max_nexts_(FLAGS_max_nexts_to_avoid_seek) {
+}
+
+void AdaptiveForwardSeeker::SeekForward(const rocksdb::Slice& seek_key, rocksdb::Iterator* iter) {
+  if (!iter->Valid() || iter->key().compare(seek_key) >= 0) {
+    return;
+  }
+  PerformRocksDBSeek(iter, seek_key, __FILE__, __LINE__, &max_nexts_);
+}
+
 void PerformRocksDBReverseSeek(
     rocksdb::Iterator *iter,
     const rocksdb::Slice &seek_key,
@@ -283,9 +321,14 @@ rocksdb::ReadOptions PrepareReadOptions(
     BloomFilterMode bloom_filter_mode,
     const boost::optional<const Slice>& user_key_for_filter,
     const rocksdb::QueryId query_id,
-    std::shared_ptr<rocksdb::ReadFileFilter> file_filter) {
+    std::shared_ptr<rocksdb::ReadFileFilter> file_filter,
+    ReadAccessPattern access_pattern) {
   rocksdb::ReadOptions read_opts;
   read_opts.query_id = query_id;
+  if (access_pattern == ReadAccessPattern::kScan) {
+    read_opts.readahead_size = FLAGS_docdb_scan_readahead_size_bytes;
+    read_opts.fill_cache = FLAGS_docdb_scan_fill_block_cache;
+  }
   if (FLAGS_use_docdb_aware_bloom_filter &&
     bloom_filter_mode == BloomFilterMode::USE_BLOOM_FILTER) {
     DCHECK(user_key_for_filter);
@@ -303,9 +346,10 @@ unique_ptr<rocksdb::Iterator> CreateRocksDBIterator(
     BloomFilterMode bloom_filter_mode,
     const boost::optional<const Slice>& user_key_for_filter,
     const rocksdb::QueryId query_id,
-    std::shared_ptr<rocksdb::ReadFileFilter> file_filter) {
+    std::shared_ptr<rocksdb::ReadFileFilter> file_filter,
+    ReadAccessPattern access_pattern) {
   return unique_ptr<rocksdb::Iterator>(rocksdb->NewIterator(PrepareReadOptions(rocksdb,
-      bloom_filter_mode, user_key_for_filter, query_id, std::move(file_filter))));
+      bloom_filter_mode, user_key_for_filter, query_id, std::move(file_filter), access_pattern)));
 }
 
 unique_ptr<IntentAwareIterator> CreateIntentAwareIterator(
@@ -315,13 +359,45 @@ unique_ptr<IntentAwareIterator> CreateIntentAwareIterator(
     const rocksdb::QueryId query_id,
     const TransactionOperationContextOpt& txn_op_context,
     const ReadHybridTime& read_time,
-    std::shared_ptr<rocksdb::ReadFileFilter> file_filter) {
+    std::shared_ptr<rocksdb::ReadFileFilter> file_filter,
+    ReadAccessPattern access_pattern) {
   rocksdb::ReadOptions read_opts = PrepareReadOptions(rocksdb, bloom_filter_mode,
-      user_key_for_filter, query_id, std::move(file_filter));
+      user_key_for_filter, query_id, std::move(file_filter), access_pattern);
   return std::make_unique<IntentAwareIterator>(
       rocksdb, read_opts, read_time, txn_op_context);
 }
 
+namespace {
+
+// Internal keys visited by the iterators of the current thread: the key each Seek/Next/Prev lands
+// on plus the hidden and deleted keys skipped on the way there.
+uint64_t KeysVisited(const rocksdb::PerfContext& perf) {
+  return perf.iter_seek_count + perf.iter_next_count + perf.iter_prev_count +
+         perf.internal_key_skipped_count + perf.internal_delete_skipped_count;
+}
+
+} // namespace
+
+ScopedTraceRocksDBCost::ScopedTraceRocksDBCost() : trace_(Trace::CurrentTrace()) {
+  if (trace_ != nullptr) {
+    const auto& perf = rocksdb::perf_context;
+    keys_scanned_ = KeysVisited(perf);
+    blocks_read_ = perf.block_read_count;
+    block_cache_hits_ = perf.block_cache_hit_count;
+    bytes_read_ = perf.block_read_byte;
+  }
+}
+
+ScopedTraceRocksDBCost::~ScopedTraceRocksDBCost() {
+  if (trace_ != nullptr) {
+    const auto& perf = rocksdb::perf_context;
+    trace_->AddCost(TraceCost::kKeysScanned, KeysVisited(perf) - keys_scanned_);
+    trace_->AddCost(TraceCost::kBlocksRead, perf.block_read_count - blocks_read_);
+    trace_->AddCost(TraceCost::kBlockCacheHits, perf.block_cache_hit_count - block_cache_hits_);
+    trace_->AddCost(TraceCost::kBytesRead, perf.block_read_byte - bytes_read_);
+  }
+}
+
 void InitRocksDBOptions(
     rocksdb::Options* options, const string& tablet_id,
     const shared_ptr<rocksdb::Statistics>& statistics,
@@ -334,6 +410,8 @@ void InitRocksDBOptions(
   options->initial_seqno = FLAGS_initial_seqno;
   options->boundary_extractor = DocBoundaryValuesExtractorInstance();
   options->memory_monitor = tablet_options.memory_monitor;
+  options->use_direct_io_for_flush_and_compaction =
+      FLAGS_rocksdb_use_direct_io_for_flush_and_compaction;
   if (FLAGS_db_write_buffer_size != -1) {
     options->write_buffer_size = FLAGS_db_write_buffer_size;
   }
@@ -351,6 +429,8 @@ void InitRocksDBOptions(
     table_options.no_block_cache = true;
     table_options.cache_index_and_filter_blocks = false;
   }
+  table_options.block_cache_compressed = tablet_options.block_cache_compressed;
+  table_options.persistent_cache = tablet_options.persistent_cache;
   table_options.block_size = FLAGS_db_block_size_bytes;
 
   // Set our custom bloom filter that is docdb aware.
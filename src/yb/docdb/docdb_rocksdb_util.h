@@ -31,6 +31,9 @@
 #include "yb/util/slice.h"
 
 namespace yb {
+
+class Trace;
+
 namespace docdb {
 
 class IntentAwareIterator;
@@ -60,14 +63,41 @@ void SeekForward(const KeyBytes& key_bytes, rocksdb::Iterator *iter);
 // enough, does not perform a seek.
 void SeekPastSubKey(const SubDocKey& sub_doc_key, rocksdb::Iterator* iter);
 
+// Same as above, but takes an encoded subdoc key without hybrid time.
+void SeekPastSubKey(const Slice& key_without_ht, rocksdb::Iterator* iter);
+
 // A wrapper around the RocksDB seek operation that uses Next() up to the configured number of
 // times to avoid invalidating iterator state. In debug mode it also allows printing detailed
 // information about RocksDB seeks.
+//
+// If max_nexts is specified, it is used instead of --max_nexts_to_avoid_seek and is adjusted the
+// way AdaptiveForwardSeeker describes.
 void PerformRocksDBSeek(
     rocksdb::Iterator *iter,
     const rocksdb::Slice &seek_key,
     const char* file_name,
-    int line);
+    int line,
+    int* max_nexts = nullptr);
+
+// Moves a RocksDB iterator forward to a seek key, choosing between Next() and Seek() based on how
+// many keys had to be skipped by the previous calls. Next() is cheaper while the keys to skip are
+// few, e.g. an older version or two of a column, but stepping over every version of a key updated
+// many times since the last compaction is much slower than a single Seek(). So the number of
+// Next() calls tried before seeking starts at --max_nexts_to_avoid_seek, is halved each time it
+// was not enough, and grows back by one each time it was.
+//
+// This class is not thread-safe.
+class AdaptiveForwardSeeker {
+ public:
+  AdaptiveForwardSeeker();
+
+  // Positions the iterator at the first key >= seek_key. Does nothing if the iterator is already
+  // there or past it.
+  void SeekForward(const rocksdb::Slice& seek_key, rocksdb::Iterator* iter);
+
+ private:
+  int max_nexts_;
+};
 
 // Positions the iterator at the largest key k <= seek_key
 void PerformRocksDBReverseSeek(
@@ -93,6 +123,16 @@ enum class BloomFilterMode {
   DONT_USE_BLOOM_FILTER,
 };
 
+// How an iterator is going to read the data.
+enum class ReadAccessPattern {
+  // Point reads and short scans. Blocks read are added to the block cache.
+  kPointRead,
+  // Long scans over many keys, e.g. full table scans. Data blocks are read ahead once the scan
+  // reads them sequentially (--docdb_scan_readahead_size_bytes), and are not added to the block
+  // cache unless --docdb_scan_fill_block_cache is set.
+  kScan,
+};
+
 // It is only allowed to use bloom filters on scans within the same hashed components of the key,
 // because BloomFilterAwareIterator relies on it and ignores SST file completely if there are no
 // keys with the same hashed components as key specified for seek operation.
@@ -104,7 +144,8 @@ std::unique_ptr<rocksdb::Iterator> CreateRocksDBIterator(
     BloomFilterMode bloom_filter_mode,
     const boost::optional<const Slice>& user_key_for_filter,
     const rocksdb::QueryId query_id,
-    std::shared_ptr<rocksdb::ReadFileFilter> file_filter = nullptr);
+    std::shared_ptr<rocksdb::ReadFileFilter> file_filter = nullptr,
+    ReadAccessPattern access_pattern = ReadAccessPattern::kPointRead);
 
 // Values and transactions committed later than high_ht can be skipped, so we won't spend time
 // for re-requesting pending transaction status if we already know it wasn't committed at high_ht.
@@ -115,7 +156,26 @@ std::unique_ptr<IntentAwareIterator> CreateIntentAwareIterator(
     const rocksdb::QueryId query_id,
     const TransactionOperationContextOpt& transaction_context,
     const ReadHybridTime& read_time,
-    std::shared_ptr<rocksdb::ReadFileFilter> file_filter = nullptr);
+    std::shared_ptr<rocksdb::ReadFileFilter> file_filter = nullptr,
+    ReadAccessPattern access_pattern = ReadAccessPattern::kPointRead);
+
+// Adds the RocksDB work done by the current thread while this object is alive (keys scanned and
+// SST blocks read or found in the block cache) to the costs of the current trace. Does nothing if
+// there is no current trace.
+class ScopedTraceRocksDBCost {
+ public:
+  ScopedTraceRocksDBCost();
+  ~ScopedTraceRocksDBCost();
+
+ private:
+  Trace* trace_;
+  uint64_t keys_scanned_ = 0;
+  uint64_t blocks_read_ = 0;
+  uint64_t block_cache_hits_ = 0;
+  uint64_t bytes_read_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(ScopedTraceRocksDBCost);
+};
 
 // Initialize the RocksDB 'options' object for tablet identified by 'tablet_id'. The 'statistics'
 // object provided by the caller will be used by RocksDB to maintain the stats for the tablet
@@ -161,6 +161,14 @@ class DocDBRocksDBUtil {
     return ReopenRocksDB();
   }
 
+  // Lets compactions drop SST files whose values have expired at the history cutoff, like tables
+  // created with drop_expired_files.
+  CHECKED_STATUS EnableDropExpiredFiles() {
+    rocksdb_options_.compaction_file_filter_factory =
+        std::make_shared<DocDBCompactionFileFilterFactory>(retention_policy_);
+    return ReopenRocksDB();
+  }
+
   CHECKED_STATUS ReinitDBOptions();
 
   std::atomic<int64_t>& monotonic_counter() {
@@ -46,10 +46,6 @@ KeyBytes GetIntentPrefixForKeyWithoutHt(const Slice& key) {
   return intent_key_bytes;
 }
 
-KeyBytes GetIntentPrefixForKey(const SubDocKey& subdoc_key) {
-  return GetIntentPrefixForKeyWithoutHt(subdoc_key.Encode(false /* include_hybrid_time */));
-}
-
 } // namespace
 
 // For locally committed transactions returns commit time if committed at specified time or
@@ -207,7 +203,8 @@ IntentAwareIterator::IntentAwareIterator(
     const rocksdb::ReadOptions& read_opts,
     const ReadHybridTime& read_time,
     const TransactionOperationContextOpt& txn_op_context)
-    : read_time_(read_time),
+    : rocksdb_(rocksdb),
+      read_time_(read_time),
       txn_op_context_(txn_op_context),
       transaction_status_cache_(
           txn_op_context ? &txn_op_context->txn_status_manager : nullptr, read_time) {
@@ -222,6 +219,10 @@ IntentAwareIterator::IntentAwareIterator(
   iter_.reset(rocksdb->NewIterator(read_opts));
 }
 
+void IntentAwareIterator::UseRangeTombstones() {
+  use_range_tombstones_ = true;
+}
+
 void IntentAwareIterator::Seek(const DocKey &doc_key) {
   SeekWithoutHt(doc_key.Encode());
 }
@@ -267,31 +268,53 @@ void IntentAwareIterator::SeekForwardIgnoreHt(const SubDocKey& subdoc_key) {
 
 void IntentAwareIterator::SeekPastSubKey(const SubDocKey& subdoc_key) {
   VLOG(4) << "SeekPastSubKey(" << subdoc_key.ToString() << ")";
+  SeekPastSubKeyWithoutHt(subdoc_key.Encode(false /* include_hybrid_time */));
+}
+
+void IntentAwareIterator::SeekPastSubKeyWithoutHt(const Slice& key) {
+  VLOG(4) << "SeekPastSubKeyWithoutHt(" << SubDocKey::DebugSliceToString(key) << ")";
   if (!status_.ok()) {
     return;
   }
 
-  docdb::SeekPastSubKey(subdoc_key, iter_.get());
-  SkipFutureRecords();
-  if (intent_iter_ && status_.ok()) {
-    KeyBytes intent_prefix = GetIntentPrefixForKey(subdoc_key);
+  // The key could point into one of our sub-iterators, so build all seek keys before seeking.
+  KeyBytes intent_prefix;
+  if (intent_iter_) {
+    intent_prefix = GetIntentPrefixForKeyWithoutHt(key);
     // Skip all intents for subdoc_key.
     intent_prefix.mutable_data()->push_back(static_cast<char>(ValueType::kIntentType) + 1);
+  }
+  KeyBytes seek_key(key);
+  AppendDocHybridTime(DocHybridTime::kMin, &seek_key);
+  seeker_.SeekForward(seek_key.AsSlice(), iter_.get());
+  SkipFutureRecords();
+  if (intent_iter_ && status_.ok()) {
     SeekForwardToSuitableIntent(intent_prefix);
   }
 }
 
 void IntentAwareIterator::SeekOutOfSubDoc(const SubDocKey& subdoc_key) {
   VLOG(4) << "SeekOutOfSubDoc(" << subdoc_key.ToString() << ")";
+  SeekOutOfSubDocWithoutHt(subdoc_key.Encode(false /* include_hybrid_time */));
+}
+
+void IntentAwareIterator::SeekOutOfSubDocWithoutHt(const Slice& key) {
+  VLOG(4) << "SeekOutOfSubDocWithoutHt(" << SubDocKey::DebugSliceToString(key) << ")";
   if (!status_.ok()) {
     return;
   }
 
-  SeekForwardRegular(subdoc_key.AdvanceOutOfSubDoc());
-  if (intent_iter_ && status_.ok()) {
-    KeyBytes intent_prefix = GetIntentPrefixForKey(subdoc_key);
-    // See comment for SubDocKey::AdvanceOutOfSubDoc.
+  // The key could point into one of our sub-iterators, so build all seek keys before seeking.
+  // See comment for SubDocKey::AdvanceOutOfSubDoc.
+  KeyBytes seek_key(key);
+  seek_key.AppendValueType(ValueType::kMaxByte);
+  KeyBytes intent_prefix;
+  if (intent_iter_) {
+    intent_prefix = GetIntentPrefixForKeyWithoutHt(key);
     intent_prefix.AppendValueType(ValueType::kMaxByte);
+  }
+  SeekForwardRegular(seek_key);
+  if (intent_iter_ && status_.ok()) {
     SeekForwardToSuitableIntent(intent_prefix);
   }
 }
@@ -308,13 +331,17 @@ void IntentAwareIterator::SeekToLastDocKey() {
     return;
   }
   // Seek to the first rocksdb kv-pair for this row.
-  rocksdb::Slice rocksdb_key(iter_->key());
-  DocKey doc_key;
-  status_ = doc_key.DecodeFrom(&rocksdb_key);
-  if (!status_.ok()) {
+  SeekToDocKeyOf(iter_->key());
+}
+
+void IntentAwareIterator::SeekToDocKeyOf(const Slice& key) {
+  auto doc_key_size = DocKey::EncodedSize(key, DocKeyPart::WHOLE_DOC_KEY);
+  if (!doc_key_size.ok()) {
+    status_ = doc_key_size.status();
     return;
   }
-  KeyBytes encoded_doc_key = doc_key.Encode();
+  // The key is owned by the iterator, so copy the encoded document key before seeking.
+  KeyBytes encoded_doc_key(Slice(key.data(), *doc_key_size));
   SeekWithoutHt(encoded_doc_key);
 }
 
@@ -332,13 +359,7 @@ void IntentAwareIterator::PrevDocKey(const DocKey& doc_key) {
     iter_valid_ = false; // TODO(dtxn) support reverse scan with read restart
     return;
   }
-  Slice key_slice = iter_->key();
-  DocKey prev_key;
-  status_ = prev_key.DecodeFrom(&key_slice);
-  if (!status_.ok()) {
-    return;
-  }
-  Seek(prev_key);
+  SeekToDocKeyOf(iter_->key());
 }
 
 bool IntentAwareIterator::valid() {
@@ -383,7 +404,7 @@ Slice IntentAwareIterator::value() {
 }
 
 void IntentAwareIterator::SeekForwardRegular(const Slice& slice, const Slice& prefix) {
-  docdb::SeekForward(slice, iter_.get());
+  seeker_.SeekForward(slice, iter_.get());
   SkipFutureRecords();
 }
 
@@ -406,6 +427,20 @@ void IntentAwareIterator::ProcessIntent() {
   if (decode_result->value_time > real_time &&
       (decode_result->same_transaction ||
            decode_result->value_time.hybrid_time() <= read_time_.global_limit)) {
+    if (use_range_tombstones_) {
+      auto key_without_ht = decode_result->intent_prefix;
+      key_without_ht.consume_byte();
+      const auto delete_time = RangeDeleteTime(key_without_ht);
+      if (!status_.ok()) {
+        return;
+      }
+      if (decode_result->value_time < delete_time) {
+        // Same as for regular records, the intent is hidden by a range tombstone that could be in
+        // the future of the read time.
+        max_seen_ht_.MakeAtLeast(delete_time.hybrid_time());
+        return;
+      }
+    }
     if (resolved_intent_state_ == ResolvedIntentState::kNoIntent) {
       resolved_intent_key_prefix_.Reset(decode_result->intent_prefix);
       auto prefix = prefix_stack_.empty() ? Slice() : prefix_stack_.back();
@@ -606,6 +641,7 @@ void IntentAwareIterator::SkipFutureRecords() {
     }
     auto value = iter_->value();
     auto value_type = static_cast<ValueType>(value[0]);
+    bool visible;
     if (value_type == ValueType::kHybridTime) {
       // Value came from a transaction, we could try to filter it by original intent time.
       DocHybridTime intent_doc_ht;
@@ -615,21 +651,128 @@ void IntentAwareIterator::SkipFutureRecords() {
         status_ = std::move(decode_status);
         return;
       }
-      if (intent_doc_ht.hybrid_time() <= read_time_.local_limit &&
-          doc_ht.hybrid_time() <= read_time_.global_limit) {
+      visible = intent_doc_ht.hybrid_time() <= read_time_.local_limit &&
+                doc_ht.hybrid_time() <= read_time_.global_limit;
+    } else {
+      visible = doc_ht.hybrid_time() <= read_time_.local_limit;
+    }
+    if (visible) {
+      if (!use_range_tombstones_) {
         iter_valid_ = true;
         return;
       }
-    } else if (doc_ht.hybrid_time() <= read_time_.local_limit) {
-      iter_valid_ = true;
-      return;
+      int encoded_ht_size = 0;
+      decode_status = DocHybridTime::CheckAndGetEncodedSize(iter_->key(), &encoded_ht_size);
+      if (!decode_status.ok()) {
+        status_ = std::move(decode_status);
+        return;
+      }
+      // Strip the hybrid time and the value type preceding it.
+      const Slice key_without_ht(iter_->key().data(), iter_->key().size() - encoded_ht_size - 1);
+      const auto delete_time = RangeDeleteTime(key_without_ht);
+      if (!status_.ok()) {
+        return;
+      }
+      if (doc_ht >= delete_time) {
+        iter_valid_ = true;
+        return;
+      }
+      // This version and all earlier versions of the key are deleted by a range tombstone, so
+      // skip them all at once. Reading past the tombstone requires a read restart if it is in the
+      // future of the read time.
+      VLOG(4) << "Skipping because of range tombstone at " << delete_time << ": "
+              << iter_->key().ToDebugHexString();
+      max_seen_ht_.MakeAtLeast(delete_time.hybrid_time());
+      KeyBytes seek_key(key_without_ht);
+      AppendDocHybridTime(DocHybridTime::kMin, &seek_key);
+      seeker_.SeekForward(seek_key.AsSlice(), iter_.get());
+      continue;
     }
     VLOG(4) << "Skipping because of time: " << iter_->key().ToDebugHexString();
-    iter_->Next(); // TODO(dtxn) use seek with the same key, but read limit as doc hybrid time.
+    if (doc_ht.hybrid_time() > read_time_.global_limit) {
+      // None of the versions of this key written after the global limit are visible, so skip
+      // them all at once. A frequently updated key could have many of them.
+      KeyBytes seek_key(iter_->key());
+      auto replace_status = seek_key.ReplaceLastHybridTimeForSeek(read_time_.global_limit);
+      if (!replace_status.ok()) {
+        status_ = std::move(replace_status);
+        return;
+      }
+      seeker_.SeekForward(seek_key.AsSlice(), iter_.get());
+    } else {
+      iter_->Next();
+    }
   }
   iter_valid_ = false;
 }
 
+DocHybridTime IntentAwareIterator::RangeDeleteTime(const Slice& key_without_ht) {
+  if (range_tombstones_.partition().empty() ||
+      !key_without_ht.starts_with(range_tombstones_.partition())) {
+    auto partition_size = RangeTombstonePartitionSize(key_without_ht);
+    if (!partition_size.ok()) {
+      status_ = partition_size.status();
+      return DocHybridTime::kMin;
+    }
+    if (*partition_size == 0) {
+      // Keys without hashed components cannot be covered by range tombstones.
+      return DocHybridTime::kMin;
+    }
+    LoadRangeTombstones(Slice(key_without_ht.data(), *partition_size));
+    if (!status_.ok()) {
+      return DocHybridTime::kMin;
+    }
+  }
+  return range_tombstones_.DeleteTime(key_without_ht);
+}
+
+void IntentAwareIterator::LoadRangeTombstones(const Slice& partition) {
+  range_tombstone_iter_.reset();
+  range_tombstones_.Reset(partition);
+  // The bloom filter is built from the hashed part of the doc keys, which is the partition. The
+  // iterator keeps a reference to the filter key, owned by range_tombstones_ until the next reset.
+  range_tombstone_iter_ = docdb::CreateRocksDBIterator(
+      rocksdb_, docdb::BloomFilterMode::USE_BLOOM_FILTER, Slice(range_tombstones_.partition()),
+      rocksdb::kDefaultQueryId);
+  // Range tombstones are stored in the document with the hashed part of the key and no range
+  // components.
+  KeyBytes prefix(partition);
+  prefix.AppendValueType(ValueType::kGroupEnd);
+  prefix.AppendValueType(ValueType::kRangeTombstone);
+  ROCKSDB_SEEK(range_tombstone_iter_.get(), prefix.AsSlice());
+  for (; range_tombstone_iter_->Valid() &&
+             range_tombstone_iter_->key().starts_with(prefix.AsSlice());
+       range_tombstone_iter_->Next()) {
+    SubDocKeyView key;
+    auto decode_status = key.Decode(range_tombstone_iter_->key());
+    if (!decode_status.ok()) {
+      status_ = std::move(decode_status);
+      return;
+    }
+    RangeTombstone tombstone;
+    auto is_tombstone = DecodeRangeTombstone(key, &tombstone);
+    if (!is_tombstone.ok()) {
+      status_ = is_tombstone.status();
+      return;
+    }
+    if (!*is_tombstone || tombstone.doc_ht.hybrid_time() > read_time_.local_limit) {
+      continue;
+    }
+    ValueType value_type;
+    decode_status = Value::DecodePrimitiveValueType(range_tombstone_iter_->value(), &value_type);
+    if (!decode_status.ok()) {
+      status_ = std::move(decode_status);
+      return;
+    }
+    // Versions of a range tombstone are ordered newest first, the first one at or before the read
+    // time is visible.
+    if (value_type == ValueType::kTombstone) {
+      VLOG(4) << "Range tombstone: " << tombstone.ToString();
+      range_tombstones_.Add(std::move(tombstone));
+    }
+  }
+}
+
 void IntentAwareIterator::SkipFutureIntents() {
   if (!intent_iter_ || !status_.ok()) {
     return;
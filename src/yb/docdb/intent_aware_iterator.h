@@ -19,7 +19,9 @@
 #include "yb/common/read_hybrid_time.h"
 
 #include "yb/docdb/doc_key.h"
+#include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/key_bytes.h"
+#include "yb/docdb/range_tombstone.h"
 
 #include "yb/rocksdb/db.h"
 #include "yb/rocksdb/options.h"
@@ -83,6 +85,10 @@ class IntentAwareIterator {
   IntentAwareIterator(const IntentAwareIterator& other) = delete;
   void operator=(const IntentAwareIterator& other) = delete;
 
+  // Hides entries deleted by range tombstones, see range_tombstone.h. Should be called before the
+  // first seek, for tables that use range tombstones.
+  void UseRangeTombstones();
+
   // Seek to the smallest key which is greater or equal than doc_key.
   void Seek(const DocKey& doc_key);
 
@@ -100,9 +106,15 @@ class IntentAwareIterator {
   // Seek past specified subdoc key.
   void SeekPastSubKey(const SubDocKey& subdoc_key);
 
+  // Same as above, but takes an encoded subdoc key without hybrid time.
+  void SeekPastSubKeyWithoutHt(const Slice& key);
+
   // Seek out of subdoc key.
   void SeekOutOfSubDoc(const SubDocKey& subdoc_key);
 
+  // Same as above, but takes an encoded subdoc key without hybrid time.
+  void SeekOutOfSubDocWithoutHt(const Slice& key);
+
   // Seek to last doc key.
   void SeekToLastDocKey();
 
@@ -141,6 +153,9 @@ class IntentAwareIterator {
       Value* result_value);
 
  private:
+  // Seek to the beginning of the document the given encoded key belongs to.
+  void SeekToDocKeyOf(const Slice& key);
+
   // Seek forward on regular sub-iterator.
   void SeekForwardRegular(const Slice& slice, const Slice& prefix = Slice());
 
@@ -150,6 +165,13 @@ class IntentAwareIterator {
   // Skips intents with hybrid time after read limit.
   void SkipFutureIntents();
 
+  // Returns the hybrid time of the latest range tombstone visible at the read time that covers the
+  // given key without hybrid time, or DocHybridTime::kMin if there is none.
+  DocHybridTime RangeDeleteTime(const Slice& key_without_ht);
+
+  // Reads the range tombstones visible at the read time of the partition with the given key prefix.
+  void LoadRangeTombstones(const Slice& partition);
+
   // Strong write intents which are either committed or written by the current
   // transaction (stored in txn_op_context) by considered time are considered as suitable.
 
@@ -187,10 +209,13 @@ class IntentAwareIterator {
   // Whether current entry is regular key-value pair.
   bool IsEntryRegular();
 
+  rocksdb::DB* const rocksdb_;
   const ReadHybridTime read_time_;
   const TransactionOperationContextOpt txn_op_context_;
   std::unique_ptr<rocksdb::Iterator> intent_iter_;
   std::unique_ptr<rocksdb::Iterator> iter_;
+  // Used to move iter_ forward, skipping many versions of a key with a single seek.
+  AdaptiveForwardSeeker seeker_;
   bool iter_valid_ = false;
   Status status_;
   HybridTime max_seen_ht_ = HybridTime::kMin;
@@ -207,6 +232,14 @@ class IntentAwareIterator {
   KeyBytes resolved_intent_value_;
   std::vector<Slice> prefix_stack_;
   TransactionStatusCache transaction_status_cache_;
+
+  bool use_range_tombstones_ = false;
+  // Reads the range tombstones of the partition in range_tombstones_, without the file filter of
+  // iter_ since they could be in any file. Recreated for each partition, so that the bloom filter
+  // skips files without keys of the partition.
+  std::unique_ptr<rocksdb::Iterator> range_tombstone_iter_;
+  // The range tombstones of the partition the last checked key belongs to.
+  RangeTombstones range_tombstones_;
 };
 
 // Utility class that controls stack of prefixes in IntentAwareIterator.
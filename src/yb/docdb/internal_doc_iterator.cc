@@ -104,13 +104,14 @@ Status InternalDocIterator::SeekToKeyPrefix() {
 
   DOCDB_DEBUG_LOG("key_prefix=$0", BestEffortDocDBKeyToStr(key_prefix_));
   boost::optional<DocWriteBatchCache::Entry> cached_ht_and_type =
-      doc_write_batch_cache_->Get(KeyBytes(key_prefix_.AsStringRef()));
+      doc_write_batch_cache_->Get(key_prefix_.AsSlice());
   if (cached_ht_and_type) {
     subdoc_ht_ = cached_ht_and_type->doc_hybrid_time;
     subdoc_type_ = cached_ht_and_type->value_type;
     subdoc_user_timestamp_ = cached_ht_and_type->user_timestamp;
     found_exact_key_prefix_ = cached_ht_and_type->found_exact_key_prefix;
-    subdoc_exists_ = ToTrilean(subdoc_type_ != ValueType::kTombstone);
+    subdoc_exists_ = ToTrilean(subdoc_type_ != ValueType::kTombstone &&
+                               subdoc_type_ != ValueType::kInvalidValueType);
   } else {
     if (!iter_) {
       // If iter hasn't been created yet, do so now.
@@ -134,6 +135,8 @@ Status InternalDocIterator::SeekToKeyPrefix() {
       DOCDB_DEBUG_LOG("No more data found in RocksDB when trying to seek at prefix $0",
                       BestEffortDocDBKeyToStr(key_prefix_));
       subdoc_exists_ = Trilean::kFalse;
+      found_exact_key_prefix_ = false;
+      doc_write_batch_cache_->PutNotFound(key_prefix_.AsSlice());
     } else {
       const rocksdb::Slice& key = iter_->key();
       // If the first key >= key_prefix_ in RocksDB starts with key_prefix_, then a
@@ -175,7 +178,7 @@ Status InternalDocIterator::SeekToKeyPrefix() {
           // therefore we can't create "a.y.x", which would be incorrect.
           subdoc_exists_ = Trilean::kFalse;
         } else {
-          doc_write_batch_cache_->Put(key_prefix_, subdoc_ht_, subdoc_type_,
+          doc_write_batch_cache_->Put(key_prefix_.AsSlice(), subdoc_ht_, subdoc_type_,
                                       subdoc_user_timestamp_, found_exact_key_prefix_);
           if (subdoc_type_ != ValueType::kTombstone) {
             subdoc_exists_ = ToTrilean(true);
@@ -186,6 +189,10 @@ Status InternalDocIterator::SeekToKeyPrefix() {
                         BestEffortDocDBKeyToStr(KeyBytes(key.ToString())),
                         BestEffortDocDBKeyToStr(key_prefix_));
         subdoc_exists_ = Trilean::kFalse;
+        found_exact_key_prefix_ = false;
+        // The RocksDB contents do not change while the DocWriteBatch is built, so remember that
+        // there is nothing at this key prefix until an operation of the batch writes to it.
+        doc_write_batch_cache_->PutNotFound(key_prefix_.AsSlice());
       }
     }
 
@@ -0,0 +1,112 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/packed_row.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "yb/docdb/key_bytes.h"
+#include "yb/util/fast_varint.h"
+
+using std::string;
+
+namespace yb {
+namespace docdb {
+
+void PackedRow::AddColumn(PrimitiveValue subkey, PrimitiveValue value) {
+  if (sorted_ && !columns_.empty() && !(columns_.back().subkey < subkey)) {
+    sorted_ = false;
+  }
+  columns_.push_back(Column{std::move(subkey), std::move(value)});
+}
+
+void PackedRow::SortColumns() {
+  if (!sorted_) {
+    std::sort(columns_.begin(), columns_.end(), [](const Column& lhs, const Column& rhs) {
+      return lhs.subkey < rhs.subkey;
+    });
+    sorted_ = true;
+  }
+}
+
+const PrimitiveValue* PackedRow::GetColumn(const PrimitiveValue& subkey) const {
+  DCHECK(sorted_);
+  auto it = std::lower_bound(
+      columns_.begin(), columns_.end(), subkey,
+      [](const Column& column, const PrimitiveValue& key) { return column.subkey < key; });
+  if (it == columns_.end() || it->subkey != subkey) {
+    return nullptr;
+  }
+  return &it->value;
+}
+
+PrimitiveValue PackedRow::Encode() {
+  SortColumns();
+  KeyBytes encoded;
+  uint8_t size_buf[util::kMaxVarIntBufferSize];
+  for (const auto& column : columns_) {
+    column.subkey.AppendToKey(&encoded);
+    const string value = column.value.ToValue();
+    size_t size_len = 0;
+    util::FastEncodeUnsignedVarInt(value.size(), size_buf, &size_len);
+    encoded.AppendRawBytes(Slice(size_buf, size_len));
+    encoded.AppendRawBytes(value);
+  }
+  return PrimitiveValue(encoded.data());
+}
+
+Status PackedRow::DecodeFrom(const Slice& encoded) {
+  columns_.clear();
+  sorted_ = true;
+  Slice slice = encoded;
+  while (!slice.empty()) {
+    Column column;
+    RETURN_NOT_OK_PREPEND(column.subkey.DecodeFromKey(&slice), "Bad packed row column");
+    uint64_t value_size = 0;
+    size_t size_len = 0;
+    RETURN_NOT_OK(util::FastDecodeUnsignedVarInt(
+        slice.data(), slice.size(), &value_size, &size_len));
+    slice.remove_prefix(size_len);
+    if (value_size > slice.size()) {
+      return STATUS_FORMAT(Corruption, "Packed row value of $0 bytes, but only $1 bytes left",
+                           value_size, slice.size());
+    }
+    RETURN_NOT_OK(column.value.DecodeFromValue(Slice(slice.data(), value_size)));
+    slice.remove_prefix(value_size);
+    if (!columns_.empty() && !(columns_.back().subkey < column.subkey)) {
+      return STATUS_FORMAT(Corruption, "Packed row columns out of order: $0 after $1",
+                           column.subkey, columns_.back().subkey);
+    }
+    columns_.push_back(std::move(column));
+  }
+  return Status::OK();
+}
+
+string PackedRow::ToString() const {
+  std::stringstream ss;
+  ss << "{";
+  bool first = true;
+  for (const auto& column : columns_) {
+    if (!first) {
+      ss << ", ";
+    }
+    first = false;
+    ss << column.subkey.ToString() << ": " << column.value.ToString();
+  }
+  ss << "}";
+  return ss.str();
+}
+
+}  // namespace docdb
+}  // namespace yb
@@ -0,0 +1,79 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_DOCDB_PACKED_ROW_H_
+#define YB_DOCDB_PACKED_ROW_H_
+
+#include <string>
+#include <vector>
+
+#include "yb/docdb/primitive_value.h"
+#include "yb/util/slice.h"
+#include "yb/util/status.h"
+
+namespace yb {
+namespace docdb {
+
+// The values of all scalar columns of a QL row written by a single INSERT, stored as one RocksDB
+// value at SubDocKey(doc_key, [kPackedRow]) instead of one RocksDB value per column. The packed row
+// is encoded as a string primitive value holding a sequence of
+//
+//   <column subkey in key encoding> <value size as unsigned varint> <value in value encoding>
+//
+// sorted by column subkey. The TTL of the INSERT is stored in the enclosing Value and applies to
+// all columns. A column written at a later hybrid time at its own SubDocKey takes precedence over
+// its value in the packed row.
+//
+// This class is not thread-safe.
+class PackedRow {
+ public:
+  struct Column {
+    PrimitiveValue subkey;
+    PrimitiveValue value;
+  };
+
+  // Adds a column. Columns may be added in any order, but each column at most once.
+  void AddColumn(PrimitiveValue subkey, PrimitiveValue value);
+
+  // Returns the value of the given column, or nullptr if the packed row does not contain it.
+  const PrimitiveValue* GetColumn(const PrimitiveValue& subkey) const;
+
+  const std::vector<Column>& columns() const { return columns_; }
+
+  bool empty() const { return columns_.empty(); }
+
+  void Clear() {
+    columns_.clear();
+    sorted_ = true;
+  }
+
+  // Encodes the packed row into a string primitive value to be stored at the kPackedRow subkey.
+  PrimitiveValue Encode();
+
+  // Replaces the columns of this packed row with those decoded from the payload of the string
+  // primitive value written by Encode().
+  CHECKED_STATUS DecodeFrom(const Slice& encoded);
+
+  std::string ToString() const;
+
+ private:
+  void SortColumns();
+
+  std::vector<Column> columns_;
+  bool sorted_ = true;
+};
+
+}  // namespace docdb
+}  // namespace yb
+
+#endif  // YB_DOCDB_PACKED_ROW_H_
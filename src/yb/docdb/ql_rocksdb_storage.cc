@@ -81,7 +81,8 @@ CHECKED_STATUS QLRocksDBStorage::BuildQLScanSpec(const QLReadRequestPB& request,
   spec->reset(new DocQLScanSpec(schema, hash_code, max_hash_code, hashed_components,
       request.has_where_expr() ? &request.where_expr().condition() : nullptr,
       request.query_id(), request.is_forward_scan(), include_static_columns,
-      start_sub_doc_key.doc_key()));
+      start_sub_doc_key.doc_key(),
+      request.has_limit() ? request.limit() : std::numeric_limits<size_t>::max()));
   return Status::OK();
 }
 
@@ -0,0 +1,275 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/range_tombstone.h"
+
+#include "yb/common/ql_value.h"
+#include "yb/docdb/key_bytes.h"
+#include "yb/docdb/primitive_value.h"
+#include "yb/gutil/macros.h"
+#include "yb/util/format.h"
+
+using std::string;
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+// The conditions on one range column that a range tombstone can be built from.
+struct ColumnBounds {
+  const QLValuePB* equal = nullptr;
+  const QLValuePB* lower = nullptr;
+  bool lower_inclusive = false;
+  const QLValuePB* upper = nullptr;
+  bool upper_inclusive = false;
+
+  bool empty() const {
+    return equal == nullptr && lower == nullptr && upper == nullptr;
+  }
+};
+
+// Swaps the direction of a comparison, e.g. for "<value> < <column>".
+QLOperator ReverseComparison(QLOperator op) {
+  switch (op) {
+    case QL_OP_LESS_THAN: return QL_OP_GREATER_THAN;
+    case QL_OP_LESS_THAN_EQUAL: return QL_OP_GREATER_THAN_EQUAL;
+    case QL_OP_GREATER_THAN: return QL_OP_LESS_THAN;
+    case QL_OP_GREATER_THAN_EQUAL: return QL_OP_LESS_THAN_EQUAL;
+    default: return op;
+  }
+}
+
+bool SetBound(const QLValuePB& value, bool inclusive, const QLValuePB** bound,
+              bool* bound_inclusive) {
+  if (*bound != nullptr || IsNull(value)) {
+    return false;
+  }
+  *bound = &value;
+  *bound_inclusive = inclusive;
+  return true;
+}
+
+// Adds the bounds imposed by the given condition to column_bounds, which is indexed by the range
+// column index. Returns false if the condition cannot be part of a range tombstone.
+bool AddConditionBounds(const Schema& schema,
+                        const QLConditionPB& condition,
+                        std::vector<ColumnBounds>* column_bounds) {
+  const auto& operands = condition.operands();
+  if (condition.op() == QL_OP_AND) {
+    for (const auto& operand : operands) {
+      if (operand.expr_case() != QLExpressionPB::ExprCase::kCondition ||
+          !AddConditionBounds(schema, operand.condition(), column_bounds)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  if (operands.size() < 2) {
+    return false;
+  }
+  QLOperator op = condition.op();
+  const QLExpressionPB* column_expr = &operands.Get(0);
+  const QLExpressionPB* value_expr = &operands.Get(1);
+  if (op != QL_OP_BETWEEN && column_expr->expr_case() == QLExpressionPB::ExprCase::kValue) {
+    std::swap(column_expr, value_expr);
+    op = ReverseComparison(op);
+  }
+  if (column_expr->expr_case() != QLExpressionPB::ExprCase::kColumnId ||
+      value_expr->expr_case() != QLExpressionPB::ExprCase::kValue) {
+    return false;
+  }
+  const int found_idx = schema.find_column_by_id(ColumnId(column_expr->column_id()));
+  if (found_idx < 0) {
+    return false;
+  }
+  const size_t column_idx = found_idx;
+  if (!schema.is_key_column(column_idx)) {
+    return false;
+  }
+  if (schema.is_hash_key_column(column_idx)) {
+    // The hash columns are already fixed by the partition of the range tombstone.
+    return op == QL_OP_EQUAL && operands.size() == 2;
+  }
+
+  auto& bounds = (*column_bounds)[column_idx - schema.num_hash_key_columns()];
+  const QLValuePB& value = value_expr->value();
+  switch (op) {
+    case QL_OP_EQUAL:
+      if (!bounds.empty() || IsNull(value)) {
+        return false;
+      }
+      bounds.equal = &value;
+      return operands.size() == 2;
+    case QL_OP_LESS_THAN: FALLTHROUGH_INTENDED;
+    case QL_OP_LESS_THAN_EQUAL:
+      return operands.size() == 2 &&
+             SetBound(value, op == QL_OP_LESS_THAN_EQUAL, &bounds.upper, &bounds.upper_inclusive);
+    case QL_OP_GREATER_THAN: FALLTHROUGH_INTENDED;
+    case QL_OP_GREATER_THAN_EQUAL:
+      return operands.size() == 2 &&
+             SetBound(value, op == QL_OP_GREATER_THAN_EQUAL, &bounds.lower,
+                      &bounds.lower_inclusive);
+    case QL_OP_BETWEEN:
+      return operands.size() == 3 &&
+             operands.Get(2).expr_case() == QLExpressionPB::ExprCase::kValue &&
+             SetBound(value, true /* inclusive */, &bounds.lower, &bounds.lower_inclusive) &&
+             SetBound(operands.Get(2).value(), true /* inclusive */, &bounds.upper,
+                      &bounds.upper_inclusive);
+    default:
+      return false;
+  }
+}
+
+// Appends the encoded bound on the key suffix for a value of a range column. A lower bound
+// excluding the value, or an upper bound including it, has to be above all keys with that value.
+void AppendBound(const ColumnSchema& column, const QLValuePB& value, bool above_value,
+                 string* bound) {
+  KeyBytes encoded;
+  PrimitiveValue::FromQLValuePB(value, column.sorting_type()).AppendToKey(&encoded);
+  if (above_value) {
+    encoded.AppendValueType(ValueType::kMaxByte);
+  }
+  bound->append(encoded.data());
+}
+
+}  // namespace
+
+string RangeTombstone::ToString() const {
+  return Format("{ lower: $0 upper: $1 doc_ht: $2 }",
+                Slice(lower).ToDebugHexString(), Slice(upper).ToDebugHexString(), doc_ht);
+}
+
+Result<bool> GetRangeTombstoneBounds(const Schema& schema,
+                                     const QLConditionPB* condition,
+                                     string* lower,
+                                     string* upper) {
+  std::vector<ColumnBounds> column_bounds(schema.num_range_key_columns());
+  if (condition != nullptr && !AddConditionBounds(schema, *condition, &column_bounds)) {
+    return false;
+  }
+
+  // Equalities on a prefix of the range columns make up the common prefix of both bounds.
+  string prefix;
+  size_t idx = 0;
+  while (idx < column_bounds.size() && column_bounds[idx].equal != nullptr) {
+    const auto& bounds = column_bounds[idx];
+    if (bounds.lower != nullptr || bounds.upper != nullptr) {
+      return false;
+    }
+    AppendBound(schema.column(schema.num_hash_key_columns() + idx), *bounds.equal,
+                false /* above_value */, &prefix);
+    ++idx;
+  }
+
+  *lower = prefix;
+  *upper = prefix;
+  bool has_lower = false;
+  bool has_upper = false;
+  if (idx < column_bounds.size()) {
+    const auto& bounds = column_bounds[idx];
+    const auto& column = schema.column(schema.num_hash_key_columns() + idx);
+    // Keys of a descending column are ordered in the reverse order of its values.
+    const bool descending = column.sorting_type() == ColumnSchema::SortingType::kDescending;
+    if (bounds.lower != nullptr) {
+      if (descending) {
+        AppendBound(column, *bounds.lower, bounds.lower_inclusive, upper);
+        has_upper = true;
+      } else {
+        AppendBound(column, *bounds.lower, !bounds.lower_inclusive, lower);
+        has_lower = true;
+      }
+    }
+    if (bounds.upper != nullptr) {
+      if (descending) {
+        AppendBound(column, *bounds.upper, !bounds.upper_inclusive, lower);
+        has_lower = true;
+      } else {
+        AppendBound(column, *bounds.upper, bounds.upper_inclusive, upper);
+        has_upper = true;
+      }
+    }
+    for (++idx; idx < column_bounds.size(); ++idx) {
+      if (!column_bounds[idx].empty()) {
+        return false;
+      }
+    }
+  }
+
+  if (!has_lower && lower->empty()) {
+    lower->push_back(static_cast<char>(kMinPrimitiveValueType));
+  }
+  if (!has_upper) {
+    upper->push_back(static_cast<char>(ValueType::kMaxByte));
+  }
+  return true;
+}
+
+DocPath RangeTombstonePath(const DocKey& hashed_doc_key,
+                           const string& lower,
+                           const string& upper) {
+  DCHECK(hashed_doc_key.range_group().empty());
+  return DocPath(hashed_doc_key.Encode(), PrimitiveValue(ValueType::kRangeTombstone),
+                 PrimitiveValue(lower), PrimitiveValue(upper));
+}
+
+Result<size_t> RangeTombstonePartitionSize(const Slice& key) {
+  return DocKey::EncodedSize(key, DocKeyPart::HASHED_PART_ONLY);
+}
+
+Result<bool> DecodeRangeTombstone(const SubDocKeyView& key, RangeTombstone* tombstone) {
+  if (key.num_subkeys() != 3 || key.subkey_type(0) != ValueType::kRangeTombstone) {
+    return false;
+  }
+  PrimitiveValue lower;
+  PrimitiveValue upper;
+  RETURN_NOT_OK(key.DecodeSubkey(1, &lower));
+  RETURN_NOT_OK(key.DecodeSubkey(2, &upper));
+  if (lower.value_type() != ValueType::kString || upper.value_type() != ValueType::kString) {
+    return STATUS_FORMAT(Corruption, "Bad range tombstone bounds: $0", key);
+  }
+  tombstone->lower = lower.GetString();
+  tombstone->upper = upper.GetString();
+  tombstone->doc_ht = key.doc_hybrid_time();
+  return true;
+}
+
+void RangeTombstones::Reset(const Slice& partition) {
+  partition_.assign(partition.cdata(), partition.size());
+  tombstones_.clear();
+}
+
+void RangeTombstones::Add(RangeTombstone tombstone) {
+  if (!tombstones_.empty() && tombstones_.back().lower == tombstone.lower &&
+      tombstones_.back().upper == tombstone.upper) {
+    return;
+  }
+  tombstones_.push_back(std::move(tombstone));
+}
+
+DocHybridTime RangeTombstones::DeleteTime(const Slice& key_without_ht) const {
+  DCHECK(key_without_ht.starts_with(partition_));
+  const Slice key_suffix(key_without_ht.data() + partition_.size(),
+                         key_without_ht.size() - partition_.size());
+  DocHybridTime result = DocHybridTime::kMin;
+  for (const auto& tombstone : tombstones_) {
+    if (tombstone.doc_ht > result && tombstone.Covers(key_suffix)) {
+      result = tombstone.doc_ht;
+    }
+  }
+  return result;
+}
+
+}  // namespace docdb
+}  // namespace yb
@@ -0,0 +1,111 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_DOCDB_RANGE_TOMBSTONE_H_
+#define YB_DOCDB_RANGE_TOMBSTONE_H_
+
+#include <string>
+#include <vector>
+
+#include "yb/common/doc_hybrid_time.h"
+#include "yb/common/ql_protocol.pb.h"
+#include "yb/common/schema.h"
+#include "yb/docdb/doc_key.h"
+#include "yb/docdb/doc_path.h"
+#include "yb/util/result.h"
+#include "yb/util/slice.h"
+
+namespace yb {
+namespace docdb {
+
+// A deletion of all rows of a hash partition whose range columns fall within a range, written by
+// a single QL DELETE instead of one tombstone per row. It is stored as
+//
+//   SubDocKey(DocKey(hash, hashed_components, []), [kRangeTombstone, lower, upper]) -> kTombstone
+//
+// where lower and upper are string primitive values holding bounds on the key suffix, i.e. the
+// part of an encoded key without hybrid time that follows the hashed part of its document key.
+// An entry of the partition is deleted if its key suffix is within [lower, upper) and it was
+// written before the range tombstone. Key suffixes of the static row and of range tombstones start
+// with kGroupEnd, which sorts before lower, so they are never covered.
+struct RangeTombstone {
+  std::string lower;
+  std::string upper;
+  DocHybridTime doc_ht;
+
+  bool Covers(const Slice& key_suffix) const {
+    return key_suffix.compare(lower) >= 0 && key_suffix.compare(upper) < 0;
+  }
+
+  std::string ToString() const;
+};
+
+// Computes the bounds of the range tombstone that deletes the rows of a hash partition matching
+// the given WHERE condition (nullptr if there is none). Returns false if the condition cannot be
+// expressed as a single range of key suffixes. That is the case unless it is a conjunction of
+// equalities on a prefix of the range columns and optionally of lower and/or upper bounds on the
+// next range column, in addition to equalities on hash columns.
+Result<bool> GetRangeTombstoneBounds(const Schema& schema,
+                                     const QLConditionPB* condition,
+                                     std::string* lower,
+                                     std::string* upper);
+
+// Returns the path of the range tombstone with the given bounds in the hash partition of the given
+// document key, which must not have range components.
+DocPath RangeTombstonePath(const DocKey& hashed_doc_key,
+                           const std::string& lower,
+                           const std::string& upper);
+
+// Returns the size of the hashed part of the document key the given encoded key starts with, which
+// is the prefix shared by all keys of its hash partition, or 0 if the key has no hashed part.
+Result<size_t> RangeTombstonePartitionSize(const Slice& key);
+
+// Decodes a range tombstone from its key. Returns false if the key is not a range tombstone key.
+Result<bool> DecodeRangeTombstone(const SubDocKeyView& key, RangeTombstone* tombstone);
+
+// The range tombstones of one hash partition.
+//
+// This class is not thread-safe.
+class RangeTombstones {
+ public:
+  // Starts collecting the range tombstones of the partition whose keys start with the given
+  // prefix.
+  void Reset(const Slice& partition);
+
+  void Clear() {
+    Reset(Slice());
+  }
+
+  // The key prefix of the partition, or empty if the tombstones of no partition are collected.
+  const std::string& partition() const { return partition_; }
+
+  bool empty() const { return tombstones_.empty(); }
+
+  // Adds a range tombstone of the partition. Versions of the same range tombstone should be added
+  // newest first, only the first one is kept.
+  void Add(RangeTombstone tombstone);
+
+  // Returns the hybrid time of the latest range tombstone covering the given key, which must start
+  // with the partition prefix and must not have a hybrid time, or DocHybridTime::kMin if there is
+  // none.
+  DocHybridTime DeleteTime(const Slice& key_without_ht) const;
+
+ private:
+  std::string partition_;
+  std::vector<RangeTombstone> tombstones_;
+};
+
+}  // namespace docdb
+}  // namespace yb
+
+#endif  // YB_DOCDB_RANGE_TOMBSTONE_H_
@@ -21,6 +21,7 @@
 #include "yb/util/bytes_formatter.h"
 #include "yb/util/enums.h"
 #include "yb/util/logging.h"
+#include "yb/util/monotime.h"
 #include "yb/util/trace.h"
 #include "yb/util/tostring.h"
 
@@ -201,9 +202,13 @@ void SharedLockManager::LockEntry::Lock(IntentType lock_type) {
   int type_idx = static_cast<size_t>(lock_type);
   std::unique_lock<std::mutex> lock(mutex);
   auto& state = this->state;
-  cond_var.wait(lock, [&state, type_idx]() {
-    return (state & kIntentConflicts[type_idx]).none();
-  });
+  if ((state & kIntentConflicts[type_idx]).any()) {
+    auto start = MonoTime::Now();
+    cond_var.wait(lock, [&state, type_idx]() {
+      return (state & kIntentConflicts[type_idx]).none();
+    });
+    TRACE_COST(TraceCost::kLockWaitMicros, MonoTime::Now().GetDeltaSince(start).ToMicroseconds());
+  }
   ++num_holding[type_idx];
   state.set(type_idx);
 }
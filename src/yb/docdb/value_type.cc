@@ -61,6 +61,8 @@ string ToString(ValueType value_type) {
     case ValueType::kRedisSet: return "RedisSet";
     case ValueType::kRedisTS: return "RedisTimeseries";
     case ValueType::kRedisSortedSet: return "RedisSortedSet";
+    case ValueType::kPackedRow: return "PackedRow";
+    case ValueType::kRangeTombstone: return "RangeTombstone";
     case ValueType::kArray: return "Array";
     case ValueType::kArrayIndex: return "ArrayIndex";
     case ValueType::kTombstone: return "Tombstone";
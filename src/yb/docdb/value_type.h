@@ -67,6 +67,12 @@ enum class ValueType : char {
   kSSReverse = '\'', // ASCII code 39
 
   kRedisSet = '(', // ASCII code 40
+  // Subkey of the entry holding all scalar columns of a QL row written by one INSERT. It sorts
+  // before the liveness column and all regular columns, so it is read first within a row.
+  kPackedRow = ')', // ASCII code 41
+  // Subkey of a range tombstone, stored under the hashed part of a doc key. It is followed by the
+  // lower and upper bounds of the deleted range, see range_tombstone.h.
+  kRangeTombstone = '*', // ASCII code 42
   // This is the redis timeseries type.
   kRedisTS = '+', // ASCII code 43
   kRedisSortedSet = ',', // ASCII code 44
@@ -61,6 +61,7 @@
 #include <vector>
 
 #include <boost/optional.hpp>
+#include <boost/scope_exit.hpp>
 #include <boost/thread/shared_mutex.hpp>
 #include <glog/logging.h>
 #include "yb/common/partial_row.h"
@@ -777,6 +778,7 @@ Status CatalogManager::VisitSysCatalog() {
 
   // Clear internal maps and run data loaders.
   RETURN_NOT_OK(RunLoaders());
+  TabletLocationsChanged();
 
   // Create the system namespaces (created only if they don't already exist).
   RETURN_NOT_OK(PrepareDefaultNamespaces());
@@ -1909,6 +1911,10 @@ Status CatalogManager::DeleteTable(const DeleteTableRequestPB* req,
   for (int i = 0; i < table_locks.size(); i++) {
     table_locks[i]->Commit();
   }
+  for (const auto& table : tables) {
+    table->TabletLocationsChanged();
+  }
+  TabletLocationsChanged();
 
   // The table lock (l) and the global lock (lock_) must be released for the next call.
   for (int i = 0; i < deleted_tables.size(); i++) {
@@ -2348,6 +2354,8 @@ Status CatalogManager::AlterTable(const AlterTableRequestPB* req,
   // Update the in-memory state
   TRACE("Committing in-memory state");
   l->Commit();
+  table->TabletLocationsChanged();
+  TabletLocationsChanged();
 
   SendAlterTableRequest(table);
 
@@ -2623,11 +2631,39 @@ Status CatalogManager::ProcessTabletReport(TSDescriptor* ts_desc,
   // the server should have, compare vs the ones being reported, and somehow mark
   // any that have been "lost" (eg somehow the tablet metadata got corrupted or something).
 
-  for (const ReportedTabletPB& reported : report.updated_tablets()) {
+  // Resolve all reported tablets with a single acquisition of the catalog lock, so that a large
+  // full report does not contend with DDL and location lookups once per tablet.
+  std::vector<scoped_refptr<TabletInfo>> tablets;
+  tablets.reserve(report.updated_tablets_size());
+  {
+    boost::shared_lock<LockType> l(lock_);
+    for (const ReportedTabletPB& reported : report.updated_tablets()) {
+      tablets.push_back(FindPtrOrNull(tablet_map_, reported.tablet_id()));
+    }
+  }
+  TRACE("Looked up reported tablets");
+
+  // Locations of a reported tablet may have changed even if handling it or a later tablet fails,
+  // so the cached locations are invalidated on every exit path.
+  bool locations_changed = false;
+  BOOST_SCOPE_EXIT(this_, &locations_changed) {
+    if (locations_changed) {
+      this_->TabletLocationsChanged();
+    }
+  } BOOST_SCOPE_EXIT_END;
+
+  for (int i = 0; i < report.updated_tablets_size(); ++i) {
+    const ReportedTabletPB& reported = report.updated_tablets(i);
     ReportedTabletUpdatesPB *tablet_report = report_update->add_tablets();
     tablet_report->set_tablet_id(reported.tablet_id());
-    RETURN_NOT_OK_PREPEND(HandleReportedTablet(ts_desc, reported, tablet_report),
-                          Substitute("Error handling $0", reported.ShortDebugString()));
+    locations_changed = true;
+    Status s = HandleReportedTablet(ts_desc, reported, tablets[i], tablet_report);
+    // Versions are bumped after the change, so that a concurrent reader cannot cache the old
+    // locations with the new version.
+    if (tablets[i] && tablets[i]->table()) {
+      tablets[i]->table()->TabletLocationsChanged();
+    }
+    RETURN_NOT_OK_PREPEND(s, Substitute("Error handling $0", reported.ShortDebugString()));
   }
 
   if (!ts_desc->has_tablet_report()) {
@@ -2670,14 +2706,10 @@ bool ShouldTransitionTabletToRunning(const ReportedTabletPB& report) {
 
 Status CatalogManager::HandleReportedTablet(TSDescriptor* ts_desc,
                                             const ReportedTabletPB& report,
+                                            const scoped_refptr<TabletInfo>& tablet,
                                             ReportedTabletUpdatesPB *report_updates) {
   TRACE_EVENT1("master", "HandleReportedTablet",
                "tablet_id", report.tablet_id());
-  scoped_refptr<TabletInfo> tablet;
-  {
-    boost::shared_lock<LockType> l(lock_);
-    tablet = FindPtrOrNull(tablet_map_, report.tablet_id());
-  }
   RETURN_NOT_OK_PREPEND(CheckIsLeaderAndReady(),
       Substitute("This master is no longer the leader, unable to handle report for tablet $0",
                  report.tablet_id()));
@@ -2700,6 +2732,9 @@ Status CatalogManager::HandleReportedTablet(TSDescriptor* ts_desc,
   // to change the state. Can we change CowedObject to lazily do the copy?
   auto table_lock = tablet->table()->LockForRead();
   auto tablet_lock = tablet->LockForWrite();
+  // Whether the report changed the persistent tablet metadata, which then has to be written to
+  // the sys catalog.
+  bool tablet_modified = false;
 
   // If the TS is reporting a tablet which has been deleted, or a tablet from
   // a table which has been deleted, send it an RPC to delete it.
@@ -2800,6 +2835,7 @@ Status CatalogManager::HandleReportedTablet(TSDescriptor* ts_desc,
       VLOG(1) << "Tablet " << tablet->ToString() << " is now online";
       tablet_lock->mutable_data()->set_state(SysTabletsEntryPB::RUNNING,
                                              "Tablet reported with an active leader");
+      tablet_modified = true;
     }
 
     // The Master only accepts committed consensus configurations since it needs the committed index
@@ -2863,6 +2899,7 @@ Status CatalogManager::HandleReportedTablet(TSDescriptor* ts_desc,
 
       RETURN_NOT_OK(ResetTabletReplicasFromReportedConfig(*final_report, tablet,
                                                           tablet_lock.get(), table_lock.get()));
+      tablet_modified = true;
 
       // Sanity check replicas for this tablet.
       TabletInfo::ReplicaMap replica_map;
@@ -2875,22 +2912,28 @@ Status CatalogManager::HandleReportedTablet(TSDescriptor* ts_desc,
       // Report opid_index is equal to the previous opid_index. If some
       // replica is reporting the same consensus configuration we already know about and hasn't
       // been added as replica, add it.
-      LOG(INFO) << "Peer " << ts_desc->permanent_uuid() << " sent full tablet report for "
-                << tablet->tablet_id() << ". Consensus state: " << cstate.ShortDebugString();
+      VLOG(1) << "Peer " << ts_desc->permanent_uuid() << " sent full tablet report for "
+              << tablet->tablet_id() << ". Consensus state: " << cstate.ShortDebugString();
       AddReplicaToTabletIfNotFound(ts_desc, report, tablet);
     }
   }
 
   table_lock->Unlock();
-  // We update the tablets each time that someone reports it.
-  // This shouldn't be very frequent and should only happen when something in fact changed.
-  Status s = sys_catalog_->UpdateItem(tablet.get());
-  if (!s.ok()) {
-    LOG(WARNING) << "Error updating tablets: " << s.ToString() << ". Tablet report was: "
-                 << report.ShortDebugString();
-    return s;
+  // The consensus state the master keeps for a tablet is versioned by its config opid_index and
+  // term, so a report that does not advance them leaves the persistent metadata unchanged. Most of
+  // a full tablet report after a master leader change is such reports, and they are handled in
+  // memory only instead of costing a sys catalog write per tablet.
+  if (tablet_modified) {
+    Status s = sys_catalog_->UpdateItem(tablet.get());
+    if (!s.ok()) {
+      LOG(WARNING) << "Error updating tablets: " << s.ToString() << ". Tablet report was: "
+                   << report.ShortDebugString();
+      return s;
+    }
+    tablet_lock->Commit();
+  } else {
+    tablet_lock->Unlock();
   }
-  tablet_lock->Commit();
 
   // Need to defer the AlterTable command to after we've committed the new tablet data,
   // since the tablet report may also be updating the raft config, and the Alter Table
@@ -4434,21 +4477,77 @@ Status CatalogManager::GetTableLocations(const GetTableLocationsRequestPB* req,
     return SetupError(resp->mutable_error(), MasterErrorPB::TABLE_NOT_FOUND, s);
   }
 
-  vector<scoped_refptr<TabletInfo>> tablets_in_range;
-  table->GetTabletsInRange(req, &tablets_in_range);
+  resp->set_table_type(table->metadata().state().pb.table_type());
+
+  // The replicas of system tables are the masters, which are not covered by the locations version.
+  if (table->IsSupportedSystemTable(sys_tables_handler_.supported_system_tables())) {
+    vector<scoped_refptr<TabletInfo>> tablets_in_range;
+    table->GetTabletsInRange(req, &tablets_in_range);
 
-  for (const scoped_refptr<TabletInfo>& tablet : tablets_in_range) {
-    if (!BuildLocationsForTablet(tablet, resp->add_tablet_locations()).ok()) {
-      // Not running.
-      resp->mutable_tablet_locations()->RemoveLast();
+    for (const scoped_refptr<TabletInfo>& tablet : tablets_in_range) {
+      if (!BuildLocationsForTablet(tablet, resp->add_tablet_locations()).ok()) {
+        // Not running.
+        resp->mutable_tablet_locations()->RemoveLast();
+      }
     }
+    return Status::OK();
   }
 
-  resp->set_table_type(table->metadata().state().pb.table_type());
+  // The locations change with the tablets of the table and with the addresses of the tablet
+  // servers. Both counters only grow, so their sum changes whenever either of them does. Read the
+  // version before looking at the locations, so that a change racing with this request makes the
+  // snapshot older than its version rather than newer.
+  const uint64_t version =
+      table->tablet_locations_version() + master_->ts_manager()->registration_version();
+  auto snapshot = table->GetLocationsSnapshot(version, [this, &table, version] {
+    return BuildLocationsSnapshot(table, version);
+  });
+
+  // Same range selection as TableInfo::GetTabletsInRange.
+  const auto& tablets = snapshot->tablets;
+  auto it = tablets.begin();
+  if (req->has_partition_key_start()) {
+    it = std::upper_bound(
+        tablets.begin(), tablets.end(), req->partition_key_start(),
+        [](const std::string& key, const TableInfo::LocationsSnapshot::Entry& entry) {
+          return key < entry.partition_key_start;
+        });
+    if (it != tablets.begin()) {
+      --it;
+    }
+  }
+  uint32_t count = 0;
+  for (; it != tablets.end() && count < req->max_returned_locations(); ++it, ++count) {
+    if (req->has_partition_key_end() && it->partition_key_start > req->partition_key_end()) {
+      break;
+    }
+    if (it->running) {
+      *resp->add_tablet_locations() = it->locations;
+    }
+  }
 
   return Status::OK();
 }
 
+std::shared_ptr<const TableInfo::LocationsSnapshot> CatalogManager::BuildLocationsSnapshot(
+    const scoped_refptr<TableInfo>& table, uint64_t version) {
+  vector<scoped_refptr<TabletInfo>> tablets;
+  table->GetAllTablets(&tablets);
+
+  auto snapshot = std::make_shared<TableInfo::LocationsSnapshot>();
+  snapshot->version = version;
+  snapshot->tablets.resize(tablets.size());
+  for (size_t i = 0; i != tablets.size(); ++i) {
+    auto& entry = snapshot->tablets[i];
+    {
+      auto l = tablets[i]->LockForRead();
+      entry.partition_key_start = l->data().pb.partition().partition_key_start();
+    }
+    entry.running = BuildLocationsForTablet(tablets[i], &entry.locations).ok();
+  }
+  return snapshot;
+}
+
 Status CatalogManager::GetCurrentConfig(consensus::ConsensusStatePB* cpb) const {
   string uuid = master_->fs_manager()->uuid();
   if (!sys_catalog_->tablet_peer() ||
@@ -4999,20 +5098,31 @@ const std::string TableInfo::indexed_table_id() const {
 }
 
 bool TableInfo::RemoveTablet(const std::string& partition_key_start) {
-  std::lock_guard<simple_spinlock> l(lock_);
-  return EraseKeyReturnValuePtr(&tablet_map_, partition_key_start) != NULL;
+  bool removed;
+  {
+    std::lock_guard<simple_spinlock> l(lock_);
+    removed = EraseKeyReturnValuePtr(&tablet_map_, partition_key_start) != NULL;
+  }
+  TabletLocationsChanged();
+  return removed;
 }
 
 void TableInfo::AddTablet(TabletInfo *tablet) {
-  std::lock_guard<simple_spinlock> l(lock_);
-  AddTabletUnlocked(tablet);
+  {
+    std::lock_guard<simple_spinlock> l(lock_);
+    AddTabletUnlocked(tablet);
+  }
+  TabletLocationsChanged();
 }
 
 void TableInfo::AddTablets(const vector<TabletInfo*>& tablets) {
-  std::lock_guard<simple_spinlock> l(lock_);
-  for (TabletInfo *tablet : tablets) {
-    AddTabletUnlocked(tablet);
+  {
+    std::lock_guard<simple_spinlock> l(lock_);
+    for (TabletInfo *tablet : tablets) {
+      AddTabletUnlocked(tablet);
+    }
   }
+  TabletLocationsChanged();
 }
 
 void TableInfo::AddTabletUnlocked(TabletInfo* tablet) {
@@ -5159,6 +5269,29 @@ void TableInfo::GetAllTablets(vector<scoped_refptr<TabletInfo>> *ret) const {
   }
 }
 
+std::shared_ptr<const TableInfo::LocationsSnapshot> TableInfo::GetLocationsSnapshot(
+    uint64_t version, const LocationsSnapshotBuilder& build) {
+  {
+    std::lock_guard<simple_spinlock> l(lock_);
+    if (locations_snapshot_ && locations_snapshot_->version == version) {
+      return locations_snapshot_;
+    }
+  }
+
+  std::lock_guard<std::mutex> build_lock(locations_snapshot_build_mutex_);
+  {
+    // Another request could have built the snapshot while we were waiting.
+    std::lock_guard<simple_spinlock> l(lock_);
+    if (locations_snapshot_ && locations_snapshot_->version == version) {
+      return locations_snapshot_;
+    }
+  }
+  auto snapshot = build();
+  std::lock_guard<simple_spinlock> l(lock_);
+  locations_snapshot_ = snapshot;
+  return snapshot;
+}
+
 void TableInfo::GetIndexInfo(const TableId& index_id, IndexInfo* index_info) const {
   index_info->hash_column_ids.clear();
   index_info->range_column_ids.clear();
@@ -32,8 +32,12 @@
 #ifndef YB_MASTER_CATALOG_MANAGER_H
 #define YB_MASTER_CATALOG_MANAGER_H
 
+#include <atomic>
+#include <functional>
 #include <list>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -379,6 +383,40 @@ class TableInfo : public RefCountedThreadSafe<TableInfo>,
 
   void GetAllTablets(std::vector<scoped_refptr<TabletInfo> > *ret) const;
 
+  // Returns a number that changes whenever tablets are added to or removed from this table, or the
+  // state or the replicas of one of its tablets change.
+  uint64_t tablet_locations_version() const {
+    return tablet_locations_version_.load(std::memory_order_acquire);
+  }
+
+  // Must be called after a change to the locations of the tablets of this table is visible in the
+  // in-memory state.
+  void TabletLocationsChanged() {
+    tablet_locations_version_.fetch_add(1, std::memory_order_acq_rel);
+  }
+
+  // Locations of all tablets of the table, built once per locations version and shared by
+  // GetTableLocations requests until the next change.
+  struct LocationsSnapshot {
+    struct Entry {
+      std::string partition_key_start;
+      // Tablets that are not running have no locations.
+      bool running;
+      TabletLocationsPB locations;
+    };
+
+    uint64_t version;
+    // Ordered by partition key start.
+    std::vector<Entry> tablets;
+  };
+
+  typedef std::function<std::shared_ptr<const LocationsSnapshot>()> LocationsSnapshotBuilder;
+
+  // Returns the locations snapshot for 'version'. If the cached snapshot is older, builds a new one
+  // using 'build'. Concurrent requests for the same version build it only once.
+  std::shared_ptr<const LocationsSnapshot> GetLocationsSnapshot(
+      uint64_t version, const LocationsSnapshotBuilder& build);
+
   // Get info of the specified index.
   void GetIndexInfo(const TableId& index_id, IndexInfo* index_info) const;
 
@@ -418,9 +456,17 @@ class TableInfo : public RefCountedThreadSafe<TableInfo>,
   typedef std::map<std::string, TabletInfo *> TabletInfoMap;
   TabletInfoMap tablet_map_;
 
-  // Protects tablet_map_ and pending_tasks_
+  // Protects tablet_map_, locations_snapshot_ and pending_tasks_
   mutable simple_spinlock lock_;
 
+  // See tablet_locations_version().
+  std::atomic<uint64_t> tablet_locations_version_{0};
+
+  std::shared_ptr<const LocationsSnapshot> locations_snapshot_;
+
+  // Serializes building locations_snapshot_, which is too expensive to do under lock_.
+  std::mutex locations_snapshot_build_mutex_;
+
   // List of pending tasks (e.g. create/alter tablet requests)
   std::unordered_set<std::shared_ptr<MonitoredTask>> pending_tasks_;
 
@@ -799,6 +845,13 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
   CHECKED_STATUS GetTabletLocations(const TabletId& tablet_id,
                             TabletLocationsPB* locs_pb);
 
+  // Returns a number that changes whenever tables are created, altered or deleted, or a tablet
+  // report changes the state or the replicas of tablets. Callers caching data derived from table
+  // and tablet locations, such as the system.partitions virtual table, use it to detect changes.
+  uint64_t tablet_locations_version() const {
+    return tablet_locations_version_.load(std::memory_order_acquire);
+  }
+
   // Retrieves a SystemTablet instance based on the existing system tablets already created in our
   // syscatalog.
   CHECKED_STATUS RetrieveSystemTablet(const TabletId& tablet_id,
@@ -1090,6 +1143,10 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
                                           const TableId& index_table_id,
                                           DeleteTableResponsePB* resp);
 
+  // Builds the locations snapshot of a table for the given locations version.
+  std::shared_ptr<const TableInfo::LocationsSnapshot> BuildLocationsSnapshot(
+      const scoped_refptr<TableInfo>& table, uint64_t version);
+
   // Builds the TabletLocationsPB for a tablet based on the provided TabletInfo.
   // Populates locs_pb and returns true on success.
   // Returns Status::ServiceUnavailable if tablet is not running.
@@ -1099,10 +1156,11 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
   CHECKED_STATUS FindTable(const TableIdentifierPB& table_identifier,
                            scoped_refptr<TableInfo>* table_info);
 
-  // Handle one of the tablets in a tablet reported.
-  // Requires that the lock is already held.
+  // Handle one of the tablets in a tablet reported. 'tablet' is the catalog entry of the reported
+  // tablet, or null if the tablet is unknown.
   CHECKED_STATUS HandleReportedTablet(TSDescriptor* ts_desc,
                               const ReportedTabletPB& report,
+                              const scoped_refptr<TabletInfo>& tablet,
                               ReportedTabletUpdatesPB *report_updates);
 
   CHECKED_STATUS ResetTabletReplicasFromReportedConfig(const ReportedTabletPB& report,
@@ -1406,6 +1464,13 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
   // Number of live tservers metric.
   scoped_refptr<AtomicGauge<uint32_t>> metric_num_tablet_servers_live_;
 
+  // See tablet_locations_version(). Incremented after the change is visible in the in-memory state.
+  std::atomic<uint64_t> tablet_locations_version_{0};
+
+  void TabletLocationsChanged() {
+    tablet_locations_version_.fetch_add(1, std::memory_order_acq_rel);
+  }
+
   friend class ClusterLoadBalancer;
 
   // Policy for load balancing tablets on tablet servers.
@@ -39,6 +39,7 @@
 #include <gtest/gtest.h>
 
 #include "yb/common/partial_row.h"
+#include "yb/consensus/log.h"
 #include "yb/gutil/strings/join.h"
 #include "yb/gutil/strings/substitute.h"
 #include "yb/master/master-test-util.h"
@@ -49,6 +50,7 @@
 #include "yb/master/sys_catalog.h"
 #include "yb/master/ts_descriptor.h"
 #include "yb/master/ts_manager.h"
+#include "yb/master/yql_partitions_vtable.h"
 #include "yb/rpc/messenger.h"
 #include "yb/server/rpc_server.h"
 #include "yb/server/server_base.proxy.h"
@@ -181,6 +183,26 @@ class MasterTest : public YBTest {
   void DoListAllNamespaces(ListNamespacesResponsePB* resp);
   Status CreateNamespace(const NamespaceName& ns_name, CreateNamespaceResponsePB* resp);
 
+  // Registers a fake tablet server, which does not actually host any tablets.
+  void RegisterFakeTS(const std::string& ts_uuid);
+
+  // Sends a full tablet report with the given tablets on behalf of the fake tablet server.
+  void SendTabletReport(const std::string& ts_uuid,
+                        const std::vector<ReportedTabletPB>& reported_tablets);
+
+  // Returns a report of a running replica of the tablet on the fake tablet server, which is the
+  // only peer and the leader of the given term.
+  ReportedTabletPB MakeReportedTablet(const TabletId& tablet_id, const std::string& ts_uuid,
+                                      int64_t term, int64_t opid_index);
+
+  // Returns the index of the last operation written to the sys catalog.
+  int64_t SysCatalogLastOpIndex() {
+    consensus::OpId op_id;
+    mini_master_->master()->catalog_manager()->sys_catalog()->tablet_peer()->log()->
+        GetLatestEntryOpId(&op_id);
+    return op_id.index();
+  }
+
   RpcController* ResetAndGetController() {
     controller_->Reset();
     return controller_.get();
@@ -406,6 +428,54 @@ TEST_F(MasterTest, TestRegisterAndHeartbeat) {
   }
 }
 
+void MasterTest::RegisterFakeTS(const std::string& ts_uuid) {
+  TSHeartbeatRequestPB req;
+  TSHeartbeatResponsePB resp;
+  req.mutable_common()->mutable_ts_instance()->set_permanent_uuid(ts_uuid);
+  req.mutable_common()->mutable_ts_instance()->set_instance_seqno(1);
+  MakeHostPortPB("127.0.0.1", 1000, req.mutable_registration()->mutable_common()->
+      add_rpc_addresses());
+  MakeHostPortPB("127.0.0.1", 2000, req.mutable_registration()->mutable_common()->
+      add_http_addresses());
+  ASSERT_OK(proxy_->TSHeartbeat(req, &resp, ResetAndGetController()));
+  ASSERT_FALSE(resp.has_error()) << resp.DebugString();
+  ASSERT_FALSE(resp.needs_reregister());
+}
+
+void MasterTest::SendTabletReport(const std::string& ts_uuid,
+                                  const std::vector<ReportedTabletPB>& reported_tablets) {
+  TSHeartbeatRequestPB req;
+  TSHeartbeatResponsePB resp;
+  req.mutable_common()->mutable_ts_instance()->set_permanent_uuid(ts_uuid);
+  req.mutable_common()->mutable_ts_instance()->set_instance_seqno(1);
+  TabletReportPB* report = req.mutable_tablet_report();
+  report->set_is_incremental(false);
+  report->set_sequence_number(0);
+  for (const auto& reported_tablet : reported_tablets) {
+    *report->add_updated_tablets() = reported_tablet;
+  }
+  ASSERT_OK(proxy_->TSHeartbeat(req, &resp, ResetAndGetController()));
+  ASSERT_FALSE(resp.has_error()) << resp.DebugString();
+  ASSERT_FALSE(resp.needs_full_tablet_report());
+}
+
+ReportedTabletPB MasterTest::MakeReportedTablet(const TabletId& tablet_id,
+                                                const std::string& ts_uuid,
+                                                int64_t term, int64_t opid_index) {
+  ReportedTabletPB reported_tablet;
+  reported_tablet.set_tablet_id(tablet_id);
+  reported_tablet.set_state(tablet::RUNNING);
+  auto* cstate = reported_tablet.mutable_committed_consensus_state();
+  cstate->set_current_term(term);
+  cstate->set_leader_uuid(ts_uuid);
+  cstate->mutable_config()->set_opid_index(opid_index);
+  auto* peer = cstate->mutable_config()->add_peers();
+  peer->set_permanent_uuid(ts_uuid);
+  peer->set_member_type(consensus::RaftPeerPB::VOTER);
+  MakeHostPortPB("127.0.0.1", 1000, peer->mutable_last_known_addr());
+  return reported_tablet;
+}
+
 Status MasterTest::CreateTable(const NamespaceName& namespace_name,
                                const TableName& table_name,
                                const Schema& schema) {
@@ -649,6 +719,122 @@ TEST_F(MasterTest, TestInvalidGetTableLocations) {
   }
 }
 
+// The cached locations of a table must only be invalidated by changes to that table.
+TEST_F(MasterTest, TestGetTableLocationsVersionPerTable) {
+  const TableName kTableName = "test";
+  Schema schema({ ColumnSchema("key", INT32) }, 1);
+  ASSERT_OK(CreateTable(kTableName, schema));
+  auto table = mini_master_->master()->catalog_manager()->
+      GetTableInfoFromNamespaceNameAndTableName(default_namespace_name, kTableName);
+  ASSERT_TRUE(table != nullptr);
+
+  GetTableLocationsRequestPB req;
+  GetTableLocationsResponsePB resp;
+  req.mutable_table()->set_table_name(kTableName);
+  req.mutable_table()->mutable_namespace_()->set_name(default_namespace_name);
+  ASSERT_OK(proxy_->GetTableLocations(req, &resp, ResetAndGetController()));
+  SCOPED_TRACE(resp.DebugString());
+  ASSERT_FALSE(resp.has_error());
+  const uint64_t version = table->tablet_locations_version();
+
+  // Creating and deleting another table does not change the version of this table.
+  ASSERT_OK(CreateTable("other", schema));
+  ASSERT_OK(DeleteTable(default_namespace_name, "other"));
+  ASSERT_EQ(version, table->tablet_locations_version());
+
+  ASSERT_OK(proxy_->GetTableLocations(req, &resp, ResetAndGetController()));
+  ASSERT_FALSE(resp.has_error());
+
+  // Deleting the table itself does.
+  ASSERT_OK(DeleteTable(default_namespace_name, kTableName));
+  ASSERT_NE(version, table->tablet_locations_version());
+}
+
+// A tablet report that changes tablet locations must invalidate the cached system.partitions rows.
+TEST_F(MasterTest, TestPartitionsVTableInvalidatedByTabletReport) {
+  const char* kTsUUID = "my-ts-uuid";
+  ASSERT_NO_FATALS(RegisterFakeTS(kTsUUID));
+  ASSERT_NO_FATALS(SendTabletReport(kTsUUID, {}));
+
+  const TableName kTableName = "test";
+  Schema schema({ ColumnSchema("key", INT32) }, 1);
+  ASSERT_OK(CreateTable(kTableName, schema));
+  auto table = mini_master_->master()->catalog_manager()->
+      GetTableInfoFromNamespaceNameAndTableName(default_namespace_name, kTableName);
+  ASSERT_TRUE(table != nullptr);
+  std::vector<scoped_refptr<TabletInfo>> tablets;
+  table->GetAllTablets(&tablets);
+  ASSERT_FALSE(tablets.empty());
+
+  // Tablets of the new table are not running yet, so they have no rows.
+  YQLPartitionsVTable vtable(mini_master_->master());
+  QLReadRequestPB req;
+  std::unique_ptr<QLRowBlock> rows;
+  ASSERT_OK(vtable.RetrieveData(req, &rows));
+  const size_t num_rows = rows->row_count();
+  ASSERT_OK(vtable.RetrieveData(req, &rows));
+  ASSERT_EQ(num_rows, rows->row_count());
+
+  // Once a tablet is reported running it has a row, without waiting for the cache to expire.
+  const uint64_t version = mini_master_->master()->catalog_manager()->tablet_locations_version();
+  ASSERT_NO_FATALS(SendTabletReport(
+      kTsUUID, { MakeReportedTablet(tablets[0]->tablet_id(), kTsUUID, 1, 1) }));
+  ASSERT_NE(version, mini_master_->master()->catalog_manager()->tablet_locations_version());
+  ASSERT_OK(vtable.RetrieveData(req, &rows));
+  ASSERT_EQ(num_rows + 1, rows->row_count());
+}
+
+// A tablet report is only written to the sys catalog when it changes the persistent tablet metadata.
+TEST_F(MasterTest, TestTabletReportSysCatalogWrites) {
+  const char* kTsUUID = "my-ts-uuid";
+  ASSERT_NO_FATALS(RegisterFakeTS(kTsUUID));
+  ASSERT_NO_FATALS(SendTabletReport(kTsUUID, {}));
+
+  const TableName kTableName = "test";
+  Schema schema({ ColumnSchema("key", INT32) }, 1);
+  ASSERT_OK(CreateTable(kTableName, schema));
+  auto table = mini_master_->master()->catalog_manager()->
+      GetTableInfoFromNamespaceNameAndTableName(default_namespace_name, kTableName);
+  ASSERT_TRUE(table != nullptr);
+  std::vector<scoped_refptr<TabletInfo>> tablets;
+  table->GetAllTablets(&tablets);
+  ASSERT_FALSE(tablets.empty());
+  const TabletId tablet_id = tablets[0]->tablet_id();
+
+  // Returns whether the report of the tablet caused a sys catalog write. The master writes to the
+  // sys catalog in the background as well, e.g. to assign the replicas of the new tablets, so
+  // those writes have to be done first.
+  auto report_writes_sys_catalog = [&](int64_t term, int64_t opid_index) {
+    int64_t last_op_index = SysCatalogLastOpIndex();
+    for (;;) {
+      SleepFor(MonoDelta::FromMilliseconds(100));
+      const int64_t op_index = SysCatalogLastOpIndex();
+      if (op_index == last_op_index) {
+        break;
+      }
+      last_op_index = op_index;
+    }
+    SendTabletReport(kTsUUID, { MakeReportedTablet(tablet_id, kTsUUID, term, opid_index) });
+    return SysCatalogLastOpIndex() != last_op_index;
+  };
+
+  // The first report moves the tablet to RUNNING.
+  ASSERT_TRUE(report_writes_sys_catalog(1, 1));
+  ASSERT_TRUE(tablets[0]->LockForRead()->data().is_running());
+
+  // Duplicate and stale reports leave the tablet unchanged.
+  ASSERT_FALSE(report_writes_sys_catalog(1, 1));
+  ASSERT_FALSE(report_writes_sys_catalog(1, 0));
+
+  // A newer config or term changes it.
+  ASSERT_TRUE(report_writes_sys_catalog(1, 2));
+  ASSERT_TRUE(report_writes_sys_catalog(2, 2));
+  ASSERT_FALSE(report_writes_sys_catalog(2, 2));
+  auto l = tablets[0]->LockForRead();
+  ASSERT_EQ(2, l->data().pb.committed_consensus_state().current_term());
+  ASSERT_EQ(2, l->data().pb.committed_consensus_state().config().opid_index());
+}
+
 TEST_F(MasterTest, TestInvalidPlacementInfo) {
   const TableName kTableName = "test";
   Schema schema({ColumnSchema("key", INT32)}, 1);
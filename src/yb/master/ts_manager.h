@@ -32,6 +32,7 @@
 #ifndef YB_MASTER_TS_MANAGER_H
 #define YB_MASTER_TS_MANAGER_H
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -106,6 +107,13 @@ class TSManager {
   // Get the TS count.
   int GetCount() const;
 
+  // Returns a number that changes whenever a tablet server registers or re-registers, e.g. with new
+  // addresses. Callers caching data derived from tablet server registrations use it to detect
+  // changes.
+  uint64_t registration_version() const {
+    return registration_version_.load(std::memory_order_acquire);
+  }
+
   // Return the tablet server descriptor running on the given port.
   const TSDescSharedPtr GetTSDescriptor(const HostPortPB& host_port) const;
 
@@ -121,6 +129,9 @@ class TSManager {
   typedef std::unordered_map<std::string, TSDescSharedPtr> TSDescriptorMap;
   TSDescriptorMap servers_by_id_;
 
+  // See registration_version(). Incremented after the registration is visible.
+  std::atomic<uint64_t> registration_version_{0};
+
   DISALLOW_COPY_AND_ASSIGN(TSManager);
 };
 
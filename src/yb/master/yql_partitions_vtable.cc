@@ -15,6 +15,13 @@
 #include "yb/common/redis_constants_common.h"
 #include "yb/master/catalog_manager.h"
 #include "yb/master/yql_partitions_vtable.h"
+#include "yb/util/flag_tags.h"
+
+DEFINE_int32(partitions_vtable_cache_refresh_secs, 30,
+             "Maximum age of the cached contents of the system.partitions virtual table. The "
+             "cache is also rebuilt whenever tables or tablet locations change. Set to 0 to "
+             "rebuild the table on every query.");
+TAG_FLAG(partitions_vtable_cache_refresh_secs, advanced);
 
 namespace yb {
 namespace master {
@@ -25,6 +32,29 @@ YQLPartitionsVTable::YQLPartitionsVTable(const Master* const master)
 
 Status YQLPartitionsVTable::RetrieveData(const QLReadRequestPB& request,
                                          std::unique_ptr<QLRowBlock>* vtable) const {
+  // Read the version before building the rows, so that changes made while they are built
+  // invalidate the result.
+  const uint64_t version = master_->catalog_manager()->tablet_locations_version();
+  const MonoTime now = MonoTime::Now();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (cached_vtable_ && cached_version_ == version && now < cache_expiration_) {
+    vtable->reset(new QLRowBlock(*cached_vtable_));
+    return Status::OK();
+  }
+
+  RETURN_NOT_OK(GenerateData(vtable));
+  if (FLAGS_partitions_vtable_cache_refresh_secs > 0) {
+    cached_vtable_.reset(new QLRowBlock(**vtable));
+    cached_version_ = version;
+    cache_expiration_ = now + MonoDelta::FromSeconds(FLAGS_partitions_vtable_cache_refresh_secs);
+  } else {
+    cached_vtable_.reset();
+  }
+  return Status::OK();
+}
+
+Status YQLPartitionsVTable::GenerateData(std::unique_ptr<QLRowBlock>* vtable) const {
   vtable->reset(new QLRowBlock(schema_));
   std::vector<scoped_refptr<TableInfo> > tables;
   CatalogManager* catalog_manager = master_->catalog_manager();
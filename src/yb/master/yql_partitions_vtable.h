@@ -14,13 +14,19 @@
 #ifndef YB_MASTER_YQL_PARTITIONS_VTABLE_H
 #define YB_MASTER_YQL_PARTITIONS_VTABLE_H
 
+#include <mutex>
+
 #include "yb/master/master.h"
 #include "yb/master/yql_virtual_table.h"
+#include "yb/util/monotime.h"
 
 namespace yb {
 namespace master {
 
 // VTable implementation of system.partitions.
+//
+// Token aware drivers poll this table frequently, so the rows are cached and only rebuilt after
+// CatalogManager::tablet_locations_version() changes, or the cache gets too old.
 class YQLPartitionsVTable : public YQLVirtualTable {
  public:
   explicit YQLPartitionsVTable(const Master* const master);
@@ -29,6 +35,16 @@ class YQLPartitionsVTable : public YQLVirtualTable {
  protected:
   Schema CreateSchema() const;
  private:
+  // Builds the rows of the table from the current catalog manager state.
+  CHECKED_STATUS GenerateData(std::unique_ptr<QLRowBlock>* vtable) const;
+
+  // Protects the cached rows below. Held while the rows are rebuilt, so that concurrent queries
+  // wait for a single rebuild instead of each doing their own.
+  mutable std::mutex mutex_;
+  mutable std::unique_ptr<QLRowBlock> cached_vtable_;
+  mutable uint64_t cached_version_ = 0;
+  mutable MonoTime cache_expiration_;
+
   static constexpr const char* const kKeyspaceName = "keyspace_name";
   static constexpr const char* const kTableName = "table_name";
   static constexpr const char* const kStartKey = "start_key";
@@ -73,6 +73,28 @@ constexpr QueryId kDefaultQueryId = 0;
 constexpr QueryId kInMultiTouchId = -1;
 // Query ids to represent values that should not be in any cache.
 constexpr QueryId kNoCacheQueryId = -2;
+// Query ids to represent values that should stay in the single touch cache. All lookups of such
+// values share this id, so they are never promoted to the multi touch cache.
+constexpr QueryId kSingleTouchOnlyQueryId = -3;
+
+// Priority class of the values a client puts into a shared cache.
+enum class CachePriority {
+  // Values follow the regular single touch / multi touch policy.
+  kDefault,
+  // Values are put straight into the multi touch cache.
+  kHigh,
+  // Values are never promoted from the single touch cache to the multi touch cache.
+  kLow,
+};
+
+class CacheWithPriority;
+
+// Returns a view of the given cache that maps the query ids of all inserts and lookups according to
+// the priority class. The view shares capacity and entries with the underlying cache, so it is a
+// way for a client, e.g. a tablet of a given table, to control how its values compete with those
+// of other clients of the same cache.
+extern shared_ptr<CacheWithPriority> NewCacheWithPriority(
+    shared_ptr<Cache> cache, CachePriority priority);
 
 class Cache {
  public:
@@ -188,7 +210,11 @@ class Cache {
   virtual void ApplyToAllCacheEntries(void (*callback)(void*, size_t),
                                       bool thread_safe) = 0;
 
-  virtual void SetMetrics(const scoped_refptr<yb::MetricEntity>& entity) = 0;
+  // Registers the cache metrics with the given entity. The tier selects which set of metric
+  // prototypes is used, so that the uncompressed and compressed block caches can be reported
+  // separately on the same server entity.
+  virtual void SetMetrics(const scoped_refptr<yb::MetricEntity>& entity,
+                          yb::CacheMetricsTier tier) = 0;
 
  private:
   void LRU_Remove(Handle* e);
@@ -200,6 +226,14 @@ class Cache {
   void operator=(const Cache&);
 };
 
+// A view of a shared cache created by NewCacheWithPriority().
+class CacheWithPriority : public Cache {
+ public:
+  // Changes the priority class of the values inserted or looked up through this view from now on.
+  // Values already in the cache keep their place until they are looked up again.
+  virtual void SetPriority(CachePriority priority) = 0;
+};
+
 }  // namespace rocksdb
 
 #endif  // STORAGE_ROCKSDB_UTIL_CACHE_H_
@@ -33,6 +33,7 @@
 namespace rocksdb {
 
 class SliceTransform;
+struct FileBoundaryValuesBase;
 
 // Context information of a compaction run
 struct CompactionFilterContext {
@@ -148,6 +149,37 @@ class CompactionFilterFactory {
   virtual const char* Name() const = 0;
 };
 
+// Decides from the boundary values of an SST file, without reading it, whether all of its entries
+// are obsolete. Used by universal compaction to delete such files instead of rewriting them.
+class CompactionFileFilter {
+ public:
+  virtual ~CompactionFileFilter() { }
+
+  // Returns true if no entry of the file with the given boundary values is visible anymore, so that
+  // the file could be deleted if no older file exists.
+  virtual bool Expired(const FileBoundaryValuesBase& smallest,
+                       const FileBoundaryValuesBase& largest) const = 0;
+
+  // Returns the time window the entries of the file were written in. Universal compaction does not
+  // compact files of different time windows together, so that each window expires as a whole.
+  virtual uint64_t TimeWindow(const FileBoundaryValuesBase& smallest,
+                              const FileBoundaryValuesBase& largest) const {
+    return 0;
+  }
+};
+
+// Each compaction pick creates a new CompactionFileFilter, so that the filter can capture the
+// current time.
+class CompactionFileFilterFactory {
+ public:
+  virtual ~CompactionFileFilterFactory() { }
+
+  virtual std::unique_ptr<CompactionFileFilter> CreateCompactionFileFilter() = 0;
+
+  // Returns a name that identifies this compaction file filter factory.
+  virtual const char* Name() const = 0;
+};
+
 }  // namespace rocksdb
 
 #endif // ROCKSDB_INCLUDE_ROCKSDB_COMPACTION_FILTER_H
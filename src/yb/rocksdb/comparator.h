@@ -79,6 +79,12 @@ class Comparator {
   // Simple comparator implementations may return with *key unchanged,
   // i.e., an implementation of this method that does nothing is correct.
   virtual void FindShortSuccessor(std::string* key) const = 0;
+
+  // Returns true if this comparator orders internal keys (a user key followed by an 8 byte
+  // sequence number and type trailer) by the bytewise order of their user keys. Two such keys
+  // that differ within the user key part of both of them are ordered by their first differing
+  // byte, which lets block iterators skip comparing prefixes that are known to be equal.
+  virtual bool IsBytewiseInternalKeyComparator() const { return false; }
 };
 
 // Return a builtin comparator that uses lexicographic byte-wise
@@ -482,6 +482,10 @@ class ColumnFamilySet {
   // Don't call while iterating over ColumnFamilySet
   void FreeDeadColumnFamilies();
 
+  // Should be set before column families are created, it is passed to their table caches.
+  void SetDbIdentity(const std::string& db_identity) { db_identity_ = db_identity; }
+  const std::string& db_identity() const { return db_identity_; }
+
  private:
   friend class ColumnFamilyData;
   // helper function that gets called from cfd destructor
@@ -507,6 +511,7 @@ class ColumnFamilySet {
   ColumnFamilyData* default_cfd_cache_;
 
   const std::string db_name_;
+  std::string db_identity_;
   const DBOptions* const db_options_;
   const EnvOptions env_options_;
   Cache* table_cache_;
@@ -1146,7 +1146,14 @@ bool LevelCompactionPicker::PickCompactionBySize(VersionStorageInfo* vstorage,
 bool UniversalCompactionPicker::NeedsCompaction(
     const VersionStorageInfo* vstorage) const {
   const int kLevel0 = 0;
-  return vstorage->CompactionScore(kLevel0) >= 1;
+  if (vstorage->CompactionScore(kLevel0) >= 1) {
+    return true;
+  }
+  if (ioptions_.compaction_file_filter_factory == nullptr) {
+    return false;
+  }
+  auto file_filter = ioptions_.compaction_file_filter_factory->CreateCompactionFileFilter();
+  return !ExpiredFiles(*vstorage, *file_filter).empty();
 }
 
 struct UniversalCompactionPicker::SortedRun {
@@ -1221,10 +1228,40 @@ void UniversalCompactionPicker::SortedRun::DumpSizeInfo(
 std::vector<std::vector<UniversalCompactionPicker::SortedRun>>
     UniversalCompactionPicker::CalculateSortedRuns(const VersionStorageInfo& vstorage,
                                                    const ImmutableCFOptions& ioptions,
-                                                   uint64_t max_file_size) {
+                                                   const MutableCFOptions& mutable_cf_options,
+                                                   const CompactionFileFilter* file_filter) {
+  const uint64_t max_file_size = mutable_cf_options.max_file_size_for_compaction;
+  const auto& level0_files = vstorage.LevelFiles(0);
+  // Files from different time windows are not compacted together, so that files of old time
+  // windows could be deleted as a whole once they expire. Closed time windows that were not
+  // compacted keep up to level0_file_num_compaction_trigger - 1 files each. So when level 0 has
+  // more files than max_time_window_files, the oldest files are compacted together regardless of
+  // their time windows, to keep the number of files below level0_slowdown_writes_trigger.
+  size_t last_time_window_split = level0_files.size();
+  if (file_filter != nullptr) {
+    const int compaction_trigger = std::max(
+        mutable_cf_options.level0_file_num_compaction_trigger, 2);
+    const size_t max_time_window_files = std::max(
+        compaction_trigger,
+        mutable_cf_options.level0_slowdown_writes_trigger - compaction_trigger);
+    if (level0_files.size() > max_time_window_files) {
+      last_time_window_split = level0_files.size() - compaction_trigger;
+    }
+  }
+
   std::vector<std::vector<SortedRun>> ret(1);
-  for (FileMetaData* f : vstorage.LevelFiles(0)) {
+  uint64_t prev_time_window = 0;
+  for (size_t i = 0; i != level0_files.size(); ++i) {
+    FileMetaData* f = level0_files[i];
     if (f->fd.GetTotalFileSize() <= max_file_size) {
+      if (file_filter != nullptr) {
+        const uint64_t time_window = file_filter->TimeWindow(f->smallest, f->largest);
+        if (!ret.back().empty() && time_window != prev_time_window &&
+            i <= last_time_window_split) {
+          ret.emplace_back();
+        }
+        prev_time_window = time_window;
+      }
       ret.back().emplace_back(0, f, f->fd.GetTotalFileSize(), f->compensated_file_size,
           f->being_compacted);
     // If last sequence is empty it means that there are multiple too-large-to-compact files in
@@ -1271,6 +1308,27 @@ std::vector<std::vector<UniversalCompactionPicker::SortedRun>>
   return ret;
 }
 
+std::vector<FileMetaData*> UniversalCompactionPicker::ExpiredFiles(
+    const VersionStorageInfo& vstorage,
+    const CompactionFileFilter& file_filter) {
+  std::vector<FileMetaData*> result;
+  // Files of other levels are older than all level 0 files.
+  for (int level = 1; level < vstorage.num_levels(); level++) {
+    if (!vstorage.LevelFiles(level).empty()) {
+      return result;
+    }
+  }
+  const std::vector<FileMetaData*>& level_files = vstorage.LevelFiles(0);
+  for (auto ritr = level_files.rbegin(); ritr != level_files.rend(); ++ritr) {
+    FileMetaData* f = *ritr;
+    if (f->being_compacted || !file_filter.Expired(f->smallest, f->largest)) {
+      break;
+    }
+    result.push_back(f);
+  }
+  return result;
+}
+
 #ifndef NDEBUG
 namespace {
 // smallest_seqno and largest_seqno are set iff. `files` is not empty.
@@ -1351,10 +1409,21 @@ Compaction* UniversalCompactionPicker::PickCompaction(
     const MutableCFOptions& mutable_cf_options,
     VersionStorageInfo* vstorage,
     LogBuffer* log_buffer) {
+  std::unique_ptr<CompactionFileFilter> file_filter;
+  if (ioptions_.compaction_file_filter_factory != nullptr) {
+    file_filter = ioptions_.compaction_file_filter_factory->CreateCompactionFileFilter();
+    Compaction* result = PickCompactionExpiredFiles(
+        cf_name, mutable_cf_options, vstorage, *file_filter, log_buffer);
+    if (result != nullptr) {
+      return result;
+    }
+  }
+
   std::vector<std::vector<SortedRun>> sorted_runs = CalculateSortedRuns(
       *vstorage,
       ioptions_,
-      mutable_cf_options.max_file_size_for_compaction);
+      mutable_cf_options,
+      file_filter.get());
 
   for (const auto& block : sorted_runs) {
     Compaction* result = DoPickCompaction(cf_name, mutable_cf_options, vstorage, log_buffer, block);
@@ -1365,6 +1434,31 @@ Compaction* UniversalCompactionPicker::PickCompaction(
   return nullptr;
 }
 
+Compaction* UniversalCompactionPicker::PickCompactionExpiredFiles(
+    const std::string& cf_name, const MutableCFOptions& mutable_cf_options,
+    VersionStorageInfo* vstorage, const CompactionFileFilter& file_filter,
+    LogBuffer* log_buffer) {
+  std::vector<CompactionInputFiles> inputs(1);
+  inputs[0].level = 0;
+  inputs[0].files = ExpiredFiles(*vstorage, file_filter);
+  if (inputs[0].empty()) {
+    return nullptr;
+  }
+  for (auto* f : inputs[0].files) {
+    char tmp_fsize[16];
+    AppendHumanBytes(f->fd.GetTotalFileSize(), tmp_fsize, sizeof(tmp_fsize));
+    LOG_TO_BUFFER(log_buffer, "[%s] Universal: picking expired file %" PRIu64
+                              " with size %s for deletion",
+                  cf_name.c_str(), f->fd.GetNumber(), tmp_fsize);
+  }
+  Compaction* c = new Compaction(
+      vstorage, mutable_cf_options, std::move(inputs), 0, 0, 0, 0,
+      kNoCompression, {}, /* is manual */ false, vstorage->CompactionScore(0),
+      /* is deletion compaction */ true, CompactionReason::kUniversalExpiredFiles);
+  level0_compactions_in_progress_.insert(c);
+  return c;
+}
+
 Compaction* UniversalCompactionPicker::DoPickCompaction(
     const std::string& cf_name,
     const MutableCFOptions& mutable_cf_options,
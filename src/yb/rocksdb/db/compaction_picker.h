@@ -32,6 +32,7 @@
 #include <unordered_set>
 #include <vector>
 
+#include "yb/rocksdb/compaction_filter.h"
 #include "yb/rocksdb/db/compaction.h"
 #include "yb/rocksdb/db/version_set.h"
 #include "yb/rocksdb/env.h"
@@ -266,6 +267,12 @@ class UniversalCompactionPicker : public CompactionPicker {
       LogBuffer* log_buffer,
       const std::vector<SortedRun>& sorted_runs);
 
+  // Pick a deletion compaction of the expired files returned by ExpiredFiles.
+  Compaction* PickCompactionExpiredFiles(
+      const std::string& cf_name, const MutableCFOptions& mutable_cf_options,
+      VersionStorageInfo* vstorage, const CompactionFileFilter& file_filter,
+      LogBuffer* log_buffer);
+
   // Pick Universal compaction to limit read amplification
   Compaction* PickCompactionUniversalReadAmp(
       const std::string& cf_name, const MutableCFOptions& mutable_cf_options,
@@ -283,12 +290,25 @@ class UniversalCompactionPicker : public CompactionPicker {
   // Since there could be too-large-to-compact files, we could get several such sequences.
   // Files from one sequence are compacted together, and files from different sequences are not
   // compacted.
+  // When there is a compaction file filter, a new sequence is also started at each level 0 file
+  // whose time window differs from the one of the previous file. If there are too many level 0
+  // files for that, the oldest time windows are put into one sequence, so that enough of their
+  // files can be compacted together.
   // One sequence is std::vector<SortedRun>.
   // Several sequences are std::vector<std::vector<SortedRun>>.
   static std::vector<std::vector<SortedRun>> CalculateSortedRuns(
       const VersionStorageInfo& vstorage,
       const ImmutableCFOptions& ioptions,
-      uint64_t max_file_size);
+      const MutableCFOptions& mutable_cf_options,
+      const CompactionFileFilter* file_filter);
+
+  // Returns the level 0 files that the compaction file filter considers expired and that can be
+  // deleted without reading them, oldest first. Those are the longest run of expired files not
+  // being compacted that ends with the oldest file, so that deleting them cannot expose older
+  // versions of their entries.
+  static std::vector<FileMetaData*> ExpiredFiles(
+      const VersionStorageInfo& vstorage,
+      const CompactionFileFilter& file_filter);
 
   // Pick a path ID to place a newly generated file, with its estimated file
   // size.
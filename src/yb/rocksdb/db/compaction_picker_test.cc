@@ -415,6 +415,124 @@ TEST_F(CompactionPickerTest, NeedsCompactionUniversal) {
               vstorage_->CompactionScore(0) >= 1);
   }
 }
+namespace {
+
+// Considers files whose entries all have sequence numbers below a threshold expired, and groups
+// files into time windows of 1000 sequence numbers.
+class SeqNoCompactionFileFilter : public CompactionFileFilter {
+ public:
+  explicit SeqNoCompactionFileFilter(SequenceNumber expired_seqno)
+      : expired_seqno_(expired_seqno) {}
+
+  bool Expired(const FileBoundaryValuesBase& smallest,
+               const FileBoundaryValuesBase& largest) const override {
+    return largest.seqno < expired_seqno_;
+  }
+
+  uint64_t TimeWindow(const FileBoundaryValuesBase& smallest,
+                      const FileBoundaryValuesBase& largest) const override {
+    return largest.seqno / 1000;
+  }
+
+ private:
+  const SequenceNumber expired_seqno_;
+};
+
+class SeqNoCompactionFileFilterFactory : public CompactionFileFilterFactory {
+ public:
+  std::unique_ptr<CompactionFileFilter> CreateCompactionFileFilter() override {
+    return std::make_unique<SeqNoCompactionFileFilter>(expired_seqno);
+  }
+
+  const char* Name() const override { return "SeqNoCompactionFileFilterFactory"; }
+
+  SequenceNumber expired_seqno = 0;
+};
+
+} // namespace
+
+TEST_F(CompactionPickerTest, UniversalExpiredFiles) {
+  const uint64_t kFileSize = 100000;
+
+  SeqNoCompactionFileFilterFactory file_filter_factory;
+  ioptions_.compaction_file_filter_factory = &file_filter_factory;
+  UniversalCompactionPicker universal_compaction_picker(ioptions_, &icmp_);
+
+  NewVersionStorage(1, kCompactionStyleUniversal);
+  Add(0, 1U, "150", "200", kFileSize, 0, 2500, 2550);
+  Add(0, 2U, "201", "250", kFileSize, 0, 2401, 2450);
+  Add(0, 3U, "260", "300", kFileSize, 0, 1260, 1300);
+  Add(0, 4U, "301", "350", kFileSize, 0, 1101, 1150);
+  Add(0, 5U, "120", "200", kFileSize, 0, 1020, 1100);
+  UpdateVersionStorageInfo();
+
+  // There are enough files to trigger a compaction, but not within one time window.
+  file_filter_factory.expired_seqno = 1000;
+  ASSERT_TRUE(universal_compaction_picker.NeedsCompaction(vstorage_.get()));
+  std::unique_ptr<Compaction> compaction(universal_compaction_picker.PickCompaction(
+      cf_name_, mutable_cf_options_, vstorage_.get(), &log_buffer_));
+  ASSERT_TRUE(compaction == nullptr);
+
+  // The oldest files have expired and are deleted without being compacted.
+  file_filter_factory.expired_seqno = 1200;
+  compaction.reset(universal_compaction_picker.PickCompaction(
+      cf_name_, mutable_cf_options_, vstorage_.get(), &log_buffer_));
+  ASSERT_TRUE(compaction != nullptr);
+  ASSERT_TRUE(compaction->deletion_compaction());
+  ASSERT_EQ(CompactionReason::kUniversalExpiredFiles, compaction->compaction_reason());
+  ASSERT_EQ(2U, compaction->num_input_files(0));
+  ASSERT_EQ(5U, compaction->input(0, 0)->fd.GetNumber());
+  ASSERT_EQ(4U, compaction->input(0, 1)->fd.GetNumber());
+
+  // Files being compacted are not picked again.
+  compaction.reset(universal_compaction_picker.PickCompaction(
+      cf_name_, mutable_cf_options_, vstorage_.get(), &log_buffer_));
+  ASSERT_TRUE(compaction == nullptr);
+}
+
+TEST_F(CompactionPickerTest, UniversalTimeWindowsDoNotStallWrites) {
+  const uint64_t kFileSize = 100000;
+  const int kFilesPerTimeWindow = 4;
+
+  SeqNoCompactionFileFilterFactory file_filter_factory;
+  ioptions_.compaction_file_filter_factory = &file_filter_factory;
+  mutable_cf_options_.level0_file_num_compaction_trigger = 5;
+  mutable_cf_options_.level0_slowdown_writes_trigger = 24;
+  mutable_cf_options_.level0_stop_writes_trigger = 48;
+  UniversalCompactionPicker universal_compaction_picker(ioptions_, &icmp_);
+
+  // Adds closed time windows with one file less than the compaction trigger each, newest first.
+  auto add_time_windows = [this](int num_time_windows) {
+    NewVersionStorage(1, kCompactionStyleUniversal);
+    uint32_t file_number = 1;
+    for (int window = num_time_windows; window > 0; --window) {
+      for (int i = kFilesPerTimeWindow; i > 0; --i) {
+        const SequenceNumber seqno = window * 1000 + i * 10;
+        Add(0, file_number++, "150", "200", kFileSize, 0, seqno, seqno + 5);
+      }
+    }
+    UpdateVersionStorageInfo();
+  };
+
+  // The files fit below the slowdown trigger, so time windows are kept apart.
+  add_time_windows(4);
+  std::unique_ptr<Compaction> compaction(universal_compaction_picker.PickCompaction(
+      cf_name_, mutable_cf_options_, vstorage_.get(), &log_buffer_));
+  ASSERT_TRUE(compaction == nullptr);
+
+  // With more time windows, the oldest ones are compacted together instead of letting the number
+  // of files reach the slowdown trigger.
+  add_time_windows(6);
+  compaction.reset(universal_compaction_picker.PickCompaction(
+      cf_name_, mutable_cf_options_, vstorage_.get(), &log_buffer_));
+  ASSERT_TRUE(compaction != nullptr);
+  ASSERT_FALSE(compaction->deletion_compaction());
+  ASSERT_GE(compaction->num_input_files(0), 5U);
+  for (size_t i = 0; i != compaction->num_input_files(0); ++i) {
+    ASSERT_LT(compaction->input(0, i)->largest.seqno, 3000U);
+  }
+}
+
 // Tests if the files can be trivially moved in multi level
 // universal compaction when allow_trivial_move option is set
 // In this test as the input files overlaps, they cannot
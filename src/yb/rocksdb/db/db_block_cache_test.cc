@@ -185,6 +185,51 @@ TEST_F(DBBlockCacheTest, TestWithoutCompressedBlockCache) {
   }
 }
 
+TEST_F(DBBlockCacheTest, TestScanReadahead) {
+  constexpr size_t kReadaheadSize = 4 * 1024;
+  auto table_options = GetTableOptions();
+  table_options.block_cache = NewLRUCache(1024 * 1024, 0, false);
+  auto options = GetOptions(table_options);
+  InitTable(options);
+  Reopen(options);
+
+  // Point reads do not read ahead.
+  ReadOptions read_options;
+  read_options.readahead_size = kReadaheadSize;
+  read_options.fill_cache = false;
+  for (size_t i = 0; i < kNumBlocks; i += 2) {
+    std::unique_ptr<Iterator> iter(db_->NewIterator(read_options));
+    iter->Seek(ToString(i));
+    ASSERT_TRUE(iter->Valid());
+  }
+  ASSERT_EQ(0, TestGetTickerCount(options, BLOCK_READAHEAD_BYTES));
+
+  // A scan reads ahead once it reads data blocks sequentially, and only once per readahead_size
+  // bytes. With fill_cache off, the blocks it reads are not added to the block cache.
+  const size_t inserts_before_scan = TestGetTickerCount(options, BLOCK_CACHE_ADD);
+  {
+    std::unique_ptr<Iterator> iter(db_->NewIterator(read_options));
+    size_t num_keys = 0;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      ++num_keys;
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(kNumBlocks, num_keys);
+  }
+  ASSERT_EQ(kReadaheadSize, TestGetTickerCount(options, BLOCK_READAHEAD_BYTES));
+  ASSERT_EQ(inserts_before_scan, TestGetTickerCount(options, BLOCK_CACHE_ADD));
+
+  // A scan over blocks found in the block cache does not read ahead.
+  read_options.fill_cache = true;
+  for (int i = 0; i != 2; ++i) {
+    std::unique_ptr<Iterator> iter(db_->NewIterator(read_options));
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+    }
+    ASSERT_OK(iter->status());
+  }
+  ASSERT_EQ(2 * kReadaheadSize, TestGetTickerCount(options, BLOCK_READAHEAD_BYTES));
+}
+
 #ifdef SNAPPY
 TEST_F(DBBlockCacheTest, TestWithCompressedBlockCache) {
   ReadOptions read_options;
@@ -152,6 +152,10 @@ class InternalKeyComparator : public Comparator {
 
   const Comparator* user_comparator() const { return user_comparator_; }
 
+  virtual bool IsBytewiseInternalKeyComparator() const override {
+    return user_comparator_ == BytewiseComparator();
+  }
+
   int Compare(const InternalKey& a, const InternalKey& b) const;
   int Compare(const ParsedInternalKey& a, const ParsedInternalKey& b) const;
 };
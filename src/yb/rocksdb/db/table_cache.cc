@@ -80,8 +80,8 @@ void AppendVarint64(IterKey* key, uint64_t v) {
 }  // namespace
 
 TableCache::TableCache(const ImmutableCFOptions& ioptions,
-    const EnvOptions& env_options, Cache* const cache)
-    : ioptions_(ioptions), env_options_(env_options), cache_(cache) {
+    const EnvOptions& env_options, Cache* const cache, const std::string& db_identity)
+    : ioptions_(ioptions), env_options_(env_options), cache_(cache), db_identity_(db_identity) {
   if (ioptions_.row_cache) {
     // If the same cache is shared by multiple instances, we need to
     // disambiguate its entries.
@@ -147,9 +147,14 @@ Status TableCache::GetTableReader(
     if (!s.ok()) {
       return s;
     }
+    TableReaderOptions table_reader_options(
+        ioptions_, env_options, internal_comparator, skip_filters);
+    if (!db_identity_.empty()) {
+      PutLengthPrefixedSlice(&table_reader_options.unique_file_id, db_identity_);
+      PutVarint64(&table_reader_options.unique_file_id, fd.GetNumber());
+    }
     s = ioptions_.table_factory->NewTableReader(
-        TableReaderOptions(ioptions_, env_options, internal_comparator, skip_filters),
-        std::move(base_file_reader), fd.GetBaseFileSize(), table_reader);
+        table_reader_options, std::move(base_file_reader), fd.GetBaseFileSize(), table_reader);
     if (!s.ok()) {
       return s;
     }
@@ -50,8 +50,12 @@ class InternalIterator;
 
 class TableCache {
  public:
+  // db_identity is the identity of the DB the tables belong to, see DB::GetDbIdentity. If not empty,
+  // table readers get an id that identifies the file across restarts, see
+  // TableReaderOptions::unique_file_id.
   TableCache(const ImmutableCFOptions& ioptions,
-             const EnvOptions& storage_options, Cache* cache);
+             const EnvOptions& storage_options, Cache* cache,
+             const std::string& db_identity = std::string());
   ~TableCache();
 
   struct TableReaderWithHandle {
@@ -166,6 +170,7 @@ class TableCache {
   const ImmutableCFOptions& ioptions_;
   const EnvOptions& env_options_;
   Cache* const cache_;
+  const std::string db_identity_;
   std::string row_cache_id_;
 };
 
@@ -104,6 +104,14 @@ struct EnvOptions {
   // If true, then use mmap to write data
   bool use_mmap_writes = true;
 
+  // If true, then open files for reading with O_DIRECT where supported. Ignored together with
+  // use_mmap_reads.
+  bool use_direct_reads = false;
+
+  // If true, then open files for writing with O_DIRECT where supported. Ignored together with
+  // use_mmap_writes.
+  bool use_direct_writes = false;
+
   // If false, fallocate() calls are bypassed
   bool allow_fallocate = true;
 
@@ -385,6 +393,17 @@ class Env {
   virtual EnvOptions OptimizeForManifestWrite(const EnvOptions& env_options)
       const;
 
+  // OptimizeForCompactionTableWrite will create a new EnvOptions object that is a copy of the
+  // EnvOptions in the parameters, but is optimized for writing SST files from flush and
+  // compaction. Default implementation enables direct writes when requested by db_options.
+  virtual EnvOptions OptimizeForCompactionTableWrite(const EnvOptions& env_options,
+                                                     const DBOptions& db_options) const;
+  // OptimizeForCompactionTableRead will create a new EnvOptions object that is a copy of the
+  // EnvOptions in the parameters, but is optimized for reading compaction inputs. Default
+  // implementation enables direct reads when requested by db_options.
+  virtual EnvOptions OptimizeForCompactionTableRead(const EnvOptions& env_options,
+                                                    const DBOptions& db_options) const;
+
   // Returns the status of all threads that belong to the current Env.
   virtual Status GetThreadList(std::vector<ThreadStatus>* thread_list) {
     return STATUS(NotSupported, "Not supported.");
@@ -467,6 +486,15 @@ class RandomAccessFile : public File {
   virtual Status Read(uint64_t offset, size_t n, Slice* result,
                       char* scratch) const = 0;
 
+  // Starts fetching "n" bytes at "offset" into the OS page cache without waiting for the I/O to
+  // complete, so that a following Read() of the range does not block on the device. Issuing
+  // prefetches for several ranges before reading them lets the device serve them in parallel.
+  //
+  // Safe for concurrent use by multiple threads.
+  virtual Status Prefetch(uint64_t offset, size_t n) {
+    return STATUS(NotSupported, "Prefetch not supported.");
+  }
+
   // Used by the file_reader_writer to decide if the ReadAhead wrapper
   // should simply forward the call and do not enact buffering or locking.
   virtual bool ShouldForwardRawRequest() const {
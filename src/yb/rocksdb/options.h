@@ -48,6 +48,7 @@ class BoundaryValuesExtractor;
 class Cache;
 class CompactionFilter;
 class CompactionFilterFactory;
+class CompactionFileFilterFactory;
 class Comparator;
 class Env;
 enum InfoLogLevel : unsigned char;
@@ -256,6 +257,14 @@ struct ColumnFamilyOptions {
   // Default: nullptr
   std::shared_ptr<CompactionFilterFactory> compaction_filter_factory;
 
+  // This is a factory that provides compaction file filter objects which allow universal
+  // compaction to delete SST files whose entries are all obsolete without reading them.
+  //
+  // A new filter will be created each time a compaction is picked.
+  //
+  // Default: nullptr
+  std::shared_ptr<CompactionFileFilterFactory> compaction_file_filter_factory;
+
   // -------------------
   // Parameters that affect performance
 
@@ -1137,6 +1146,16 @@ struct DBOptions {
   // Default: false
   bool new_table_reader_for_compaction_inputs;
 
+  // If true, SST files written by flush and compaction, and compaction input files, are accessed
+  // with O_DIRECT so that they do not go through (and evict hot pages from) the OS page cache.
+  // Falls back to buffered I/O where the file system does not support O_DIRECT.
+  //
+  // When true, we also force new_table_reader_for_compaction_inputs to true and, if
+  // compaction_readahead_size is zero, set it to 2MB.
+  //
+  // Default: false
+  bool use_direct_io_for_flush_and_compaction;
+
   // If non-zero, we perform bigger reads when doing compaction. If you're
   // running RocksDB on spinning disks, you should set this to at least 2MB.
   // That way RocksDB's compaction is doing sequential instead of random reads.
@@ -1380,6 +1399,13 @@ struct ReadOptions {
   // Default: true
   bool fill_cache;
 
+  // If non-zero, an iterator that reads the data blocks of an SST file one after another starts
+  // reading this many bytes of the file ahead of the block it needs (see
+  // RandomAccessFile::Prefetch), so that the following blocks are already in the OS page cache
+  // when the iterator gets to them. Callers may wish to set this field for long range scans.
+  // Default: 0
+  size_t readahead_size;
+
   // If this option is set and memtable implementation allows, Seek
   // might only return keys with the same prefix as the seek-key
   //
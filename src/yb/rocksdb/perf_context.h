@@ -50,6 +50,12 @@ struct PerfContext {
   uint64_t internal_key_skipped_count;
   // total number of deletes and single deletes skipped over during iteration
   uint64_t internal_delete_skipped_count;
+  // total number of Seek(), SeekToFirst() and SeekToLast() calls on iterators
+  uint64_t iter_seek_count;
+  // total number of Next() calls on iterators
+  uint64_t iter_next_count;
+  // total number of Prev() calls on iterators
+  uint64_t iter_prev_count;
 
   uint64_t get_snapshot_time;       // total nanos spent on getting snapshot
   uint64_t get_from_memtable_time;  // total nanos spent on querying memtables
@@ -0,0 +1,64 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+// A PersistentCache is a secondary block cache that lives on a (usually fast, local) storage
+// device. Unlike Cache it stores raw bytes rather than parsed objects, so its contents can be kept
+// across process restarts. The block based table reader consults it on a miss in the in-memory
+// block cache before reading from the SST file itself, keying blocks by the DB identity, SST file
+// number and block offset, which stay valid across restarts.
+
+#ifndef YB_ROCKSDB_PERSISTENT_CACHE_H
+#define YB_ROCKSDB_PERSISTENT_CACHE_H
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+
+#include "yb/rocksdb/status.h"
+#include "yb/util/slice.h"
+
+namespace rocksdb {
+
+class Env;
+class Logger;
+
+class PersistentCache {
+ public:
+  virtual ~PersistentCache() {}
+
+  // Stores a copy of data[0..size-1] under the given key. Inserting a key that is already present
+  // replaces the previous value.
+  virtual Status Insert(const Slice& key, const char* data, size_t size) = 0;
+
+  // Looks up the key. On success *data holds a newly allocated copy of the value and *size its
+  // length. Returns NotFound if the key is not in the cache.
+  virtual Status Lookup(const Slice& key, std::unique_ptr<char[]>* data, size_t* size) = 0;
+
+  // Returns the number of bytes currently used on the cache device.
+  virtual size_t GetUsage() const = 0;
+
+  // Returns the configured capacity of the cache, in bytes.
+  virtual size_t GetCapacity() const = 0;
+};
+
+// Creates a persistent cache backed by files in the given directory, bounded by capacity bytes.
+// Inserts are written to the files in the background and may be rejected with Busy while too many
+// writes are pending. Entries written by a previous instance using the same directory are loaded
+// back, so they survive restarts.
+Status NewFilePersistentCache(Env* env, const std::string& path, size_t capacity,
+                              const std::shared_ptr<Logger>& info_log,
+                              std::shared_ptr<PersistentCache>* cache);
+
+}  // namespace rocksdb
+
+#endif  // YB_ROCKSDB_PERSISTENT_CACHE_H
@@ -205,6 +205,16 @@ enum Tickers : uint32_t {
   BLOCK_CACHE_MULTI_TOUCH_BYTES_READ,
   BLOCK_CACHE_MULTI_TOUCH_BYTES_WRITE,
 
+  // Persistent (on-device) block cache statistics.
+  PERSISTENT_CACHE_HIT,
+  PERSISTENT_CACHE_MISS,
+  PERSISTENT_CACHE_ADD,
+  PERSISTENT_CACHE_ADD_FAILURES,
+
+  // Number of bytes of data files that iterators reading data blocks sequentially asked to read
+  // ahead (see ReadOptions::readahead_size).
+  BLOCK_READAHEAD_BYTES,
+
   // End of ticker enum.
   TICKER_ENUM_MAX,
 };
@@ -298,7 +308,12 @@ const std::vector<std::pair<Tickers, std::string>> TickersNameMap = {
     {BLOCK_CACHE_MULTI_TOUCH_HIT, "rocksdb_block_cache_multi_touch_hit"},
     {BLOCK_CACHE_MULTI_TOUCH_ADD, "rocksdb_block_cache_multi_touch_add"},
     {BLOCK_CACHE_MULTI_TOUCH_BYTES_READ, "rocksdb_block_cache_multi_touch_bytes_read"},
-    {BLOCK_CACHE_MULTI_TOUCH_BYTES_WRITE, "rocksdb_block_cache_multi_touch_bytes_write"}
+    {BLOCK_CACHE_MULTI_TOUCH_BYTES_WRITE, "rocksdb_block_cache_multi_touch_bytes_write"},
+    {PERSISTENT_CACHE_HIT, "rocksdb_persistent_cache_hit"},
+    {PERSISTENT_CACHE_MISS, "rocksdb_persistent_cache_miss"},
+    {PERSISTENT_CACHE_ADD, "rocksdb_persistent_cache_add"},
+    {PERSISTENT_CACHE_ADD_FAILURES, "rocksdb_persistent_cache_add_failures"},
+    {BLOCK_READAHEAD_BYTES, "rocksdb_block_readahead_bytes"}
 };
 
 /**
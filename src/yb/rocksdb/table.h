@@ -46,6 +46,7 @@ namespace rocksdb {
 
 // -- Block-based Table
 class FlushBlockPolicyFactory;
+class PersistentCache;
 class RandomAccessFile;
 struct TableReaderOptions;
 struct TableBuilderOptions;
@@ -118,6 +119,11 @@ struct BlockBasedTableOptions {
   // If NULL, rocksdb will not use a compressed block cache.
   std::shared_ptr<Cache> block_cache_compressed = nullptr;
 
+  // If non-NULL use the specified persistent cache for data blocks. It is consulted on a miss in
+  // the block caches before reading from the SST file, and is filled with the raw (possibly
+  // compressed) blocks read from files.
+  std::shared_ptr<PersistentCache> persistent_cache = nullptr;
+
   // Approximate size of user data packed per block, in bytes. Note that the
   // block size specified here corresponds to uncompressed data.  The
   // actual size of the unit read from disk may be smaller if
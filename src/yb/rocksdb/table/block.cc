@@ -25,12 +25,18 @@
 
 #include "yb/rocksdb/table/block.h"
 
+#include <string.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 #include <algorithm>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 #include "yb/rocksdb/comparator.h"
+#include "yb/rocksdb/port/port.h"
 #include "yb/rocksdb/table/format.h"
 #include "yb/rocksdb/table/block_hash_index.h"
 #include "yb/rocksdb/table/block_prefix_index.h"
@@ -70,6 +76,60 @@ static inline const char* DecodeEntry(const char* p, const char* limit,
   return p;
 }
 
+// Size of the sequence number and type trailer of an internal key.
+static constexpr size_t kInternalKeyTrailerSize = 8;
+
+// Returns the length of the longest common prefix of a[0..n-1] and b[0..n-1]. Keys in DocDB share
+// long prefixes (hash and hashed components), so this compares 16 bytes per step where SSE2 is
+// available and a machine word per step otherwise.
+static inline size_t CommonPrefixLength(const char* a, const char* b, size_t n) {
+  size_t i = 0;
+#ifdef __SSE2__
+  for (; i + 16 <= n; i += 16) {
+    const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+    const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+    const unsigned int mismatch = _mm_movemask_epi8(_mm_cmpeq_epi8(va, vb)) ^ 0xffff;
+    if (mismatch != 0) {
+      return i + __builtin_ctz(mismatch);
+    }
+  }
+#endif
+  for (; i + sizeof(uint64_t) <= n; i += sizeof(uint64_t)) {
+    uint64_t wa, wb;
+    memcpy(&wa, a + i, sizeof(wa));
+    memcpy(&wb, b + i, sizeof(wb));
+    const uint64_t diff = wa ^ wb;
+    if (diff != 0) {
+      return i + (port::kLittleEndian ? __builtin_ctzll(diff) : __builtin_clzll(diff)) / 8;
+    }
+  }
+  while (i < n && a[i] == b[i]) {
+    ++i;
+  }
+  return i;
+}
+
+int BlockIter::CompareWithTarget(const Slice& key, const Slice& target, size_t known_prefix,
+                                 size_t* prefix) const {
+  if (!bytewise_internal_keys_ || key.size() < kInternalKeyTrailerSize ||
+      target.size() < kInternalKeyTrailerSize) {
+    *prefix = 0;
+    return Compare(key, target);
+  }
+  const size_t min_size = std::min(key.size(), target.size());
+  known_prefix = std::min(known_prefix, min_size);
+  const size_t common = known_prefix + CommonPrefixLength(
+      key.cdata() + known_prefix, target.cdata() + known_prefix, min_size - known_prefix);
+  *prefix = common;
+  if (common < min_size - kInternalKeyTrailerSize) {
+    // The first difference is within both user keys, so it decides the order.
+    PERF_COUNTER_ADD(user_key_comparison_count, 1);
+    return key[common] < target[common] ? -1 : 1;
+  }
+  // One user key is a prefix of the other, or they are equal, let the comparator sort it out.
+  return Compare(key, target);
+}
+
 void BlockIter::Next() {
   assert(Valid());
   ParseNextKey();
@@ -114,10 +174,14 @@ void BlockIter::Seek(const Slice& target) {
     return;
   }
   SeekToRestartPoint(index);
-  // Linear search (within restart block) for first key >= target
-
+  // Linear search (within restart block) for first key >= target.
+  // Each key shares its first `shared` bytes with the previous one, which shares `prefix` bytes with
+  // the target, so at least the smaller of the two is known to match the target.
+  size_t prefix = 0;
+  uint32_t shared = 0;
   while (true) {
-    if (!ParseNextKey() || Compare(key_.GetKey(), target) >= 0) {
+    if (!ParseNextKey(&shared) ||
+        CompareWithTarget(key_.GetKey(), target, std::min<size_t>(shared, prefix), &prefix) >= 0) {
       return;
     }
   }
@@ -149,7 +213,7 @@ void BlockIter::CorruptionError() {
   value_.clear();
 }
 
-bool BlockIter::ParseNextKey() {
+bool BlockIter::ParseNextKey(uint32_t* shared_out) {
   current_ = NextEntryOffset();
   const char* p = data_ + current_;
   const char* limit = data_ + restarts_;  // Restarts come right after data
@@ -176,6 +240,9 @@ bool BlockIter::ParseNextKey() {
       key_.TrimAppend(shared, p, non_shared);
     }
     value_ = Slice(p + non_shared, value_length);
+    if (shared_out != nullptr) {
+      *shared_out = shared;
+    }
     while (restart_index_ + 1 < num_restarts_ &&
            GetRestartPoint(restart_index_ + 1) < current_) {
       ++restart_index_;
@@ -190,6 +257,10 @@ bool BlockIter::BinarySeek(const Slice& target, uint32_t left, uint32_t right,
                   uint32_t* index) {
   assert(left <= right);
 
+  // Restart keys in [left, right] lie between two keys that share left_prefix and right_prefix
+  // bytes of their user keys with the target, so they all share the smaller of the two with it.
+  size_t left_prefix = 0;
+  size_t right_prefix = 0;
   while (left < right) {
     uint32_t mid = (left + right + 1) / 2;
     uint32_t region_offset = GetRestartPoint(mid);
@@ -202,15 +273,22 @@ bool BlockIter::BinarySeek(const Slice& target, uint32_t left, uint32_t right,
       return false;
     }
     Slice mid_key(key_ptr, non_shared);
-    int cmp = Compare(mid_key, target);
+    size_t prefix = 0;
+    int cmp = CompareWithTarget(
+        mid_key, target, std::min(left_prefix, right_prefix), &prefix);
+    if (prefix != 0) {
+      prefix = std::min(prefix, mid_key.size() - kInternalKeyTrailerSize);
+    }
     if (cmp < 0) {
       // Key at "mid" is smaller than "target". Therefore all
       // blocks before "mid" are uninteresting.
       left = mid;
+      left_prefix = prefix;
     } else if (cmp > 0) {
       // Key at "mid" is >= "target". Therefore all blocks at or
       // after "mid" are uninteresting.
       right = mid - 1;
+      right_prefix = prefix;
     } else {
       left = right = mid;
     }
@@ -108,6 +108,7 @@ class BlockIter : public InternalIterator {
  public:
   BlockIter()
       : comparator_(nullptr),
+        bytewise_internal_keys_(false),
         data_(nullptr),
         restarts_(0),
         num_restarts_(0),
@@ -132,6 +133,8 @@ class BlockIter : public InternalIterator {
     assert(num_restarts > 0);           // Ensure the param is valid
 
     comparator_ = comparator;
+    bytewise_internal_keys_ =
+        comparator != nullptr && comparator->IsBytewiseInternalKeyComparator();
     data_ = data;
     restarts_ = restarts;
     num_restarts_ = num_restarts;
@@ -180,6 +183,9 @@ class BlockIter : public InternalIterator {
 
  private:
   const Comparator* comparator_;
+  // Whether comparator_ allows comparing keys by their first differing byte, see
+  // Comparator::IsBytewiseInternalKeyComparator.
+  bool bytewise_internal_keys_;
   const char* data_;       // underlying block contents
   uint32_t restarts_;      // Offset of restart array (list of fixed32)
   uint32_t num_restarts_;  // Number of uint32_t entries in restart array
@@ -197,6 +203,13 @@ class BlockIter : public InternalIterator {
     return comparator_->Compare(a, b);
   }
 
+  // Compares key with the seek target, like Compare does. known_prefix is the length of a prefix
+  // the caller knows key and target to share, and *prefix is set to the length of a prefix they
+  // share after the comparison. With bytewise ordered internal keys the known prefix is skipped
+  // and the comparison is a vectorized search for the first differing byte.
+  int CompareWithTarget(const Slice& key, const Slice& target, size_t known_prefix,
+                        size_t* prefix) const;
+
   // Return the offset in data_ just past the end of the current entry.
   inline uint32_t NextEntryOffset() const {
     // NOTE: We don't support files bigger than 2GB
@@ -220,7 +233,9 @@ class BlockIter : public InternalIterator {
 
   void CorruptionError();
 
-  bool ParseNextKey();
+  // Decodes the entry following the current one. If shared is not null, it is set to the number of
+  // key bytes the new entry shares with the previous one.
+  bool ParseNextKey(uint32_t* shared = nullptr);
 
   bool BinarySeek(const Slice& target, uint32_t left, uint32_t right,
                   uint32_t* index);
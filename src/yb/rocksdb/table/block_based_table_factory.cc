@@ -31,6 +31,7 @@
 #include "yb/rocksdb/port/port.h"
 #include "yb/rocksdb/flush_block_policy.h"
 #include "yb/rocksdb/cache.h"
+#include "yb/rocksdb/persistent_cache.h"
 #include "yb/rocksdb/table/block_based_table_builder.h"
 #include "yb/rocksdb/table/block_based_table_reader.h"
 #include "yb/rocksdb/table/format.h"
@@ -78,7 +79,7 @@ Status BlockBasedTableFactory::NewTableReader(
       table_reader_options.ioptions, table_reader_options.env_options,
       table_options_, table_reader_options.internal_comparator, std::move(base_file),
       base_file_size, table_reader, prefetch_data_index, prefetch_filter,
-      table_reader_options.skip_filters);
+      table_reader_options.skip_filters, table_reader_options.unique_file_id);
 }
 
 TableBuilder* BlockBasedTableFactory::NewTableBuilder(
@@ -165,6 +166,15 @@ std::string BlockBasedTableFactory::GetPrintableTableOptions() const {
              table_options_.block_cache_compressed->GetCapacity());
     ret.append(buffer);
   }
+  snprintf(buffer, kBufferSize, "  persistent_cache: %p\n",
+           table_options_.persistent_cache.get());
+  ret.append(buffer);
+  if (table_options_.persistent_cache) {
+    snprintf(buffer, kBufferSize,
+             "  persistent_cache_size: %" ROCKSDB_PRIszt "\n",
+             table_options_.persistent_cache->GetCapacity());
+    ret.append(buffer);
+  }
   snprintf(buffer, kBufferSize, "  block_size: %" ROCKSDB_PRIszt "\n",
            table_options_.block_size);
   ret.append(buffer);
@@ -23,10 +23,13 @@
 
 #include "yb/rocksdb/table/block_based_table_reader.h"
 
+#include <algorithm>
 #include <string>
 #include <utility>
 #include <cinttypes>
 
+#include <gflags/gflags.h>
+
 #include "yb/rocksdb/db/dbformat.h"
 
 #include "yb/rocksdb/cache.h"
@@ -35,6 +38,7 @@
 #include "yb/rocksdb/filter_policy.h"
 #include "yb/rocksdb/iterator.h"
 #include "yb/rocksdb/options.h"
+#include "yb/rocksdb/persistent_cache.h"
 #include "yb/rocksdb/statistics.h"
 #include "yb/rocksdb/table.h"
 #include "yb/rocksdb/table_properties.h"
@@ -61,9 +65,17 @@
 #include "yb/rocksdb/util/stop_watch.h"
 #include "yb/rocksdb/util/string_util.h"
 
+#include "yb/gutil/basictypes.h"
 #include "yb/gutil/macros.h"
 #include "yb/util/logging.h"
 #include "yb/util/atomic.h"
+#include "yb/util/size_literals.h"
+
+using yb::operator"" _MB;
+
+DEFINE_uint64(rocksdb_max_prefetch_bytes_per_call, 16_MB,
+              "Maximum number of bytes of data blocks read into the block cache by a single "
+              "table Prefetch call. Blocks that are already cached do not count.");
 
 namespace rocksdb {
 
@@ -146,6 +158,12 @@ struct BlockBasedTable::FileReaderWithCachePrefix {
   // Similar prefix, but for compressed blocks cache:
   block_based_table::CacheKeyBuffer compressed_cache_key_prefix;
 
+  // Similar prefix, but for persistent cache. Its entries outlive the process and file ids such as
+  // inode numbers can be reused after a restart, so this prefix is built from the table's
+  // unique_file_id (DB identity and file number) and whether the reader is for the base or the
+  // data file. Empty if the table has no unique_file_id, then the persistent cache is not used.
+  std::string persistent_cache_key_prefix;
+
   explicit FileReaderWithCachePrefix(unique_ptr<RandomAccessFileReader>&& _reader) :
       reader(std::move(_reader)) {}
 };
@@ -203,6 +221,8 @@ struct BlockBasedTable::Rep {
   Status status;
   std::shared_ptr<FileReaderWithCachePrefix> base_reader_with_cache_prefix;
   std::shared_ptr<FileReaderWithCachePrefix> data_reader_with_cache_prefix;
+  // See TableReaderOptions::unique_file_id.
+  std::string unique_file_id;
 
   // Footer contains the fixed table information
   Footer footer;
@@ -238,6 +258,7 @@ void BlockBasedTable::SetupCacheKeyPrefix(Rep* rep,
     FileReaderWithCachePrefix* reader_with_cache_prefix) {
   reader_with_cache_prefix->cache_key_prefix.size = 0;
   reader_with_cache_prefix->compressed_cache_key_prefix.size = 0;
+  reader_with_cache_prefix->persistent_cache_key_prefix.clear();
   if (rep->table_options.block_cache != nullptr) {
     GenerateCachePrefix(rep->table_options.block_cache.get(),
         reader_with_cache_prefix->reader->file(),
@@ -248,6 +269,13 @@ void BlockBasedTable::SetupCacheKeyPrefix(Rep* rep,
         reader_with_cache_prefix->reader->file(),
         &reader_with_cache_prefix->compressed_cache_key_prefix);
   }
+  if (rep->table_options.persistent_cache != nullptr && !rep->unique_file_id.empty()) {
+    auto* prefix = &reader_with_cache_prefix->persistent_cache_key_prefix;
+    *prefix = rep->unique_file_id;
+    const bool is_data_file = rep->base_reader_with_cache_prefix != nullptr &&
+                              reader_with_cache_prefix != rep->base_reader_with_cache_prefix.get();
+    prefix->push_back(is_data_file ? '\1' : '\0');
+  }
 }
 
 BloomFilterAwareFileFilter::BloomFilterAwareFileFilter(
@@ -306,7 +334,8 @@ Status BlockBasedTable::Open(const ImmutableCFOptions& ioptions,
                              unique_ptr<TableReader>* table_reader,
                              DataIndexLoadMode data_index_load_mode,
                              PrefetchFilter prefetch_filter,
-                             const bool skip_filters) {
+                             const bool skip_filters,
+                             const std::string& unique_file_id) {
   table_reader->reset();
 
   Footer footer;
@@ -331,6 +360,7 @@ Status BlockBasedTable::Open(const ImmutableCFOptions& ioptions,
   rep->footer = footer;
   rep->index_type = table_options.index_type;
   rep->hash_index_allow_collision = table_options.hash_index_allow_collision;
+  rep->unique_file_id = unique_file_id;
   SetupCacheKeyPrefix(rep, rep->base_reader_with_cache_prefix.get());
   unique_ptr<BlockBasedTable> new_table(new BlockBasedTable(rep));
 
@@ -990,6 +1020,41 @@ InternalIterator* BlockBasedTable::NewIndexIterator(
 // If input_iter is not null, update this iter and return it
 InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
     const Slice& index_value, BlockIter* input_iter) {
+  return NewDataBlockIterator(ro, index_value, input_iter, nullptr /* readahead_state */);
+}
+
+void BlockBasedTable::ReadaheadState::RecordAccess(const BlockHandle& handle) {
+  if (handle.offset() == next_block_offset) {
+    ++num_sequential_blocks;
+  } else {
+    num_sequential_blocks = 1;
+  }
+  next_block_offset = handle.offset() + handle.size() + kBlockTrailerSize;
+}
+
+void BlockBasedTable::MaybeReadahead(const ReadOptions& read_options, const BlockHandle& handle,
+                                     ReadaheadState* readahead_state) {
+  // Number of data blocks that should be accessed one after another before we decide that the
+  // iterator does a sequential scan, so that short scans and point reads do not read ahead.
+  constexpr size_t kMinSequentialBlocksForReadahead = 2;
+
+  if (readahead_state == nullptr || read_options.readahead_size == 0 ||
+      readahead_state->num_sequential_blocks < kMinSequentialBlocksForReadahead ||
+      readahead_state->next_block_offset <= readahead_state->readahead_limit) {
+    return;
+  }
+  const uint64_t readahead_size = std::max<uint64_t>(
+      read_options.readahead_size, handle.size() + kBlockTrailerSize);
+  // Readahead is only a hint and the block is read anyway, so errors (e.g. NotSupported when the
+  // file is not read through the OS page cache) are ignored.
+  ignore_result(rep_->data_reader_with_cache_prefix->reader->Prefetch(
+      handle.offset(), readahead_size));
+  RecordTick(rep_->ioptions.statistics, BLOCK_READAHEAD_BYTES, readahead_size);
+  readahead_state->readahead_limit = handle.offset() + readahead_size;
+}
+
+InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
+    const Slice& index_value, BlockIter* input_iter, ReadaheadState* readahead_state) {
   PERF_TIMER_GUARD(new_table_block_iter_nanos);
 
   const bool no_io = (ro.read_tier == kBlockCacheTier);
@@ -1013,6 +1078,10 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
     }
   }
 
+  if (readahead_state != nullptr) {
+    readahead_state->RecordAccess(handle);
+  }
+
   // If either block cache is enabled, we'll try to read from it.
   if (block_cache != nullptr || block_cache_compressed != nullptr) {
     Statistics* statistics = rep_->ioptions.statistics;
@@ -1037,11 +1106,10 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
 
     if (block.value == nullptr && !no_io && ro.fill_cache) {
       std::unique_ptr<Block> raw_block;
+      MaybeReadahead(ro, handle, readahead_state);
       {
         StopWatch sw(rep_->ioptions.env, statistics, READ_BLOCK_GET_MICROS);
-        s = block_based_table::ReadBlockFromFile(rep_->data_reader_with_cache_prefix->reader.get(),
-            rep_->footer, ro, handle, &raw_block, rep_->ioptions.env,
-            block_cache_compressed == nullptr);
+        s = ReadDataBlock(ro, handle, &raw_block, block_cache_compressed == nullptr);
       }
 
       if (s.ok()) {
@@ -1064,9 +1132,8 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
       }
     }
     std::unique_ptr<Block> block_value;
-    s = block_based_table::ReadBlockFromFile(
-        rep_->data_reader_with_cache_prefix->reader.get(), rep_->footer, ro, handle, &block_value,
-        rep_->ioptions.env);
+    MaybeReadahead(ro, handle, readahead_state);
+    s = ReadDataBlock(ro, handle, &block_value);
     if (s.ok()) {
       block.value = block_value.release();
     }
@@ -1092,6 +1159,65 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
   return iter;
 }
 
+Status BlockBasedTable::ReadDataBlock(const ReadOptions& read_options, const BlockHandle& handle,
+                                      std::unique_ptr<Block>* result, bool do_uncompress) {
+  auto* reader_with_cache_prefix = rep_->data_reader_with_cache_prefix.get();
+  PersistentCache* persistent_cache = rep_->table_options.persistent_cache.get();
+  if (persistent_cache == nullptr ||
+      reader_with_cache_prefix->persistent_cache_key_prefix.empty()) {
+    return block_based_table::ReadBlockFromFile(
+        reader_with_cache_prefix->reader.get(), rep_->footer, read_options, handle, result,
+        rep_->ioptions.env, do_uncompress);
+  }
+
+  Statistics* statistics = rep_->ioptions.statistics;
+  const uint32_t format_version = rep_->table_options.format_version;
+  std::string cache_key = reader_with_cache_prefix->persistent_cache_key_prefix;
+  PutVarint64(&cache_key, handle.offset());
+
+  // Persistent cache entries are the raw block contents followed by the compression type byte,
+  // which is the layout UncompressBlockContents expects.
+  std::unique_ptr<char[]> data;
+  size_t size = 0;
+  if (persistent_cache->Lookup(cache_key, &data, &size).ok() && size == handle.size() + 1) {
+    RecordTick(statistics, PERSISTENT_CACHE_HIT);
+    const auto compression_type = static_cast<CompressionType>(data[size - 1]);
+    BlockContents contents;
+    if (do_uncompress && compression_type != kNoCompression) {
+      RETURN_NOT_OK(UncompressBlockContents(data.get(), size - 1, &contents, format_version));
+    } else {
+      contents = BlockContents(std::move(data), size - 1, true /* cachable */, compression_type);
+    }
+    result->reset(new Block(std::move(contents)));
+    return Status::OK();
+  }
+  RecordTick(statistics, PERSISTENT_CACHE_MISS);
+
+  BlockContents contents;
+  RETURN_NOT_OK(ReadBlockContents(
+      reader_with_cache_prefix->reader.get(), rep_->footer, read_options, handle, &contents,
+      rep_->ioptions.env, false /* do_uncompress */));
+
+  std::string entry;
+  entry.reserve(contents.data.size() + 1);
+  entry.append(contents.data.cdata(), contents.data.size());
+  entry.push_back(static_cast<char>(contents.compression_type));
+  if (persistent_cache->Insert(cache_key, entry.data(), entry.size()).ok()) {
+    RecordTick(statistics, PERSISTENT_CACHE_ADD);
+  } else {
+    RecordTick(statistics, PERSISTENT_CACHE_ADD_FAILURES);
+  }
+
+  if (do_uncompress && contents.compression_type != kNoCompression) {
+    BlockContents uncompressed;
+    RETURN_NOT_OK(UncompressBlockContents(entry.data(), contents.data.size(), &uncompressed,
+                                          format_version));
+    contents = std::move(uncompressed);
+  }
+  result->reset(new Block(std::move(contents)));
+  return Status::OK();
+}
+
 class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
  public:
   BlockEntryIteratorState(BlockBasedTable* table,
@@ -1103,7 +1229,8 @@ class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
         skip_filters_(skip_filters) {}
 
   InternalIterator* NewSecondaryIterator(const Slice& index_value) override {
-    return table_->NewDataBlockIterator(read_options_, index_value);
+    return table_->NewDataBlockIterator(read_options_, index_value, nullptr /* input_iter */,
+                                        &readahead_state_);
   }
 
   bool PrefixMayMatch(const Slice& internal_key) override {
@@ -1118,6 +1245,7 @@ class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
   BlockBasedTable* const table_;
   const ReadOptions read_options_;
   const bool skip_filters_;
+  ReadaheadState readahead_state_;
 };
 
 // This will be broken if the user specifies an unusual implementation
@@ -1336,7 +1464,11 @@ Status BlockBasedTable::Get(const ReadOptions& read_options, const Slice& intern
 }
 
 Status BlockBasedTable::Prefetch(const Slice* const begin,
-                                 const Slice* const end) {
+                                 const Slice* const end,
+                                 std::string* resume_key) {
+  if (resume_key != nullptr) {
+    resume_key->clear();
+  }
   auto& comparator = rep_->internal_comparator;
   // pre-condition
   if (begin && end && comparator.Compare(*begin, *end) > 0) {
@@ -1354,10 +1486,17 @@ Status BlockBasedTable::Prefetch(const Slice* const begin,
   // indicates if we are on the last page that need to be pre-fetched
   bool prefetching_boundary_page = false;
 
+  // Blocks that are already in the block cache are skipped, and at most
+  // FLAGS_rocksdb_max_prefetch_bytes_per_call bytes of blocks are read per call, so that a wide
+  // range does not flood the device and the block cache.
+  Cache* block_cache = rep_->table_options.block_cache.get();
+  const auto& cache_key_prefix = rep_->data_reader_with_cache_prefix->cache_key_prefix;
+  const uint64_t max_prefetch_bytes = FLAGS_rocksdb_max_prefetch_bytes_per_call;
+  uint64_t prefetch_bytes = 0;
+  std::vector<std::string> block_handles;
+  std::vector<BlockHandle> decoded_handles;
   for (begin ? iiter.Seek(*begin) : iiter.SeekToFirst(); iiter.Valid();
        iiter.Next()) {
-    Slice block_handle = iiter.value();
-
     if (end && comparator.Compare(iiter.key(), *end) >= 0) {
       if (prefetching_boundary_page) {
         break;
@@ -1368,6 +1507,49 @@ Status BlockBasedTable::Prefetch(const Slice* const begin,
       prefetching_boundary_page = true;
     }
 
+    BlockHandle handle;
+    Slice input = iiter.value();
+    RETURN_NOT_OK(handle.DecodeFrom(&input));
+    if (block_cache != nullptr) {
+      char cache_key_buffer[block_based_table::kMaxCacheKeyPrefixSize + kMaxVarint64Length];
+      const Slice cache_key = GetCacheKey(cache_key_prefix, handle, cache_key_buffer);
+      auto* cache_handle = block_cache->Lookup(cache_key, kDefaultQueryId);
+      if (cache_handle != nullptr) {
+        block_cache->Release(cache_handle);
+        continue;
+      }
+    }
+    const uint64_t block_bytes = handle.size() + kBlockTrailerSize;
+    if (prefetch_bytes + block_bytes > max_prefetch_bytes && !block_handles.empty()) {
+      // The index key is not less than any key of this block and less than all keys of the next
+      // one, so seeking to it continues from this block.
+      if (resume_key != nullptr) {
+        *resume_key = iiter.key().ToBuffer();
+      }
+      break;
+    }
+    prefetch_bytes += block_bytes;
+    block_handles.push_back(iiter.value().ToBuffer());
+    decoded_handles.push_back(handle);
+  }
+  if (!iiter.status().ok()) {
+    return iiter.status();
+  }
+
+  // Start reading all the blocks before loading them one by one, so that the device serves the
+  // reads in parallel rather than one at a time.
+  auto* data_reader = rep_->data_reader_with_cache_prefix->reader.get();
+  for (const auto& handle : decoded_handles) {
+    Status prefetch_status = data_reader->Prefetch(
+        handle.offset(), handle.size() + kBlockTrailerSize);
+    if (prefetch_status.IsNotSupported()) {
+      // The blocks are still loaded below, just one at a time.
+      break;
+    }
+    RETURN_NOT_OK(prefetch_status);
+  }
+
+  for (const auto& block_handle : block_handles) {
     // Load the block specified by the block_handle into the block cache
     BlockIter biter;
     NewDataBlockIterator(ReadOptions::kDefault, block_handle, &biter);
@@ -128,7 +128,8 @@ class BlockBasedTable : public TableReader {
                      unique_ptr<TableReader>* table_reader,
                      DataIndexLoadMode data_index_load_mode = DataIndexLoadMode::LAZY,
                      PrefetchFilter prefetch_filter = PrefetchFilter::YES,
-                     bool skip_filters = false);
+                     bool skip_filters = false,
+                     const std::string& unique_file_id = std::string());
 
   bool IsSplitSst() const override { return true; }
 
@@ -150,8 +151,9 @@ class BlockBasedTable : public TableReader {
 
   // Pre-fetch the disk blocks that correspond to the key range specified by
   // (kbegin, kend). The call will return return error status in the event of
-  // IO or iteration error.
-  Status Prefetch(const Slice* begin, const Slice* end) override;
+  // IO or iteration error. At most FLAGS_rocksdb_max_prefetch_bytes_per_call bytes of blocks that
+  // are not cached yet are read, see TableReader::Prefetch for how the stopping point is reported.
+  Status Prefetch(const Slice* begin, const Slice* end, std::string* resume_key) override;
 
   // Given a key, return an approximate byte offset in the file where
   // the data for that key begins (or would begin if the key were
@@ -198,6 +200,31 @@ class BlockBasedTable : public TableReader {
 
   class BlockEntryIteratorState;
 
+  // Tracks the data blocks accessed by one iterator, to detect that it reads them sequentially.
+  struct ReadaheadState {
+    // Offset right after the last data block accessed by the iterator.
+    uint64_t next_block_offset = 0;
+    // Number of data blocks accessed in file order, one right after another.
+    size_t num_sequential_blocks = 0;
+    // The data file was already prefetched up to this offset.
+    uint64_t readahead_limit = 0;
+
+    void RecordAccess(const BlockHandle& handle);
+  };
+
+  // Same as the public NewDataBlockIterator, but also records the access in readahead_state (if
+  // not null) and prefetches the following data blocks when they are read sequentially.
+  InternalIterator* NewDataBlockIterator(
+      const ReadOptions& ro, const Slice& index_value, BlockIter* input_iter,
+      ReadaheadState* readahead_state);
+
+  // Starts reading the next read_options.readahead_size bytes of the data file, starting at the
+  // block at handle, if readahead_state shows that the iterator reads data blocks sequentially.
+  // Called right before reading the block from the file, so that scans over blocks found in the
+  // block cache do not cause any I/O.
+  void MaybeReadahead(const ReadOptions& read_options, const BlockHandle& handle,
+                      ReadaheadState* readahead_state);
+
   // Returns filter block handle for fixed-size bloom filter using filter index and filter key.
   Status GetFixedSizeFilterBlockHandle(const Slice& filter_key,
       BlockHandle* filter_block_handle) const;
@@ -254,6 +281,12 @@ class BlockBasedTable : public TableReader {
       const ReadOptions& read_options, Statistics* statistics,
       CachableEntry<Block>* block, Block* raw_block, uint32_t format_version);
 
+  // Reads a data block, consulting the persistent cache (if set) before reading from the data
+  // file. Blocks read from the file are added to the persistent cache in their raw (possibly
+  // compressed) form. If do_uncompress is false, the returned block may be compressed.
+  Status ReadDataBlock(const ReadOptions& read_options, const BlockHandle& handle,
+                       std::unique_ptr<Block>* result, bool do_uncompress = true);
+
   // Calls (*handle_result)(arg, ...) repeatedly, starting with the entry found
   // after a call to Seek(key), until handle_result returns false.
   // May not make such a call if filter policy says that key is not present.
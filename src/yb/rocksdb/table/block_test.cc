@@ -18,6 +18,8 @@
 // under the License.
 //
 #include <stdio.h>
+
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -243,6 +245,62 @@ TEST_F(BlockTest, IndexHashWithSharedPrefix) {
   CheckBlockContents(std::move(contents), kMaxKey, keys, values);
 }
 
+// Seeks in a block of internal keys with long shared prefixes, where user keys can also be prefixes
+// of each other, and checks the results against a plain lower bound search.
+TEST_F(BlockTest, SeekInternalKeysWithSharedPrefix) {
+  Random rnd(301);
+  InternalKeyComparator icmp(BytewiseComparator());
+  ASSERT_TRUE(icmp.IsBytewiseInternalKeyComparator());
+
+  const std::string kPrefix(40, 'p');
+  std::vector<std::string> user_keys;
+  for (int i = 0; i < 200; ++i) {
+    std::string user_key = kPrefix + RandomString(&rnd, rnd.Uniform(4));
+    user_keys.push_back(user_key);
+    user_keys.push_back(user_key + RandomString(&rnd, 1 + rnd.Uniform(20)));
+  }
+  std::vector<std::string> keys;
+  for (const auto& user_key : user_keys) {
+    for (int j = 0; j < 3; ++j) {
+      keys.push_back(InternalKey(user_key, rnd.Uniform(1000), kTypeValue).Encode().ToString());
+    }
+  }
+  auto less = [&icmp](const std::string& lhs, const std::string& rhs) {
+    return icmp.Compare(lhs, rhs) < 0;
+  };
+  std::sort(keys.begin(), keys.end(), less);
+  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+  BlockBuilder builder(16);
+  for (const auto& key : keys) {
+    builder.Add(key, key);
+  }
+  BlockContents contents;
+  contents.data = builder.Finish();
+  contents.cachable = false;
+  Block reader(std::move(contents));
+  std::unique_ptr<InternalIterator> iter(reader.NewIterator(&icmp));
+
+  for (int i = 0; i < 10000; ++i) {
+    std::string target;
+    if (rnd.OneIn(2)) {
+      target = keys[rnd.Uniform(static_cast<int>(keys.size()))];
+    } else {
+      const std::string& user_key = user_keys[rnd.Uniform(static_cast<int>(user_keys.size()))];
+      target = InternalKey(user_key.substr(0, rnd.Uniform(static_cast<int>(user_key.size()) + 1)),
+                           rnd.Uniform(1000), kTypeValue).Encode().ToString();
+    }
+    iter->Seek(target);
+    auto expected = std::lower_bound(keys.begin(), keys.end(), target, less);
+    if (expected == keys.end()) {
+      ASSERT_FALSE(iter->Valid());
+    } else {
+      ASSERT_TRUE(iter->Valid());
+      ASSERT_EQ(*expected, iter->key().ToBuffer());
+    }
+  }
+}
+
 }  // namespace rocksdb
 
 int main(int argc, char **argv) {
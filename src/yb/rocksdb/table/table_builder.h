@@ -59,6 +59,9 @@ struct TableReaderOptions {
   const InternalKeyComparator& internal_comparator;
   // This is only used for BlockBasedTable (reader)
   bool skip_filters;
+  // Identifies the table file across process restarts, i.e. the DB identity and the file number.
+  // Empty if unknown. Used to key entries of caches which outlive the process.
+  std::string unique_file_id;
 };
 
 struct TableBuilderOptions {
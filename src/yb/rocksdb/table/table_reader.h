@@ -25,6 +25,7 @@
 #define ROCKSDB_TABLE_TABLE_READER_H
 
 #include <memory>
+#include <string>
 
 #include "yb/util/slice.h"
 
@@ -101,10 +102,18 @@ class TableReader {
   // Prefetch data corresponding to a give range of keys
   // Typically this functionality is required for table implementations that
   // persists the data on a non volatile storage medium like disk/SSD
+  //
+  // An implementation may stop before the end of the range to limit the amount of data read by a
+  // single call. In that case it sets *resume_key (if not null) to the key to pass as begin to
+  // prefetch the rest of the range. Otherwise *resume_key is cleared.
   virtual Status Prefetch(const Slice* begin = nullptr,
-                          const Slice* end = nullptr) {
+                          const Slice* end = nullptr,
+                          std::string* resume_key = nullptr) {
     (void) begin;
     (void) end;
+    if (resume_key != nullptr) {
+      resume_key->clear();
+    }
     // Default implementation is NOOP.
     // The child class should implement functionality when applicable
     return Status::OK();
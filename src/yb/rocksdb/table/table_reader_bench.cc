@@ -51,18 +51,36 @@ namespace rocksdb {
 namespace {
 // Make a key that i determines the first 4 characters and j determines the
 // last 4 characters.
-static std::string MakeKey(int i, int j, bool through_db) {
+//
+// With docdb_keys, the key is shaped like a DocDB key instead: a hash and a hashed component
+// shared by all keys, followed by range components determined by i and j and a hybrid time. This
+// keeps the long common prefixes that dominate key comparisons in DocDB.
+static std::string MakeKey(int i, int j, bool through_db, bool docdb_keys) {
   char buf[100];
-  snprintf(buf, sizeof(buf), "%04d__key___%04d", i, j);
+  std::string key;
+  if (docdb_keys) {
+    key.push_back('G');
+    key.append("\x12\x34", 2);
+    key.push_back('S');
+    key.append("benchmark_table_hashed_component");
+    key.append("\0\0", 2);
+    key.push_back('!');
+    snprintf(buf, sizeof(buf), "I%08dI%08d!#", i, j);
+    key.append(buf);
+    key.append(12, '\x01');
+  } else {
+    snprintf(buf, sizeof(buf), "%04d__key___%04d", i, j);
+    key = buf;
+  }
   if (through_db) {
-    return std::string(buf);
+    return key;
   }
   // If we directly query table, which operates on internal keys
   // instead of user keys, we need to add 8 bytes of internal
   // information (row type etc) to user key to make an internal
   // key.
-  InternalKey key(std::string(buf), 0, ValueType::kTypeValue);
-  return key.Encode().ToString();
+  InternalKey internal_key(key, 0, ValueType::kTypeValue);
+  return internal_key.Encode().ToString();
 }
 
 uint64_t Now(Env* env, bool measured_by_nanosecond) {
@@ -88,7 +106,8 @@ void TableReaderBenchmark(const Options& opts, const EnvOptions& env_options,
                           const ReadOptions& read_options, int num_keys1,
                           int num_keys2, int num_iter, int prefix_len,
                           bool if_query_empty_keys, bool for_iterator,
-                          bool through_db, bool measured_by_nanosecond) {
+                          bool through_db, bool measured_by_nanosecond,
+                          bool docdb_keys) {
   rocksdb::InternalKeyComparator ikc(opts.comparator);
 
   std::string file_name = test::TmpDir()
@@ -123,7 +142,7 @@ void TableReaderBenchmark(const Options& opts, const EnvOptions& env_options,
   // Populate slightly more than 1M keys
   for (int i = 0; i < num_keys1; i++) {
     for (int j = 0; j < num_keys2; j++) {
-      std::string key = MakeKey(i * 2, j, through_db);
+      std::string key = MakeKey(i * 2, j, through_db, docdb_keys);
       if (!through_db) {
         tb->Add(key, key);
       } else {
@@ -175,7 +194,7 @@ void TableReaderBenchmark(const Options& opts, const EnvOptions& env_options,
 
         if (!for_iterator) {
           // Query one existing key;
-          std::string key = MakeKey(r1, r2, through_db);
+          std::string key = MakeKey(r1, r2, through_db, docdb_keys);
           uint64_t start_time = Now(env, measured_by_nanosecond);
           if (!through_db) {
             std::string value;
@@ -199,8 +218,8 @@ void TableReaderBenchmark(const Options& opts, const EnvOptions& env_options,
               r2_len = num_keys2 - r2;
             }
           }
-          std::string start_key = MakeKey(r1, r2, through_db);
-          std::string end_key = MakeKey(r1, r2 + r2_len, through_db);
+          std::string start_key = MakeKey(r1, r2, through_db, docdb_keys);
+          std::string end_key = MakeKey(r1, r2 + r2_len, through_db, docdb_keys);
           uint64_t total_time = 0;
           uint64_t start_time = Now(env, measured_by_nanosecond);
           Iterator* iter = nullptr;
@@ -219,7 +238,7 @@ void TableReaderBenchmark(const Options& opts, const EnvOptions& env_options,
             }
             // verify key;
             total_time += Now(env, measured_by_nanosecond) - start_time;
-            assert(Slice(MakeKey(r1, r2 + count, through_db)) ==
+            assert(Slice(MakeKey(r1, r2 + count, through_db, docdb_keys)) ==
                    (through_db ? iter->key() : iiter->key()));
             start_time = Now(env, measured_by_nanosecond);
             if (++count >= r2_len) {
@@ -248,9 +267,12 @@ void TableReaderBenchmark(const Options& opts, const EnvOptions& env_options,
       "num_key2: %5d  %10s\n"
       "==================================================="
       "===================================================="
+      "\nKeys: %s   Average: %.1f %s per %s"
       "\nHistogram (unit: %s): \n%s",
       opts.table_factory->Name(), num_keys1, num_keys2,
       for_iterator ? "iterator" : (if_query_empty_keys ? "empty" : "non_empty"),
+      docdb_keys ? "docdb" : "simple", hist.Average(),
+      measured_by_nanosecond ? "ns" : "us", for_iterator ? "seek and scan" : "get",
       measured_by_nanosecond ? "nanosecond" : "microsecond",
       hist.ToString().c_str());
   if (!through_db) {
@@ -281,6 +303,8 @@ DEFINE_string(table_factory, "block_based",
 DEFINE_string(time_unit, "microsecond",
               "The time unit used for measuring performance. User can specify "
               "`microsecond` (default) or `nanosecond`");
+DEFINE_bool(docdb_keys, false, "Use keys shaped like DocDB keys, with a long prefix shared by all "
+            "keys, instead of short keys. Only supported by the block based table factory.");
 
 int main(int argc, char** argv) {
   SetUsageMessage(std::string("\nUSAGE:\n") + std::string(argv[0]) +
@@ -298,6 +322,11 @@ int main(int argc, char** argv) {
   options.create_if_missing = true;
   options.compression = rocksdb::CompressionType::kNoCompression;
 
+  if (FLAGS_docdb_keys && FLAGS_table_factory != "block_based") {
+    fprintf(stderr, "DocDB keys are only supported by the block based table factory\n");
+    exit(1);
+  }
+
   if (FLAGS_table_factory == "cuckoo_hash") {
 #ifndef ROCKSDB_LITE
     options.allow_mmap_reads = FLAGS_mmap_read;
@@ -340,7 +369,8 @@ int main(int argc, char** argv) {
     rocksdb::TableReaderBenchmark(options, env_options, ro, FLAGS_num_keys1,
                                   FLAGS_num_keys2, FLAGS_iter, FLAGS_prefix_len,
                                   FLAGS_query_empty, FLAGS_iterator,
-                                  FLAGS_through_db, measured_by_nanosecond);
+                                  FLAGS_through_db, measured_by_nanosecond,
+                                  FLAGS_docdb_keys);
   } else {
     return 1;
   }
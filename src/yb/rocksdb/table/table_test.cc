@@ -63,6 +63,7 @@
 #include "yb/rocksdb/util/testutil.h"
 
 DECLARE_double(cache_single_touch_ratio);
+DECLARE_uint64(rocksdb_max_prefetch_bytes_per_call);
 
 namespace rocksdb {
 
@@ -1108,9 +1109,13 @@ void PrefetchRange(TableConstructor* c, Options* opt,
   // empty string replacement is a trick so we don't crash the test
   Slice begin(key_begin ? key_begin : "");
   Slice end(key_end ? key_end : "");
+  std::string resume_key = "not cleared";
   Status s = table_reader->Prefetch(key_begin ? &begin : nullptr,
-                                    key_end ? &end : nullptr);
+                                    key_end ? &end : nullptr,
+                                    &resume_key);
   ASSERT_TRUE(s.code() == expected_status.code());
+  // The whole range fits into the default limit.
+  ASSERT_EQ("", resume_key);
 
   // assert our expectation in cache warmup
   AssertKeysInCache(table_reader, keys_in_cache, keys_not_in_cache);
@@ -1199,6 +1204,57 @@ TEST_F(BlockBasedTableTest, PrefetchTest) {
                 STATUS(InvalidArgument, Slice("k06 "), Slice("k07")));
 }
 
+TEST_F(BlockBasedTableTest, PrefetchSkipsCachedBlocksAndIsCapped) {
+  google::FlagSaver flag_saver;
+  Options opt;
+  unique_ptr<InternalKeyComparator> ikc;
+  ikc.reset(new test::PlainInternalKeyComparator(opt.comparator));
+  opt.compression = kNoCompression;
+  BlockBasedTableOptions table_options;
+  table_options.block_size = 1024;
+  table_options.block_cache =
+      NewLRUCache((16 * 1024 * 1024) / FLAGS_cache_single_touch_ratio);
+  opt.table_factory.reset(NewBlockBasedTableFactory(table_options));
+
+  TableConstructor c(BytewiseComparator());
+  c.Add("k01", "hello");
+  c.Add("k02", "hello2");
+  c.Add("k03", std::string(10000, 'x'));
+  c.Add("k04", std::string(200000, 'x'));
+  c.Add("k05", std::string(300000, 'x'));
+  c.Add("k06", "hello3");
+  c.Add("k07", std::string(100000, 'x'));
+  std::vector<std::string> keys;
+  stl_wrappers::KVMap kvmap;
+  const ImmutableCFOptions ioptions(opt);
+  c.Finish(opt, ioptions, table_options, *ikc, &keys, &kvmap);
+  auto* table_reader = dynamic_cast<BlockBasedTable*>(c.GetTableReader());
+
+  // Same data blocks as in PrefetchTest. The cap fits the first two blocks but not the third one.
+  FLAGS_rocksdb_max_prefetch_bytes_per_call = 250000;
+  std::string resume_key;
+  ASSERT_OK(table_reader->Prefetch(nullptr, nullptr, &resume_key));
+  AssertKeysInCache(table_reader, {"k01", "k02", "k03", "k04"}, {"k05", "k06", "k07"});
+  // The call stopped at the block of k05.
+  ASSERT_FALSE(resume_key.empty());
+  ASSERT_GE(ikc->Compare(resume_key, keys[4]), 0);
+  ASSERT_LT(ikc->Compare(resume_key, keys[5]), 0);
+
+  // The next call skips the cached blocks. A single block larger than the cap is still read, but
+  // nothing after it.
+  ASSERT_OK(table_reader->Prefetch(nullptr, nullptr, &resume_key));
+  AssertKeysInCache(table_reader, {"k01", "k02", "k03", "k04", "k05"}, {"k06", "k07"});
+  ASSERT_FALSE(resume_key.empty());
+  ASSERT_GE(ikc->Compare(resume_key, keys[5]), 0);
+
+  // Resuming from the reported key prefetches the rest of the table.
+  const std::string begin = resume_key;
+  const Slice begin_slice(begin);
+  ASSERT_OK(table_reader->Prefetch(&begin_slice, nullptr, &resume_key));
+  AssertKeysInCache(table_reader, {"k01", "k02", "k03", "k04", "k05", "k06", "k07"}, {});
+  ASSERT_TRUE(resume_key.empty());
+}
+
 TEST_F(BlockBasedTableTest, TotalOrderSeekOnHashIndex) {
   BlockBasedTableOptions table_options;
   for (int i = 0; i < 5; ++i) {
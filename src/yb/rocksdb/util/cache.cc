@@ -24,8 +24,12 @@
 #include <assert.h>
 #include <stdio.h>
 #include <stdlib.h>
+
+#include <atomic>
+
 #include <gflags/gflags.h>
 
+#include "yb/util/enums.h"
 #include "yb/util/metrics.h"
 #include "yb/rocksdb/cache.h"
 #include "yb/rocksdb/statistics.h"
@@ -785,7 +789,8 @@ class ShardedLRUCache : public Cache {
   }
 
   bool IsValidQueryId(const QueryId query_id) {
-    return query_id >= 0 || query_id == kInMultiTouchId || query_id == kNoCacheQueryId;
+    return query_id >= 0 || query_id == kInMultiTouchId || query_id == kNoCacheQueryId ||
+           query_id == kSingleTouchOnlyQueryId;
   }
 
  public:
@@ -914,17 +919,101 @@ class ShardedLRUCache : public Cache {
     }
   }
 
-  virtual void SetMetrics(const scoped_refptr<yb::MetricEntity>& entity) override {
+  virtual void SetMetrics(const scoped_refptr<yb::MetricEntity>& entity,
+                          yb::CacheMetricsTier tier) override {
     int num_shards = 1 << num_shard_bits_;
-    metrics_ = std::make_shared<yb::CacheMetrics>(entity);
+    metrics_ = std::make_shared<yb::CacheMetrics>(entity, tier);
     for (int s = 0; s < num_shards; s++) {
       shards_[s].SetMetrics(metrics_);
     }
   }
 };
 
+// Forwards all calls to the underlying cache, overriding the query ids of inserts and lookups
+// according to the priority class.
+class CacheWithPriorityImpl : public CacheWithPriority {
+ public:
+  CacheWithPriorityImpl(shared_ptr<Cache> cache, CachePriority priority)
+      : cache_(std::move(cache)), priority_(priority) {}
+
+  void SetPriority(CachePriority priority) override {
+    priority_.store(priority, std::memory_order_relaxed);
+  }
+
+  Status Insert(const Slice& key, const QueryId query_id, void* value, size_t charge,
+                void (*deleter)(const Slice& key, void* value),
+                Handle** handle, Statistics* statistics) override {
+    return cache_->Insert(key, MapQueryId(query_id), value, charge, deleter, handle, statistics);
+  }
+
+  Handle* Lookup(const Slice& key, const QueryId query_id, Statistics* statistics) override {
+    return cache_->Lookup(key, MapQueryId(query_id), statistics);
+  }
+
+  void Release(Handle* handle) override { cache_->Release(handle); }
+
+  void* Value(Handle* handle) override { return cache_->Value(handle); }
+
+  void Erase(const Slice& key) override { cache_->Erase(key); }
+
+  uint64_t NewId() override { return cache_->NewId(); }
+
+  void SetCapacity(size_t capacity) override { cache_->SetCapacity(capacity); }
+
+  void SetStrictCapacityLimit(bool strict_capacity_limit) override {
+    cache_->SetStrictCapacityLimit(strict_capacity_limit);
+  }
+
+  bool HasStrictCapacityLimit() const override { return cache_->HasStrictCapacityLimit(); }
+
+  size_t GetCapacity() const override { return cache_->GetCapacity(); }
+
+  size_t GetUsage() const override { return cache_->GetUsage(); }
+
+  size_t GetUsage(Handle* handle) const override { return cache_->GetUsage(handle); }
+
+  size_t GetPinnedUsage() const override { return cache_->GetPinnedUsage(); }
+
+  SubCacheType GetSubCacheType(Handle* e) const override { return cache_->GetSubCacheType(e); }
+
+  void ApplyToAllCacheEntries(void (*callback)(void*, size_t), bool thread_safe) override {
+    cache_->ApplyToAllCacheEntries(callback, thread_safe);
+  }
+
+  void SetMetrics(const scoped_refptr<yb::MetricEntity>& entity,
+                  yb::CacheMetricsTier tier) override {
+    // Metrics belong to the underlying cache, which is shared with other views.
+  }
+
+ private:
+  QueryId MapQueryId(QueryId query_id) const {
+    // Requests that bypass the cache keep doing so regardless of priority.
+    if (query_id == kNoCacheQueryId) {
+      return query_id;
+    }
+    const CachePriority priority = priority_.load(std::memory_order_relaxed);
+    switch (priority) {
+      case CachePriority::kDefault:
+        return query_id;
+      case CachePriority::kHigh:
+        return kInMultiTouchId;
+      case CachePriority::kLow:
+        return kSingleTouchOnlyQueryId;
+    }
+    FATAL_INVALID_ENUM_VALUE(CachePriority, priority);
+  }
+
+  const shared_ptr<Cache> cache_;
+  std::atomic<CachePriority> priority_;
+};
+
 }  // end anonymous namespace
 
+shared_ptr<CacheWithPriority> NewCacheWithPriority(
+    shared_ptr<Cache> cache, CachePriority priority) {
+  return std::make_shared<CacheWithPriorityImpl>(std::move(cache), priority);
+}
+
 shared_ptr<Cache> NewLRUCache(size_t capacity) {
   return NewLRUCache(capacity, kNumShardBits, false);
 }
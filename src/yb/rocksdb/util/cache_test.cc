@@ -442,6 +442,32 @@ TEST_F(CacheTest, MultiTouch) {
   ASSERT_TRUE(LookupAndCheckInMultiTouch(100, 101, qid2));
 }
 
+TEST_F(CacheTest, Priority) {
+  auto high_cache = NewCacheWithPriority(cache_, CachePriority::kHigh);
+  auto low_cache = NewCacheWithPriority(cache_, CachePriority::kLow);
+
+  // High priority values go straight to the multi touch cache.
+  ASSERT_OK(Insert(high_cache, 100, 101));
+  ASSERT_TRUE(LookupAndCheckInMultiTouch(high_cache, 100, 101));
+
+  // Low priority values stay in the single touch cache, even when touched by different queries.
+  QueryId qid1 = 1000;
+  QueryId qid2 = 1001;
+  ASSERT_OK(Insert(low_cache, 200, 201, 1, qid1));
+  ASSERT_FALSE(LookupAndCheckInMultiTouch(low_cache, 200, 201, qid2));
+  ASSERT_FALSE(LookupAndCheckInMultiTouch(low_cache, 200, 201, qid1));
+  ASSERT_EQ(201, Lookup(low_cache, 200));
+
+  // All views share the entries and the usage of the underlying cache.
+  ASSERT_EQ(101, Lookup(100));
+  ASSERT_EQ(201, Lookup(200));
+  ASSERT_EQ(cache_->GetUsage(), low_cache->GetUsage());
+
+  // Raising the priority of a view affects the next lookup.
+  low_cache->SetPriority(CachePriority::kHigh);
+  ASSERT_TRUE(LookupAndCheckInMultiTouch(low_cache, 200, 201, qid1));
+}
+
 TEST_F(CacheTest, EvictionPolicyMultiTouch) {
   QueryId qid1 = 1000;
   QueryId qid2 = 1001;
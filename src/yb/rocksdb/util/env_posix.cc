@@ -154,6 +154,21 @@ class PosixEnv : public Env {
     }
   }
 
+  // Opens the file with O_DIRECT when *direct is true. Falls back to buffered I/O and resets
+  // *direct when the platform or the file system does not support O_DIRECT.
+  static int OpenMaybeDirect(const std::string& fname, int flags, mode_t mode, bool* direct) {
+#ifdef OS_LINUX
+    if (*direct) {
+      int fd = open(fname.c_str(), flags | O_DIRECT, mode);
+      if (fd >= 0 || errno != EINVAL) {
+        return fd;
+      }
+    }
+#endif
+    *direct = false;
+    return open(fname.c_str(), flags, mode);
+  }
+
   virtual Status NewSequentialFile(const std::string& fname,
                                    unique_ptr<SequentialFile>* result,
                                    const EnvOptions& options) override {
@@ -180,9 +195,11 @@ class PosixEnv : public Env {
     result->reset();
     Status s;
     int fd;
+    EnvOptions file_options = options;
+    file_options.use_direct_reads = options.use_direct_reads && !options.use_mmap_reads;
     {
       IOSTATS_TIMER_GUARD(open_nanos);
-      fd = open(fname.c_str(), O_RDONLY);
+      fd = OpenMaybeDirect(fname, O_RDONLY, 0, &file_options.use_direct_reads);
     }
     SetFD_CLOEXEC(fd, &options);
     if (fd < 0) {
@@ -204,7 +221,7 @@ class PosixEnv : public Env {
       }
       close(fd);
     } else {
-      result->reset(new PosixRandomAccessFile(fname, fd, options));
+      result->reset(new PosixRandomAccessFile(fname, fd, file_options));
     }
     return s;
   }
@@ -215,9 +232,10 @@ class PosixEnv : public Env {
     result->reset();
     Status s;
     int fd = -1;
+    bool use_direct_writes = options.use_direct_writes && !options.use_mmap_writes;
     do {
       IOSTATS_TIMER_GUARD(open_nanos);
-      fd = open(fname.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+      fd = OpenMaybeDirect(fname, O_CREAT | O_RDWR | O_TRUNC, 0644, &use_direct_writes);
     } while (fd < 0 && errno == EINTR);
     if (fd < 0) {
       s = IOError(fname, errno);
@@ -239,6 +257,7 @@ class PosixEnv : public Env {
         // disable mmap writes
         EnvOptions no_mmap_writes_options = options;
         no_mmap_writes_options.use_mmap_writes = false;
+        no_mmap_writes_options.use_direct_writes = use_direct_writes;
 
         result->reset(new PosixWritableFile(fname, fd, no_mmap_writes_options));
       }
@@ -46,6 +46,7 @@
 #include "yb/rocksdb/env.h"
 #include "yb/rocksdb/port/port.h"
 #include "yb/rocksdb/util/coding.h"
+#include "yb/rocksdb/util/file_reader_writer.h"
 #include "yb/rocksdb/util/log_buffer.h"
 #include "yb/rocksdb/util/mutexlock.h"
 #include "yb/rocksdb/util/string_util.h"
@@ -808,6 +809,80 @@ TEST_F(EnvPosixTest, InvalidateCache) {
   // Delete the file
   ASSERT_OK(env_->DeleteFile(fname));
 }
+
+TEST_F(EnvPosixTest, Prefetch) {
+  const EnvOptions soptions;
+  std::string fname = test::TmpDir() + "/" + "testfile";
+  const std::string data(64 * 1024, 'x');
+
+  {
+    unique_ptr<WritableFile> wfile;
+    ASSERT_OK(env_->NewWritableFile(fname, &wfile, soptions));
+    ASSERT_OK(wfile->Append(data));
+    ASSERT_OK(wfile->Close());
+  }
+
+  {
+    unique_ptr<RandomAccessFile> file;
+    ASSERT_OK(env_->NewRandomAccessFile(fname, &file, soptions));
+    ASSERT_OK(file->Prefetch(0, data.size()));
+    // Prefetching past the end of the file is not an error.
+    ASSERT_OK(file->Prefetch(data.size(), 4096));
+
+    std::string scratch(data.size(), 0);
+    Slice result;
+    ASSERT_OK(file->Read(0, data.size(), &result, &scratch[0]));
+    ASSERT_EQ(data, result.ToBuffer());
+  }
+  ASSERT_OK(env_->DeleteFile(fname));
+}
+
+// Writes a file whose size is not a multiple of the direct I/O alignment through
+// WritableFileWriter and reads it back at unaligned offsets.
+TEST_F(EnvPosixTest, DirectIO) {
+  EnvOptions soptions;
+  soptions.use_mmap_writes = false;
+  soptions.use_direct_writes = true;
+  soptions.use_direct_reads = true;
+  std::string fname = test::TmpDir() + "/" + "testfile";
+  Random rnd(301);
+  const std::string data = RandomString(&rnd, 100 * 1024 + 123);
+
+  {
+    unique_ptr<WritableFile> wfile;
+    ASSERT_OK(env_->NewWritableFile(fname, &wfile, soptions));
+    WritableFileWriter writer(std::move(wfile), soptions);
+    for (size_t pos = 0; pos < data.size(); pos += 1000) {
+      ASSERT_OK(writer.Append(Slice(data.data() + pos, std::min<size_t>(1000, data.size() - pos))));
+      if (pos % 10000 == 0) {
+        ASSERT_OK(writer.Flush());
+      }
+    }
+    ASSERT_OK(writer.Sync(false));
+    ASSERT_OK(writer.Close());
+  }
+
+  uint64_t file_size = 0;
+  ASSERT_OK(env_->GetFileSize(fname, &file_size));
+  ASSERT_EQ(data.size(), file_size);
+
+  {
+    unique_ptr<RandomAccessFile> file;
+    ASSERT_OK(env_->NewRandomAccessFile(fname, &file, soptions));
+    std::string scratch(data.size(), 0);
+    Slice result;
+    ASSERT_OK(file->Read(0, data.size(), &result, &scratch[0]));
+    ASSERT_EQ(data, result.ToBuffer());
+    ASSERT_OK(file->Read(4097, 5000, &result, &scratch[0]));
+    ASSERT_EQ(data.substr(4097, 5000), result.ToBuffer());
+    // Reads past the end of the file are truncated.
+    ASSERT_OK(file->Read(data.size() - 10, 100, &result, &scratch[0]));
+    ASSERT_EQ(data.substr(data.size() - 10), result.ToBuffer());
+    ASSERT_OK(file->Read(data.size() + 10, 100, &result, &scratch[0]));
+    ASSERT_EQ(0, result.size());
+  }
+  ASSERT_OK(env_->DeleteFile(fname));
+}
 #endif  // not TRAVIS
 #endif  // OS_LINUX
 
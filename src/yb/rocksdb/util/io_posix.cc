@@ -42,6 +42,7 @@
 #endif
 #include "yb/rocksdb/port/port.h"
 #include "yb/util/slice.h"
+#include "yb/rocksdb/util/aligned_buffer.h"
 #include "yb/rocksdb/util/coding.h"
 #include "yb/rocksdb/util/iostats_context_imp.h"
 #include "yb/rocksdb/util/posix_logger.h"
@@ -155,7 +156,10 @@ static size_t GetUniqueIdFromFile(int fd, char* id, size_t max_size) {
  */
 PosixRandomAccessFile::PosixRandomAccessFile(const std::string& fname, int fd,
                                              const EnvOptions& options)
-    : filename_(fname), fd_(fd), use_os_buffer_(options.use_os_buffer) {
+    : filename_(fname),
+      fd_(fd),
+      use_os_buffer_(options.use_os_buffer),
+      use_direct_io_(options.use_direct_reads) {
   assert(!options.use_mmap_reads || sizeof(void*) < 8);
 }
 
@@ -163,6 +167,10 @@ PosixRandomAccessFile::~PosixRandomAccessFile() { close(fd_); }
 
 Status PosixRandomAccessFile::Read(uint64_t offset, size_t n, Slice* result,
                                    char* scratch) const {
+  if (use_direct_io_) {
+    return ReadDirect(offset, n, result, scratch);
+  }
+
   Status s;
   ssize_t r = -1;
   size_t left = n;
@@ -194,7 +202,58 @@ Status PosixRandomAccessFile::Read(uint64_t offset, size_t n, Slice* result,
   return s;
 }
 
+// O_DIRECT requires the file offset, the length and the memory buffer to be aligned, so we read
+// the enclosing aligned range into a bounce buffer and copy the requested part into scratch.
+Status PosixRandomAccessFile::ReadDirect(uint64_t offset, size_t n, Slice* result,
+                                         char* scratch) const {
+  const size_t alignment = kDirectIOAlignment;
+  const uint64_t aligned_offset = TruncateToPageBoundary(alignment, offset);
+  const size_t offset_advance = offset - aligned_offset;
+  const size_t size = Roundup(offset_advance + n, alignment);
+
+  AlignedBuffer buffer;
+  buffer.Alignment(alignment);
+  buffer.AllocateNewBuffer(size);
+  char* const dest = buffer.Destination();
+
+  size_t done = 0;
+  while (done < size) {
+    ssize_t r = pread(fd_, dest + done, size - done, static_cast<off_t>(aligned_offset + done));
+    if (r < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      *result = Slice(scratch, 0);
+      return IOError(filename_, errno);
+    }
+    done += r;
+    // A short read means we hit the end of the file.
+    if (r == 0 || r % alignment != 0) {
+      break;
+    }
+  }
+  buffer.Size(done);
+
+  size_t copied = 0;
+  if (done > offset_advance) {
+    copied = buffer.Read(scratch, offset_advance, n);
+  }
+  *result = Slice(scratch, copied);
+  return Status::OK();
+}
+
 #ifdef OS_LINUX
+Status PosixRandomAccessFile::Prefetch(uint64_t offset, size_t n) {
+  if (!use_os_buffer_ || use_direct_io_) {
+    // Prefetched pages would be dropped again by the next Read().
+    return STATUS(NotSupported, "Prefetch requires OS buffering.");
+  }
+  if (readahead(fd_, static_cast<off64_t>(offset), n) != 0) {
+    return IOError(filename_, errno);
+  }
+  return Status::OK();
+}
+
 size_t PosixRandomAccessFile::GetUniqueId(char* id, size_t max_size) const {
   return GetUniqueIdFromFile(fd_, id, max_size);
 }
@@ -517,7 +576,7 @@ Status PosixMmapFile::Allocate(uint64_t offset, uint64_t len) {
  */
 PosixWritableFile::PosixWritableFile(const std::string& fname, int fd,
                                      const EnvOptions& options)
-    : filename_(fname), fd_(fd), filesize_(0) {
+    : filename_(fname), fd_(fd), filesize_(0), use_direct_io_(options.use_direct_writes) {
 #ifdef ROCKSDB_FALLOCATE_PRESENT
   allow_fallocate_ = options.allow_fallocate;
   fallocate_with_keep_size_ = options.fallocate_with_keep_size;
@@ -549,6 +608,39 @@ Status PosixWritableFile::Append(const Slice& data) {
   return Status::OK();
 }
 
+Status PosixWritableFile::PositionedAppend(const Slice& data, uint64_t offset) {
+  assert(use_direct_io_);
+  assert(offset <= std::numeric_limits<off_t>::max());
+  const char* src = data.cdata();
+  size_t left = data.size();
+  while (left != 0) {
+    ssize_t done = pwrite(fd_, src, left, static_cast<off_t>(offset));
+    if (done < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return IOError(filename_, errno);
+    }
+    left -= done;
+    offset += done;
+    src += done;
+  }
+  filesize_ = std::max<uint64_t>(filesize_, offset);
+  return Status::OK();
+}
+
+Status PosixWritableFile::Truncate(uint64_t size) {
+  if (!use_direct_io_) {
+    return Status::OK();
+  }
+  // The last page written with direct I/O is padded with zeros, cut it back to the data size.
+  filesize_ = size;
+  if (ftruncate(fd_, static_cast<off_t>(size)) < 0) {
+    return IOError(filename_, errno);
+  }
+  return Status::OK();
+}
+
 Status PosixWritableFile::Close() {
   Status s;
 
@@ -43,6 +43,10 @@ static Status IOError(const std::string& context, int err_number) {
   return STATUS(IOError, context, strerror(err_number));
 }
 
+// Alignment of offsets, sizes and memory buffers for files opened with O_DIRECT. Covers devices
+// with both 512 byte and 4KB logical blocks.
+constexpr size_t kDirectIOAlignment = 4 * 1024;
+
 class PosixSequentialFile : public SequentialFile {
  private:
   std::string filename_;
@@ -65,6 +69,10 @@ class PosixRandomAccessFile : public RandomAccessFile {
   std::string filename_;
   int fd_;
   bool use_os_buffer_;
+  // The file was opened with O_DIRECT, so reads go through an aligned buffer.
+  bool use_direct_io_;
+
+  Status ReadDirect(uint64_t offset, size_t n, Slice* result, char* scratch) const;
 
  public:
   PosixRandomAccessFile(const std::string& fname, int fd,
@@ -74,6 +82,7 @@ class PosixRandomAccessFile : public RandomAccessFile {
   virtual Status Read(uint64_t offset, size_t n, Slice* result,
                       char* scratch) const override;
 #ifdef OS_LINUX
+  virtual Status Prefetch(uint64_t offset, size_t n) override;
   virtual size_t GetUniqueId(char* id, size_t max_size) const override;
 #endif
   virtual void Hint(AccessPattern pattern) override;
@@ -85,6 +94,9 @@ class PosixWritableFile : public WritableFile {
   const std::string filename_;
   int fd_;
   uint64_t filesize_;
+  // The file was opened with O_DIRECT, so WritableFileWriter writes aligned pages through
+  // PositionedAppend.
+  bool use_direct_io_;
 #ifdef ROCKSDB_FALLOCATE_PRESENT
   bool allow_fallocate_;
   bool fallocate_with_keep_size_;
@@ -96,10 +108,13 @@ class PosixWritableFile : public WritableFile {
   ~PosixWritableFile();
 
   // Means Close() will properly take care of truncate
-  // and it does not need any additional information
-  virtual Status Truncate(uint64_t size) override { return Status::OK(); }
+  // and it does not need any additional information, unless the file is written with direct I/O
+  // and the last page was padded.
+  virtual Status Truncate(uint64_t size) override;
   virtual Status Close() override;
   virtual Status Append(const Slice& data) override;
+  virtual Status PositionedAppend(const Slice& data, uint64_t offset) override;
+  virtual bool UseOSBuffer() const override { return !use_direct_io_; }
   virtual Status Flush() override;
   virtual Status Sync() override;
   virtual Status Fsync() override;
@@ -64,6 +64,7 @@ ImmutableCFOptions::ImmutableCFOptions(const Options& options)
       merge_operator(options.merge_operator.get()),
       compaction_filter(options.compaction_filter),
       compaction_filter_factory(options.compaction_filter_factory.get()),
+      compaction_file_filter_factory(options.compaction_file_filter_factory.get()),
       inplace_update_support(options.inplace_update_support),
       inplace_callback(options.inplace_callback),
       info_log(options.info_log.get()),
@@ -102,6 +103,7 @@ ColumnFamilyOptions::ColumnFamilyOptions()
       merge_operator(nullptr),
       compaction_filter(nullptr),
       compaction_filter_factory(nullptr),
+      compaction_file_filter_factory(nullptr),
       write_buffer_size(FLAGS_memstore_size_mb << 20), // Option expects bytes.
       max_write_buffer_number(2),
       min_write_buffer_number_to_merge(1),
@@ -157,6 +159,7 @@ ColumnFamilyOptions::ColumnFamilyOptions(const Options& options)
       merge_operator(options.merge_operator),
       compaction_filter(options.compaction_filter),
       compaction_filter_factory(options.compaction_filter_factory),
+      compaction_file_filter_factory(options.compaction_file_filter_factory),
       write_buffer_size(options.write_buffer_size),
       max_write_buffer_number(options.max_write_buffer_number),
       min_write_buffer_number_to_merge(
@@ -274,6 +277,7 @@ DBOptions::DBOptions()
       db_write_buffer_size(0),
       access_hint_on_compaction_start(NORMAL),
       new_table_reader_for_compaction_inputs(false),
+      use_direct_io_for_flush_and_compaction(false),
       compaction_readahead_size(0),
       random_access_max_buffer_size(1024 * 1024),
       writable_file_max_buffer_size(1024 * 1024),
@@ -372,6 +376,8 @@ void DBOptions::Dump(Logger* log) const {
       access_hints[access_hint_on_compaction_start]);
   RHEADER(log, "  Options.new_table_reader_for_compaction_inputs: %d",
       new_table_reader_for_compaction_inputs);
+  RHEADER(log, "  Options.use_direct_io_for_flush_and_compaction: %d",
+      use_direct_io_for_flush_and_compaction);
   RHEADER(log,
       "               Options.compaction_readahead_size: %" ROCKSDB_PRIszt
          "d",
@@ -429,6 +435,8 @@ void ColumnFamilyOptions::Dump(Logger* log) const {
       compaction_filter ? compaction_filter->Name() : "None");
   RHEADER(log, "       Options.compaction_filter_factory: %s",
       compaction_filter_factory ? compaction_filter_factory->Name() : "None");
+  RHEADER(log, "       Options.compaction_file_filter_factory: %s",
+      compaction_file_filter_factory ? compaction_file_filter_factory->Name() : "None");
   RHEADER(log, "        Options.memtable_factory: %s", memtable_factory->Name());
   RHEADER(log, "           Options.table_factory: %s", table_factory->Name());
   RHEADER(log, "           table_factory options: %s",
@@ -691,6 +699,7 @@ const ReadOptions ReadOptions::kDefault;
 ReadOptions::ReadOptions()
     : verify_checksums(true),
       fill_cache(true),
+      readahead_size(0),
       snapshot(nullptr),
       iterate_upper_bound(nullptr),
       read_tier(kReadAllTier),
@@ -707,6 +716,7 @@ ReadOptions::ReadOptions()
 ReadOptions::ReadOptions(bool cksum, bool cache)
     : verify_checksums(cksum),
       fill_cache(cache),
+      readahead_size(0),
       snapshot(nullptr),
       iterate_upper_bound(nullptr),
       read_tier(kReadAllTier),
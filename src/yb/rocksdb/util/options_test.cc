@@ -1656,6 +1656,7 @@ Status GetFromString(DBOptions* source, DBOptions* destination) {
       "max_total_wal_size=4295005604;"
       "compaction_readahead_size=0;"
       "new_table_reader_for_compaction_inputs=true;"
+      "use_direct_io_for_flush_and_compaction=true;"
       "keep_log_file_num=4890;"
       "skip_stats_update_on_db_open=true;"
       "max_manifest_file_size=4295009941;"
@@ -1940,6 +1941,7 @@ TEST_F(OptionsParserTest, ColumnFamilyOptionsAllFieldsSettable) {
       BLACKLIST_ENTRY(ColumnFamilyOptions, merge_operator),
       BLACKLIST_ENTRY(ColumnFamilyOptions, compaction_filter),
       BLACKLIST_ENTRY(ColumnFamilyOptions, compaction_filter_factory),
+      BLACKLIST_ENTRY(ColumnFamilyOptions, compaction_file_filter_factory),
       BLACKLIST_ENTRY(ColumnFamilyOptions, compression_per_level),
       BLACKLIST_ENTRY(ColumnFamilyOptions, prefix_extractor),
       BLACKLIST_ENTRY(ColumnFamilyOptions, max_bytes_for_level_multiplier_additional),
@@ -0,0 +1,625 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+// File backed implementation of PersistentCache.
+//
+// The cache is a sequence of append-only cache files named <number>.pcache in the cache
+// directory. Each file is a list of records:
+//
+//   masked crc32c: fixed32 (covers everything after it)
+//   key size:      fixed32
+//   value size:    fixed32
+//   key:           char[key size]
+//   value:         char[value size]
+//
+// Once a cache file is complete, i.e. when the next one is started or the cache is closed, its
+// index is written next to it as <number>.pcindex:
+//
+//   cache file size: fixed64 (bytes covered by the index)
+//   for each record: offset: varint64, value size: varint32, key: length prefixed
+//   masked crc32c:   fixed32 (covers everything before it)
+//
+// Inserts only queue the encoded record in memory. A background job scheduled on the Env appends
+// the queued records to the current cache file and publishes them in the in-memory index once
+// they are flushed, so neither readers nor inserters wait for disk writes. Queued records are
+// served from memory. Space is reclaimed by deleting whole files, oldest first, which gives FIFO
+// eviction at file granularity.
+//
+// Open loads the cache files left by a previous instance back into the index. A file whose index
+// is missing or invalid, e.g. the file that was being written when the process died, is scanned
+// instead, up to its first truncated or corrupted record. Callers must use keys that identify the
+// cached data across restarts. Lookup verifies the checksum and the key of every record it reads.
+
+#include <algorithm>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "yb/rocksdb/env.h"
+#include "yb/rocksdb/persistent_cache.h"
+#include "yb/rocksdb/port/port.h"
+#include "yb/rocksdb/util/coding.h"
+#include "yb/rocksdb/util/crc32c.h"
+#include "yb/rocksdb/util/logging.h"
+#include "yb/rocksdb/util/string_util.h"
+
+namespace rocksdb {
+
+namespace {
+
+constexpr char kCacheFileSuffix[] = ".pcache";
+constexpr char kIndexFileSuffix[] = ".pcindex";
+constexpr size_t kRecordHeaderSize = 3 * sizeof(uint32_t);
+constexpr size_t kMinCacheFileSize = 1024 * 1024;
+constexpr size_t kMaxCacheFileSize = 64 * 1024 * 1024;
+// Number of cache files the capacity is split into, which bounds how much is dropped at once.
+constexpr size_t kCacheFilesPerCapacity = 8;
+// Inserts are rejected while this many bytes are waiting to be written.
+constexpr size_t kMaxPendingBytes = 16 * 1024 * 1024;
+
+// Parses "<number><suffix>". Returns false if the name does not have this form.
+bool ParseCacheDirEntry(const std::string& name, const char* suffix, uint64_t* number) {
+  Slice input(name);
+  if (!input.ends_with(suffix)) {
+    return false;
+  }
+  input.remove_suffix(strlen(suffix));
+  return ConsumeDecimalNumber(&input, number) && input.empty();
+}
+
+class FilePersistentCache : public PersistentCache {
+ public:
+  FilePersistentCache(Env* env, const std::string& path, size_t capacity,
+                      const std::shared_ptr<Logger>& info_log)
+      : env_(env), path_(path), capacity_(capacity), info_log_(info_log),
+        file_size_limit_(std::max(kMinCacheFileSize,
+                                  std::min(kMaxCacheFileSize,
+                                           capacity / kCacheFilesPerCapacity))) {}
+
+  ~FilePersistentCache();
+
+  Status Open();
+
+  Status Insert(const Slice& key, const char* data, size_t size) override;
+
+  Status Lookup(const Slice& key, std::unique_ptr<char[]>* data, size_t* size) override;
+
+  size_t GetUsage() const override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return usage_;
+  }
+
+  size_t GetCapacity() const override { return capacity_; }
+
+ private:
+  // Location of a record in a cache file, as stored in the index files.
+  struct RecordLocation {
+    std::string key;
+    uint64_t offset;
+    uint32_t value_size;
+  };
+
+  struct CacheFile {
+    uint64_t number;
+    std::string name;
+    std::unique_ptr<RandomAccessFile> reader;
+    uint64_t size = 0;
+    // Records written to this file, used to drop index entries on eviction.
+    std::vector<RecordLocation> records;
+  };
+
+  struct IndexEntry {
+    std::shared_ptr<CacheFile> file;
+    uint64_t offset;
+    size_t key_size;
+    size_t value_size;
+  };
+
+  // Encoded record waiting to be written by the background job.
+  struct PendingRecord {
+    std::string key;
+    std::shared_ptr<const std::string> record;
+    // Set by the background job once the record is appended.
+    std::shared_ptr<CacheFile> file;
+    uint64_t offset = 0;
+  };
+
+  std::string CacheFileName(uint64_t number) const {
+    return path_ + "/" + ToString(number) + kCacheFileSuffix;
+  }
+
+  std::string IndexFileName(uint64_t number) const {
+    return path_ + "/" + ToString(number) + kIndexFileSuffix;
+  }
+
+  // Adds the records of the given cache file to the index, reading them from its index file or,
+  // if that is missing or invalid, from the cache file itself.
+  Status LoadFile(uint64_t number);
+
+  // Reads the index file of a cache file of the given size.
+  Status ReadIndexFile(uint64_t number, uint64_t file_size, uint64_t* valid_size,
+                       std::vector<RecordLocation>* records);
+
+  // Reads the records of a cache file up to the first truncated or corrupted one.
+  Status ScanCacheFile(RandomAccessFile* file, uint64_t file_size, uint64_t* valid_size,
+                       std::vector<RecordLocation>* records);
+
+  Status WriteIndexFile(uint64_t number, uint64_t valid_size,
+                        const std::vector<RecordLocation>& records);
+
+  static void BGWriteCallback(void* arg) {
+    static_cast<FilePersistentCache*>(arg)->BackgroundWrite();
+  }
+
+  // Called by the Env instead of BGWriteCallback if the scheduled job is dropped.
+  static void UnscheduleCallback(void* arg) {
+    auto* cache = static_cast<FilePersistentCache*>(arg);
+    std::lock_guard<std::mutex> lock(cache->mutex_);
+    cache->write_scheduled_ = false;
+    cache->write_done_cond_.notify_all();
+  }
+
+  // Writes the pending records until there are none left or the cache is closing.
+  void BackgroundWrite();
+
+  // Appends the records to the cache files and flushes them. Only called by the background job, or
+  // by the destructor once the job is done, without holding mutex_.
+  Status WriteRecords(std::vector<PendingRecord>* records);
+
+  // Publishes the written records in the index and drops them from the pending ones.
+  // REQUIRES: mutex_ held.
+  void PublishRecords(const std::vector<PendingRecord>& records, bool written);
+
+  // Completes the current cache file, if any, and starts a new one for appends.
+  Status RollFile();
+
+  // Closes the current cache file and writes its index.
+  Status CloseFile();
+
+  // Deletes the oldest cache files until the usage fits into the capacity.
+  // REQUIRES: mutex_ held.
+  void EvictIfNeeded();
+
+  Env* const env_;
+  const std::string path_;
+  const size_t capacity_;
+  const std::shared_ptr<Logger> info_log_;
+  const size_t file_size_limit_;
+
+  mutable std::mutex mutex_;
+  // Signalled when the background job is done.
+  std::condition_variable write_done_cond_;
+  std::unordered_map<std::string, IndexEntry> index_;
+  // Cache files ordered by number, i.e. from oldest to newest.
+  std::map<uint64_t, std::shared_ptr<CacheFile>> files_;
+  std::shared_ptr<CacheFile> current_file_;
+  size_t usage_ = 0;
+  // Records queued for the background job, in insertion order.
+  std::vector<PendingRecord> pending_;
+  // Latest not yet published record of each key, including the ones taken by the background job
+  // but not written yet.
+  std::unordered_map<std::string, std::shared_ptr<const std::string>> pending_index_;
+  size_t pending_bytes_ = 0;
+  // The background job is scheduled or running.
+  bool write_scheduled_ = false;
+  bool closing_ = false;
+
+  // Only used by the writer, i.e. the background job or the destructor.
+  std::unique_ptr<WritableFile> writer_;
+  uint64_t write_offset_ = 0;
+  // Records appended to the current file, written to its index when the file is complete.
+  std::vector<RecordLocation> writer_records_;
+  uint64_t next_file_number_ = 1;
+};
+
+FilePersistentCache::~FilePersistentCache() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closing_ = true;
+  }
+  // A job that has not started yet is dropped, a running one stops after its current batch.
+  env_->UnSchedule(this, Env::Priority::LOW);
+  std::vector<PendingRecord> records;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    write_done_cond_.wait(lock, [this] { return !write_scheduled_; });
+    records.swap(pending_);
+  }
+  // Write what is still pending, so that it is found after a restart.
+  if (!records.empty()) {
+    Status s = WriteRecords(&records);
+    WARN_NOT_OK(s, "Failed to write persistent cache records");
+    std::lock_guard<std::mutex> lock(mutex_);
+    PublishRecords(records, s.ok());
+  }
+  WARN_NOT_OK(CloseFile(), "Failed to close persistent cache file");
+}
+
+Status FilePersistentCache::Open() {
+  RETURN_NOT_OK(env_->CreateDirIfMissing(path_));
+  std::vector<std::string> children;
+  RETURN_NOT_OK(env_->GetChildren(path_, &children));
+  std::vector<uint64_t> cache_files;
+  std::vector<uint64_t> index_files;
+  for (const auto& child : children) {
+    uint64_t number = 0;
+    if (ParseCacheDirEntry(child, kCacheFileSuffix, &number)) {
+      cache_files.push_back(number);
+    } else if (ParseCacheDirEntry(child, kIndexFileSuffix, &number)) {
+      index_files.push_back(number);
+    }
+  }
+  std::sort(cache_files.begin(), cache_files.end());
+  for (const uint64_t number : index_files) {
+    if (!std::binary_search(cache_files.begin(), cache_files.end(), number)) {
+      RETURN_NOT_OK(env_->DeleteFile(IndexFileName(number)));
+    }
+  }
+
+  for (const uint64_t number : cache_files) {
+    Status s = LoadFile(number);
+    if (!s.ok()) {
+      RLOG(InfoLogLevel::WARN_LEVEL, info_log_,
+           "Dropping persistent cache file %s: %s",
+           CacheFileName(number).c_str(), s.ToString().c_str());
+      RETURN_NOT_OK(env_->DeleteFile(CacheFileName(number)));
+      if (env_->FileExists(IndexFileName(number)).ok()) {
+        RETURN_NOT_OK(env_->DeleteFile(IndexFileName(number)));
+      }
+    }
+    next_file_number_ = number + 1;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  EvictIfNeeded();
+  RLOG(InfoLogLevel::INFO_LEVEL, info_log_,
+       "Opened persistent cache at %s with %" ROCKSDB_PRIszt " entries in %" ROCKSDB_PRIszt
+       " files, %" ROCKSDB_PRIszt " bytes",
+       path_.c_str(), index_.size(), files_.size(), usage_);
+  return Status::OK();
+}
+
+Status FilePersistentCache::LoadFile(uint64_t number) {
+  auto file = std::make_shared<CacheFile>();
+  file->number = number;
+  file->name = CacheFileName(number);
+  uint64_t file_size = 0;
+  RETURN_NOT_OK(env_->GetFileSize(file->name, &file_size));
+  RETURN_NOT_OK(env_->NewRandomAccessFile(file->name, &file->reader, EnvOptions()));
+
+  uint64_t valid_size = 0;
+  Status s = ReadIndexFile(number, file_size, &valid_size, &file->records);
+  if (!s.ok()) {
+    RLOG(InfoLogLevel::INFO_LEVEL, info_log_,
+         "Scanning persistent cache file %s: %s", file->name.c_str(), s.ToString().c_str());
+    file->records.clear();
+    RETURN_NOT_OK(ScanCacheFile(file->reader.get(), file_size, &valid_size, &file->records));
+    // Next time the file is loaded from the index.
+    RETURN_NOT_OK(WriteIndexFile(number, valid_size, file->records));
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto& record : file->records) {
+    // Files are loaded from oldest to newest, so a later record of the same key wins.
+    index_[record.key] = IndexEntry{file, record.offset, record.key.size(), record.value_size};
+  }
+  file->size = valid_size;
+  usage_ += valid_size;
+  files_.emplace(number, std::move(file));
+  return Status::OK();
+}
+
+Status FilePersistentCache::ReadIndexFile(uint64_t number, uint64_t file_size,
+                                          uint64_t* valid_size,
+                                          std::vector<RecordLocation>* records) {
+  std::string contents;
+  RETURN_NOT_OK(ReadFileToString(env_, IndexFileName(number), &contents));
+  if (contents.size() < sizeof(uint64_t) + sizeof(uint32_t)) {
+    return STATUS(Corruption, "Truncated persistent cache index");
+  }
+  const size_t data_size = contents.size() - sizeof(uint32_t);
+  const uint32_t expected_crc = crc32c::Unmask(DecodeFixed32(contents.data() + data_size));
+  if (crc32c::Value(contents.data(), data_size) != expected_crc) {
+    return STATUS(Corruption, "Persistent cache index checksum mismatch");
+  }
+
+  Slice input(contents.data(), data_size);
+  GetFixed64(&input, valid_size);
+  if (*valid_size > file_size) {
+    return STATUS(Corruption, "Persistent cache index covers more than the cache file");
+  }
+  while (!input.empty()) {
+    RecordLocation record;
+    Slice key;
+    if (!GetVarint64(&input, &record.offset) || !GetVarint32(&input, &record.value_size) ||
+        !GetLengthPrefixedSlice(&input, &key)) {
+      return STATUS(Corruption, "Invalid persistent cache index entry");
+    }
+    if (record.offset + kRecordHeaderSize + key.size() + record.value_size > *valid_size) {
+      return STATUS(Corruption, "Persistent cache index entry is out of range");
+    }
+    record.key = key.ToBuffer();
+    records->push_back(std::move(record));
+  }
+  return Status::OK();
+}
+
+Status FilePersistentCache::ScanCacheFile(RandomAccessFile* file, uint64_t file_size,
+                                          uint64_t* valid_size,
+                                          std::vector<RecordLocation>* records) {
+  uint64_t offset = 0;
+  std::string buffer;
+  while (offset + kRecordHeaderSize <= file_size) {
+    char header_buffer[kRecordHeaderSize];
+    Slice header;
+    RETURN_NOT_OK(file->Read(offset, kRecordHeaderSize, &header, header_buffer));
+    if (header.size() != kRecordHeaderSize) {
+      break;
+    }
+    const uint32_t key_size = DecodeFixed32(header.cdata() + sizeof(uint32_t));
+    const uint32_t value_size = DecodeFixed32(header.cdata() + 2 * sizeof(uint32_t));
+    const uint64_t record_size = kRecordHeaderSize + key_size + value_size;
+    if (record_size > kMaxCacheFileSize || offset + record_size > file_size) {
+      break;
+    }
+    buffer.resize(record_size);
+    Slice record;
+    RETURN_NOT_OK(file->Read(offset, record_size, &record, &buffer[0]));
+    if (record.size() != record_size ||
+        crc32c::Unmask(DecodeFixed32(record.cdata())) !=
+            crc32c::Value(record.cdata() + sizeof(uint32_t), record_size - sizeof(uint32_t))) {
+      break;
+    }
+    records->push_back(RecordLocation{
+        std::string(record.cdata() + kRecordHeaderSize, key_size), offset, value_size});
+    offset += record_size;
+  }
+  *valid_size = offset;
+  return Status::OK();
+}
+
+Status FilePersistentCache::WriteIndexFile(uint64_t number, uint64_t valid_size,
+                                           const std::vector<RecordLocation>& records) {
+  std::string contents;
+  PutFixed64(&contents, valid_size);
+  for (const auto& record : records) {
+    PutVarint64(&contents, record.offset);
+    PutVarint32(&contents, record.value_size);
+    PutLengthPrefixedSlice(&contents, record.key);
+  }
+  PutFixed32(&contents, crc32c::Mask(crc32c::Value(contents.data(), contents.size())));
+  return WriteStringToFile(env_, contents, IndexFileName(number));
+}
+
+void FilePersistentCache::BackgroundWrite() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!closing_ && !pending_.empty()) {
+    std::vector<PendingRecord> records;
+    records.swap(pending_);
+    lock.unlock();
+    Status s = WriteRecords(&records);
+    if (!s.ok()) {
+      RLOG(InfoLogLevel::WARN_LEVEL, info_log_,
+           "Dropping %" ROCKSDB_PRIszt " persistent cache records: %s",
+           records.size(), s.ToString().c_str());
+    }
+    lock.lock();
+    PublishRecords(records, s.ok());
+  }
+  write_scheduled_ = false;
+  write_done_cond_.notify_all();
+}
+
+Status FilePersistentCache::WriteRecords(std::vector<PendingRecord>* records) {
+  Status s;
+  for (auto& record : *records) {
+    if (!writer_ || write_offset_ + record.record->size() > file_size_limit_) {
+      s = RollFile();
+      if (!s.ok()) {
+        break;
+      }
+    }
+    s = writer_->Append(*record.record);
+    if (!s.ok()) {
+      break;
+    }
+    record.file = current_file_;
+    record.offset = write_offset_;
+    writer_records_.push_back(RecordLocation{
+        record.key, write_offset_,
+        static_cast<uint32_t>(record.record->size() - kRecordHeaderSize - record.key.size())});
+    write_offset_ += record.record->size();
+  }
+  if (s.ok()) {
+    s = writer_->Flush();
+  }
+  if (!s.ok()) {
+    // Continue in a new file, the current one could end with a partial record. It gets no index,
+    // so a restart scans it up to the last complete record.
+    writer_.reset();
+    writer_records_.clear();
+  }
+  return s;
+}
+
+void FilePersistentCache::PublishRecords(const std::vector<PendingRecord>& records, bool written) {
+  for (const auto& record : records) {
+    const size_t record_size = record.record->size();
+    pending_bytes_ -= record_size;
+    auto it = pending_index_.find(record.key);
+    // A later insert of the same key replaces this record.
+    const bool latest = it != pending_index_.end() && it->second == record.record;
+    if (latest) {
+      pending_index_.erase(it);
+    }
+    if (!written) {
+      continue;
+    }
+    const size_t value_size = record_size - kRecordHeaderSize - record.key.size();
+    if (latest) {
+      index_[record.key] = IndexEntry{record.file, record.offset, record.key.size(), value_size};
+    }
+    record.file->records.push_back(RecordLocation{
+        record.key, record.offset, static_cast<uint32_t>(value_size)});
+    record.file->size += record_size;
+    usage_ += record_size;
+  }
+  EvictIfNeeded();
+}
+
+Status FilePersistentCache::CloseFile() {
+  if (!writer_) {
+    return Status::OK();
+  }
+  Status s = writer_->Close();
+  writer_.reset();
+  if (s.ok()) {
+    s = WriteIndexFile(current_file_->number, write_offset_, writer_records_);
+  }
+  writer_records_.clear();
+  return s;
+}
+
+Status FilePersistentCache::RollFile() {
+  RETURN_NOT_OK(CloseFile());
+  auto file = std::make_shared<CacheFile>();
+  file->number = next_file_number_++;
+  file->name = CacheFileName(file->number);
+  RETURN_NOT_OK(env_->NewWritableFile(file->name, &writer_, EnvOptions()));
+  RETURN_NOT_OK(env_->NewRandomAccessFile(file->name, &file->reader, EnvOptions()));
+  write_offset_ = 0;
+  std::lock_guard<std::mutex> lock(mutex_);
+  files_.emplace(file->number, file);
+  current_file_ = std::move(file);
+  return Status::OK();
+}
+
+void FilePersistentCache::EvictIfNeeded() {
+  while (usage_ > capacity_ && !files_.empty()) {
+    auto oldest = files_.begin()->second;
+    if (oldest == current_file_) {
+      break;
+    }
+    for (const auto& record : oldest->records) {
+      auto it = index_.find(record.key);
+      if (it != index_.end() && it->second.file == oldest) {
+        index_.erase(it);
+      }
+    }
+    usage_ -= oldest->size;
+    files_.erase(files_.begin());
+    // Readers that already picked up an entry from this file hold a reference to it, and POSIX
+    // keeps the open descriptor readable after the unlink.
+    WARN_NOT_OK(env_->DeleteFile(oldest->name), "Failed to delete persistent cache file");
+    const std::string index_file = IndexFileName(oldest->number);
+    if (env_->FileExists(index_file).ok()) {
+      WARN_NOT_OK(env_->DeleteFile(index_file), "Failed to delete persistent cache index");
+    }
+  }
+}
+
+Status FilePersistentCache::Insert(const Slice& key, const char* data, size_t size) {
+  const size_t record_size = kRecordHeaderSize + key.size() + size;
+  if (record_size > file_size_limit_) {
+    return STATUS(InvalidArgument, "Value is too large for the persistent cache");
+  }
+
+  auto record = std::make_shared<std::string>();
+  record->reserve(record_size);
+  PutFixed32(record.get(), 0);
+  PutFixed32(record.get(), static_cast<uint32_t>(key.size()));
+  PutFixed32(record.get(), static_cast<uint32_t>(size));
+  record->append(key.cdata(), key.size());
+  record->append(data, size);
+  const uint32_t crc = crc32c::Value(record->data() + sizeof(uint32_t),
+                                     record->size() - sizeof(uint32_t));
+  EncodeFixed32(&(*record)[0], crc32c::Mask(crc));
+
+  std::string key_str = key.ToBuffer();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (pending_bytes_ + record_size > kMaxPendingBytes) {
+      return STATUS(Busy, "Too many pending persistent cache writes");
+    }
+    pending_bytes_ += record_size;
+    pending_index_[key_str] = record;
+    pending_.push_back(PendingRecord{std::move(key_str), std::move(record)});
+    if (write_scheduled_) {
+      return Status::OK();
+    }
+    write_scheduled_ = true;
+  }
+  env_->Schedule(&FilePersistentCache::BGWriteCallback, this, Env::Priority::LOW, this,
+                 &FilePersistentCache::UnscheduleCallback);
+  return Status::OK();
+}
+
+Status FilePersistentCache::Lookup(
+    const Slice& key, std::unique_ptr<char[]>* data, size_t* size) {
+  IndexEntry entry;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const std::string key_str = key.ToBuffer();
+    auto pending_it = pending_index_.find(key_str);
+    if (pending_it != pending_index_.end()) {
+      const std::string& record = *pending_it->second;
+      const size_t value_offset = kRecordHeaderSize + key.size();
+      *size = record.size() - value_offset;
+      data->reset(new char[*size]);
+      memcpy(data->get(), record.data() + value_offset, *size);
+      return Status::OK();
+    }
+    auto it = index_.find(key_str);
+    if (it == index_.end()) {
+      return STATUS(NotFound, "Key is not in the persistent cache");
+    }
+    entry = it->second;
+  }
+
+  // The read itself is done without holding the mutex.
+  const size_t record_size = kRecordHeaderSize + entry.key_size + entry.value_size;
+  std::unique_ptr<char[]> buffer(new char[record_size]);
+  Slice record;
+  RETURN_NOT_OK(entry.file->reader->Read(entry.offset, record_size, &record, buffer.get()));
+  if (record.size() != record_size) {
+    return STATUS(Corruption, "Truncated persistent cache record");
+  }
+  const uint32_t expected_crc = crc32c::Unmask(DecodeFixed32(record.cdata()));
+  const uint32_t actual_crc = crc32c::Value(record.cdata() + sizeof(uint32_t),
+                                            record_size - sizeof(uint32_t));
+  if (expected_crc != actual_crc) {
+    return STATUS(Corruption, "Persistent cache record checksum mismatch");
+  }
+  if (Slice(record.cdata() + kRecordHeaderSize, entry.key_size) != key) {
+    return STATUS(Corruption, "Persistent cache record key mismatch");
+  }
+
+  data->reset(new char[entry.value_size]);
+  memcpy(data->get(), record.cdata() + kRecordHeaderSize + entry.key_size, entry.value_size);
+  *size = entry.value_size;
+  return Status::OK();
+}
+
+} // namespace
+
+Status NewFilePersistentCache(Env* env, const std::string& path, size_t capacity,
+                              const std::shared_ptr<Logger>& info_log,
+                              std::shared_ptr<PersistentCache>* cache) {
+  auto result = std::make_shared<FilePersistentCache>(env, path, capacity, info_log);
+  RETURN_NOT_OK(result->Open());
+  *cache = std::move(result);
+  return Status::OK();
+}
+
+}  // namespace rocksdb
@@ -0,0 +1,196 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "yb/rocksdb/env.h"
+#include "yb/rocksdb/persistent_cache.h"
+#include "yb/rocksdb/util/string_util.h"
+#include "yb/rocksdb/util/testharness.h"
+
+namespace rocksdb {
+
+class FilePersistentCacheTest : public testing::Test {
+ public:
+  FilePersistentCacheTest() : env_(Env::Default()) {
+    cache_dir_ = test::TmpDir(env_) + "/persistent_cache";
+    DestroyDir();
+  }
+
+  ~FilePersistentCacheTest() {
+    cache_.reset();
+    DestroyDir();
+  }
+
+  void DestroyDir() {
+    if (env_->FileExists(cache_dir_).IsNotFound()) {
+      return;
+    }
+    std::vector<std::string> children;
+    EXPECT_OK(env_->GetChildren(cache_dir_, &children));
+    for (const auto& child : children) {
+      if (child == "." || child == "..") {
+        continue;
+      }
+      EXPECT_OK(env_->DeleteFile(cache_dir_ + "/" + child));
+    }
+    EXPECT_OK(env_->DeleteDir(cache_dir_));
+  }
+
+  void OpenCache(size_t capacity) {
+    cache_.reset();
+    ASSERT_OK(NewFilePersistentCache(env_, cache_dir_, capacity, nullptr, &cache_));
+  }
+
+  // Inserts the value, waiting for the background writes when too many of them are pending.
+  void InsertValue(const std::string& key, const std::string& value) {
+    for (;;) {
+      Status s = cache_->Insert(key, value.data(), value.size());
+      if (!s.IsBusy()) {
+        ASSERT_OK(s);
+        return;
+      }
+      env_->SleepForMicroseconds(1000);
+    }
+  }
+
+  bool LookupValue(const std::string& key, std::string* value) {
+    std::unique_ptr<char[]> data;
+    size_t size = 0;
+    if (!cache_->Lookup(key, &data, &size).ok()) {
+      return false;
+    }
+    value->assign(data.get(), size);
+    return true;
+  }
+
+ protected:
+  Env* env_;
+  std::string cache_dir_;
+  std::shared_ptr<PersistentCache> cache_;
+};
+
+TEST_F(FilePersistentCacheTest, InsertAndLookup) {
+  OpenCache(64 * 1024 * 1024);
+  std::string value;
+  ASSERT_FALSE(LookupValue("key1", &value));
+
+  ASSERT_OK(cache_->Insert("key1", "value1", 6));
+  ASSERT_OK(cache_->Insert("key2", "value2", 6));
+  ASSERT_TRUE(LookupValue("key1", &value));
+  ASSERT_EQ("value1", value);
+  ASSERT_TRUE(LookupValue("key2", &value));
+  ASSERT_EQ("value2", value);
+
+  // Re-inserting a key replaces its value.
+  ASSERT_OK(cache_->Insert("key1", "updated", 7));
+  ASSERT_TRUE(LookupValue("key1", &value));
+  ASSERT_EQ("updated", value);
+}
+
+TEST_F(FilePersistentCacheTest, KeepsEntriesOnReopen) {
+  constexpr size_t kRecordHeaderSize = 12;
+  OpenCache(64 * 1024 * 1024);
+  size_t written_bytes = 0;
+  for (int i = 0; i < 100; ++i) {
+    const std::string key = "key" + ToString(i);
+    const std::string value = "value" + ToString(i);
+    InsertValue(key, value);
+    written_bytes += kRecordHeaderSize + key.size() + value.size();
+  }
+  InsertValue("key0", "updated");
+  written_bytes += kRecordHeaderSize + 4 + 7;
+
+  // Closing the cache writes the pending records and the index of the current file.
+  OpenCache(64 * 1024 * 1024);
+  ASSERT_EQ(written_bytes, cache_->GetUsage());
+  std::string value;
+  ASSERT_TRUE(LookupValue("key0", &value));
+  ASSERT_EQ("updated", value);
+  for (int i = 1; i < 100; ++i) {
+    ASSERT_TRUE(LookupValue("key" + ToString(i), &value));
+    ASSERT_EQ("value" + ToString(i), value);
+  }
+}
+
+TEST_F(FilePersistentCacheTest, ScansFilesWithoutValidIndex) {
+  OpenCache(64 * 1024 * 1024);
+  for (int i = 0; i < 100; ++i) {
+    InsertValue("key" + ToString(i), "value" + ToString(i));
+  }
+  cache_.reset();
+
+  // Simulate a crash while writing: the index is missing and the file ends with a partial record.
+  std::vector<std::string> children;
+  ASSERT_OK(env_->GetChildren(cache_dir_, &children));
+  std::string cache_file;
+  for (const auto& child : children) {
+    if (Slice(child).ends_with(".pcindex")) {
+      ASSERT_OK(env_->DeleteFile(cache_dir_ + "/" + child));
+    } else if (Slice(child).ends_with(".pcache")) {
+      cache_file = cache_dir_ + "/" + child;
+    }
+  }
+  ASSERT_FALSE(cache_file.empty());
+  const std::string index_file = cache_file.substr(0, cache_file.rfind('.')) + ".pcindex";
+  std::string contents;
+  ASSERT_OK(ReadFileToString(env_, cache_file, &contents));
+  contents.append(10, 'x');
+  ASSERT_OK(WriteStringToFile(env_, contents, cache_file));
+
+  OpenCache(64 * 1024 * 1024);
+  ASSERT_EQ(contents.size() - 10, cache_->GetUsage());
+  std::string value;
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_TRUE(LookupValue("key" + ToString(i), &value));
+    ASSERT_EQ("value" + ToString(i), value);
+  }
+  // The scan wrote a new index for the next open.
+  ASSERT_OK(env_->FileExists(index_file));
+
+  // A corrupted index is ignored as well.
+  cache_.reset();
+  ASSERT_OK(ReadFileToString(env_, index_file, &contents));
+  contents[contents.size() / 2] ^= 1;
+  ASSERT_OK(WriteStringToFile(env_, contents, index_file));
+  OpenCache(64 * 1024 * 1024);
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_TRUE(LookupValue("key" + ToString(i), &value));
+    ASSERT_EQ("value" + ToString(i), value);
+  }
+}
+
+TEST_F(FilePersistentCacheTest, EvictsOldestEntries) {
+  constexpr size_t kCapacity = 4 * 1024 * 1024;
+  constexpr int kNumEntries = 100;
+  OpenCache(kCapacity);
+  const std::string value(kCapacity / 10, 'x');
+  for (int i = 0; i < kNumEntries; ++i) {
+    InsertValue("key" + ToString(i), value);
+  }
+  ASSERT_LE(cache_->GetUsage(), kCapacity + 1024 * 1024);
+
+  std::string result;
+  ASSERT_FALSE(LookupValue("key0", &result));
+  ASSERT_TRUE(LookupValue("key" + ToString(kNumEntries - 1), &result));
+  ASSERT_EQ(value, result);
+}
+
+}  // namespace rocksdb
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -59,6 +59,7 @@
 #include "yb/gutil/strings/stringpiece.h"
 #include "yb/gutil/strings/substitute.h"
 #include "yb/gutil/strings/util.h"
+#include "yb/rpc/rpc_header.pb.h"
 #include "yb/util/status.h"
 #include "yb/util/string_case.h"
 
@@ -197,6 +198,8 @@ class MethodSubstitutions : public Substituter {
             StripNamespaceIfPossible(method_->service()->full_name(),
                                      method_->output_type()->full_name()));
     (*map)["metric_enum_key"] = strings::Substitute("kMetricIndex$0", method_->name());
+    (*map)["handler_latency_flags"] =
+        method_->options().GetExtension(striped_handler_latency) ? ", yb::STRIPED" : "";
   }
 
   // Strips the package from method arguments if they are in the same package as
@@ -474,7 +477,7 @@ class CodeGenerator : public ::google::protobuf::compiler::CodeGenerator {
           "  \"$rpc_full_name$ RPC Time\",\n"
           "  yb::MetricUnit::kMicroseconds,\n"
           "  \"Microseconds spent handling $rpc_full_name$() RPC requests\",\n"
-          "  60000000LU, 2);\n"
+          "  60000000LU, 2$handler_latency_flags$);\n"
           "\n");
         subs->Pop();
       }
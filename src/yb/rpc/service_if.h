@@ -37,6 +37,7 @@
 #include "yb/gutil/macros.h"
 #include "yb/gutil/ref_counted.h"
 #include "yb/rpc/rpc_fwd.h"
+#include "yb/util/enums.h"
 #include "yb/util/metrics.h"
 #include "yb/util/net/sockaddr.h"
 
@@ -60,12 +61,23 @@ struct RpcMethodMetrics {
   scoped_refptr<Histogram> handler_latency;
 };
 
+// Priority class of a method. Calls to methods of different classes are served by separate thread
+// pools, so that latency critical calls, such as consensus heartbeats, never wait behind other calls
+// in the same queue or for a worker blocked by a long running call.
+YB_DEFINE_ENUM(ServicePriority, (kNormal)(kHigh));
+
 // Handles incoming messages that initiate an RPC.
 class ServiceIf {
  public:
   virtual ~ServiceIf();
   virtual void Handle(InboundCallPtr incoming) = 0;
 
+  // Returns the priority class of the given method. High priority methods must be short and must
+  // never block, since the high priority pool has only a few workers.
+  virtual ServicePriority MethodPriority(const std::string& method_name) const {
+    return ServicePriority::kNormal;
+  }
+
   virtual void Shutdown();
   virtual std::string service_name() const = 0;
 };
@@ -59,7 +59,14 @@ METRIC_DEFINE_histogram(server, rpc_incoming_queue_time,
                         "RPC Queue Time",
                         yb::MetricUnit::kMicroseconds,
                         "Number of microseconds incoming RPC requests spend in the worker queue",
-                        60000000LU, 3);
+                        60000000LU, 3, yb::STRIPED);
+
+METRIC_DEFINE_histogram(server, rpc_incoming_queue_time_high_priority,
+                        "High Priority RPC Queue Time",
+                        yb::MetricUnit::kMicroseconds,
+                        "Number of microseconds incoming RPC requests to high priority services "
+                        "spend in the worker queue",
+                        60000000LU, 3, yb::STRIPED);
 
 METRIC_DEFINE_counter(server, rpcs_timed_out_in_queue,
                       "RPC Queue Timeouts",
@@ -80,8 +87,8 @@ namespace {
 
 class InboundCallTask final {
  public:
-  InboundCallTask(ServicePoolImpl* pool, InboundCallPtr call)
-      : pool_(pool), call_(std::move(call)) {
+  InboundCallTask(ServicePoolImpl* pool, InboundCallPtr call, bool high_priority)
+      : pool_(pool), call_(std::move(call)), high_priority_(high_priority) {
   }
 
   void Run();
@@ -90,6 +97,7 @@ class InboundCallTask final {
  private:
   ServicePoolImpl* pool_;
   InboundCallPtr call_;
+  bool high_priority_;
 };
 
 } // namespace
@@ -99,13 +107,20 @@ class ServicePoolImpl {
   ServicePoolImpl(size_t max_tasks,
        ThreadPool* thread_pool,
        std::unique_ptr<ServiceIf> service,
-       const scoped_refptr<MetricEntity>& entity)
+       const scoped_refptr<MetricEntity>& entity,
+       ThreadPool* high_priority_thread_pool)
       : thread_pool_(thread_pool),
+        high_priority_thread_pool_(high_priority_thread_pool),
         service_(std::move(service)),
         incoming_queue_time_(METRIC_rpc_incoming_queue_time.Instantiate(entity)),
         rpcs_timed_out_in_queue_(METRIC_rpcs_timed_out_in_queue.Instantiate(entity)),
         rpcs_queue_overflow_(METRIC_rpcs_queue_overflow.Instantiate(entity)),
         tasks_pool_(max_tasks) {
+    if (high_priority_thread_pool_) {
+      high_priority_incoming_queue_time_ =
+          METRIC_rpc_incoming_queue_time_high_priority.Instantiate(entity);
+      high_priority_tasks_pool_.reset(new TasksPool<InboundCallTask>(max_tasks));
+    }
   }
 
   ~ServicePoolImpl() {
@@ -120,9 +135,27 @@ class ServicePoolImpl {
   }
 
   void Enqueue(InboundCallPtr call) {
+    // Calls that already missed their deadline, e.g. while waiting to be read from the connection,
+    // would only take a queue slot and a worker away from calls that can still succeed.
+    if (PREDICT_FALSE(call->ClientTimedOut())) {
+      TimedOutInQueue(call, "Skipping call since client already timed out before it was queued");
+      return;
+    }
+
     TRACE_TO(call->trace(), "Inserting onto call queue");
 
-    if (!tasks_pool_.Enqueue(thread_pool_, this, std::move(call))) {
+    // High priority calls have their own workers and queue slots, so that neither a burst of other
+    // calls nor long running calls of the same service, such as remote bootstrap, can delay them.
+    if (high_priority_thread_pool_ &&
+        service_->MethodPriority(call->method_name()) == ServicePriority::kHigh) {
+      if (!high_priority_tasks_pool_->Enqueue(
+              high_priority_thread_pool_, this, std::move(call), true /* high_priority */)) {
+        Overflow(call, "service", high_priority_tasks_pool_->size());
+      }
+      return;
+    }
+
+    if (!tasks_pool_.Enqueue(thread_pool_, this, std::move(call), false /* high_priority */)) {
       Overflow(call, "service", tasks_pool_.size());
     }
   }
@@ -154,12 +187,13 @@ class ServicePoolImpl {
     call->RespondFailure(ErrorStatusPB::ERROR_SERVER_TOO_BUSY, response_status);
   }
 
-  void Processed(const InboundCallPtr& call, const Status& status) {
+  void Processed(const InboundCallPtr& call, const Status& status, bool high_priority) {
     if (status.ok()) {
       return;
     }
     if (status.IsServiceUnavailable()) {
-      Overflow(call, "global", thread_pool_->options().queue_limit);
+      auto* thread_pool = high_priority ? high_priority_thread_pool_ : thread_pool_;
+      Overflow(call, "global", thread_pool->options().queue_limit);
       return;
     }
     LOG(WARNING) << call->method_name() << " request on "
@@ -169,20 +203,13 @@ class ServicePoolImpl {
     call->RespondFailure(ErrorStatusPB::FATAL_SERVER_SHUTTING_DOWN, response_status);
   }
 
-  void Handle(InboundCallPtr incoming) {
-    incoming->RecordHandlingStarted(incoming_queue_time_);
+  void Handle(InboundCallPtr incoming, bool high_priority = false) {
+    incoming->RecordHandlingStarted(
+        high_priority ? high_priority_incoming_queue_time_ : incoming_queue_time_);
     ADOPT_TRACE(incoming->trace());
 
     if (PREDICT_FALSE(incoming->ClientTimedOut())) {
-      TRACE_TO(incoming->trace(), "Skipping call since client already timed out");
-      rpcs_timed_out_in_queue_->Increment();
-
-      // Respond as a failure, even though the client will probably ignore
-      // the response anyway.
-      incoming->RespondFailure(
-          ErrorStatusPB::ERROR_SERVER_TOO_BUSY,
-          STATUS(TimedOut, "Call waited in the queue past client deadline"));
-
+      TimedOutInQueue(incoming, "Skipping call since client already timed out");
       return;
     }
 
@@ -192,30 +219,47 @@ class ServicePoolImpl {
   }
 
  private:
+  void TimedOutInQueue(const InboundCallPtr& call, const char* message) {
+    TRACE_TO(call->trace(), message);
+    rpcs_timed_out_in_queue_->Increment();
+
+    // Respond as a failure, even though the client will probably ignore
+    // the response anyway.
+    call->RespondFailure(
+        ErrorStatusPB::ERROR_SERVER_TOO_BUSY,
+        STATUS(TimedOut, "Call waited in the queue past client deadline"));
+  }
+
   ThreadPool* thread_pool_;
+  // Null if all calls are handled by thread_pool_.
+  ThreadPool* high_priority_thread_pool_;
   std::unique_ptr<ServiceIf> service_;
   scoped_refptr<Histogram> incoming_queue_time_;
+  scoped_refptr<Histogram> high_priority_incoming_queue_time_;
   scoped_refptr<Counter> rpcs_timed_out_in_queue_;
   scoped_refptr<Counter> rpcs_queue_overflow_;
 
   std::atomic<bool> closing_ = {false};
   TasksPool<InboundCallTask> tasks_pool_;
+  std::unique_ptr<TasksPool<InboundCallTask>> high_priority_tasks_pool_;
 };
 
 void InboundCallTask::Run() {
-  pool_->Handle(call_);
+  pool_->Handle(call_, high_priority_);
 }
 
 void InboundCallTask::Done(const Status& status) {
   InboundCallPtr call = call_;
-  pool_->Processed(call, status);
+  pool_->Processed(call, status, high_priority_);
 }
 
 ServicePool::ServicePool(size_t max_tasks,
                          ThreadPool* thread_pool,
                          std::unique_ptr<ServiceIf> service,
-                         const scoped_refptr<MetricEntity>& metric_entity)
-    : impl_(new ServicePoolImpl(max_tasks, thread_pool, std::move(service), metric_entity)) {
+                         const scoped_refptr<MetricEntity>& metric_entity,
+                         ThreadPool* high_priority_thread_pool)
+    : impl_(new ServicePoolImpl(
+          max_tasks, thread_pool, std::move(service), metric_entity, high_priority_thread_pool)) {
 }
 
 ServicePool::~ServicePool() {
@@ -61,12 +61,16 @@ class ServicePoolImpl;
 
 // A pool of threads that handle new incoming RPC calls.
 // Also includes a queue that calls get pushed onto for handling by the pool.
+//
+// Calls to methods the service reports as ServicePriority::kHigh are handled by
+// high_priority_thread_pool, if one is given, and have their own queue slots.
 class ServicePool : public RpcService {
  public:
   ServicePool(size_t max_tasks,
               ThreadPool* thread_pool,
               std::unique_ptr<ServiceIf> service,
-              const scoped_refptr<MetricEntity>& metric_entity);
+              const scoped_refptr<MetricEntity>& metric_entity,
+              ThreadPool* high_priority_thread_pool = nullptr);
   virtual ~ServicePool();
 
   // Shut down the queue and the thread pool.
@@ -67,6 +67,11 @@ TAG_FLAG(rpc_server_allow_ephemeral_ports, unsafe);
 
 DEFINE_int32(rpc_queue_limit, 5000, "Queue limit for rpc server");
 DEFINE_int32(rpc_workers_limit, 128, "Workers limit for rpc server");
+DEFINE_int32(rpc_high_priority_workers_limit, 32,
+             "Workers limit for the high priority methods of the rpc server, such as consensus "
+             "heartbeats and votes. These methods have their own workers and queue, so they are "
+             "not delayed by other calls under load.");
+TAG_FLAG(rpc_high_priority_workers_limit, advanced);
 DECLARE_int32(rpc_default_keepalive_time_ms);
 
 namespace yb {
@@ -76,13 +81,16 @@ RpcServerOptions::RpcServerOptions()
     default_port(0),
     queue_limit(FLAGS_rpc_queue_limit),
     workers_limit(FLAGS_rpc_workers_limit),
+    high_priority_workers_limit(FLAGS_rpc_high_priority_workers_limit),
     connection_keepalive_time_ms(FLAGS_rpc_default_keepalive_time_ms) {
 }
 
 RpcServer::RpcServer(const std::string& name, RpcServerOptions opts)
     : server_state_(UNINITIALIZED),
       options_(std::move(opts)),
-      thread_pool_(new rpc::ThreadPool(name, options_.queue_limit, options_.workers_limit)) {}
+      thread_pool_(new rpc::ThreadPool(name, options_.queue_limit, options_.workers_limit)),
+      high_priority_thread_pool_(new rpc::ThreadPool(
+          name + "_high_priority", options_.queue_limit, options_.high_priority_workers_limit)) {}
 
 RpcServer::~RpcServer() {
   Shutdown();
@@ -127,8 +135,9 @@ Status RpcServer::RegisterService(size_t queue_limit, std::unique_ptr<rpc::Servi
         server_state_ == BOUND) << "bad state: " << server_state_;
   const scoped_refptr<MetricEntity>& metric_entity = messenger_->metric_entity();
   string service_name = service->service_name();
-  scoped_refptr<rpc::ServicePool> service_pool =
-    new rpc::ServicePool(queue_limit, thread_pool_.get(), std::move(service), metric_entity);
+  scoped_refptr<rpc::ServicePool> service_pool = new rpc::ServicePool(
+      queue_limit, thread_pool_.get(), std::move(service), metric_entity,
+      high_priority_thread_pool_.get());
   RETURN_NOT_OK(messenger_->RegisterService(service_name, service_pool));
   return Status::OK();
 }
@@ -165,6 +174,7 @@ Status RpcServer::Start() {
 
 void RpcServer::Shutdown() {
   thread_pool_->Shutdown();
+  high_priority_thread_pool_->Shutdown();
 
   if (messenger_) {
     messenger_->ShutdownAcceptor();
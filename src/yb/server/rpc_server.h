@@ -53,6 +53,7 @@ struct RpcServerOptions {
   uint16_t default_port;
   size_t queue_limit;
   size_t workers_limit;
+  size_t high_priority_workers_limit;
   int32_t connection_keepalive_time_ms;
 };
 
@@ -96,6 +97,8 @@ class RpcServer {
 
   const RpcServerOptions options_;
   std::unique_ptr<rpc::ThreadPool> thread_pool_;
+  // Serves the methods whose ServiceIf::MethodPriority is ServicePriority::kHigh.
+  std::unique_ptr<rpc::ThreadPool> high_priority_thread_pool_;
   std::shared_ptr<rpc::Messenger> messenger_;
 
   // Parsed addresses to bind RPC to. Set by Init().
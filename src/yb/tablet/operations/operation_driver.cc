@@ -230,6 +230,7 @@ Status OperationDriver::PrepareAndStart() {
       {
         std::lock_guard<simple_spinlock> lock(lock_);
         replication_state_ = REPLICATING;
+        replication_start_time_ = MonoTime::Now();
       }
 
       // After the batching changes from 07/2017, It is the caller's responsibility to call
@@ -319,6 +320,10 @@ void OperationDriver::ReplicationFinished(const Status& status) {
     std::lock_guard<simple_spinlock> lock(lock_);
     mutable_state()->mutable_op_id()->CopyFrom(op_id_local);
     CHECK_EQ(replication_state_, REPLICATING);
+    if (replication_start_time_) {
+      trace_->AddCost(TraceCost::kRaftWaitMicros,
+                      MonoTime::Now().GetDeltaSince(replication_start_time_).ToMicroseconds());
+    }
     if (status.ok()) {
       replication_state_ = REPLICATED;
     } else {
@@ -400,7 +405,10 @@ void OperationDriver::ApplyTask() {
   scoped_refptr<OperationDriver> ref(this);
 
   {
+    auto apply_start = MonoTime::Now();
     CHECK_OK(operation_->Apply());
+    trace_->AddCost(TraceCost::kApplyMicros,
+                    MonoTime::Now().GetDeltaSince(apply_start).ToMicroseconds());
 
     operation_->PreCommit();
 
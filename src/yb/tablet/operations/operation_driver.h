@@ -280,6 +280,10 @@ class OperationDriver : public RefCountedThreadSafe<OperationDriver>,
   ReplicationState replication_state_;
   PrepareState prepare_state_;
 
+  // The time when the leader started replicating the operation, used to account the Raft wait
+  // time of the operation in its trace. Not set on replicas.
+  MonoTime replication_start_time_;
+
   // The system monotonic time when the operation was prepared.
   // This is used for debugging only, not any actual operation ordering.
   MicrosecondsInt64 prepare_physical_hybrid_time_;
@@ -44,6 +44,7 @@
 #include <boost/optional.hpp>
 #include <boost/scope_exit.hpp>
 
+#include "yb/rocksdb/cache.h"
 #include "yb/rocksdb/db.h"
 #include "yb/rocksdb/options.h"
 #include "yb/rocksdb/statistics.h"
@@ -143,6 +144,7 @@ using yb::docdb::DocOperation;
 using yb::docdb::RedisWriteOperation;
 using yb::docdb::QLWriteOperation;
 using yb::docdb::DocDBCompactionFilterFactory;
+using yb::docdb::DocDBCompactionFileFilterFactory;
 using yb::docdb::IntentKind;
 using yb::docdb::IntentTypePair;
 using yb::docdb::KeyToIntentTypeMap;
@@ -254,6 +256,18 @@ CHECKED_STATUS EmitRocksDbMetricsAsPrometheus(
   return Status::OK();
 }
 
+rocksdb::CachePriority ToCachePriority(BlockCachePriorityPB priority) {
+  switch (priority) {
+    case BLOCK_CACHE_PRIORITY_DEFAULT:
+      return rocksdb::CachePriority::kDefault;
+    case BLOCK_CACHE_PRIORITY_HIGH:
+      return rocksdb::CachePriority::kHigh;
+    case BLOCK_CACHE_PRIORITY_LOW:
+      return rocksdb::CachePriority::kLow;
+  }
+  FATAL_INVALID_ENUM_VALUE(BlockCachePriorityPB, priority);
+}
+
 // Struct to pass data to WriteOperation related functions.
 struct WriteOperationData {
   WriteOperationState* operation_state;
@@ -334,6 +348,15 @@ Tablet::Tablet(
 
   flush_stats_ = make_shared<TabletFlushStats>();
   tablet_options_.listeners.emplace_back(flush_stats_);
+
+  // The block cache is shared by all tablets of the server, let the table decide how its blocks
+  // compete with those of other tables.
+  if (tablet_options_.block_cache) {
+    block_cache_with_priority_ = rocksdb::NewCacheWithPriority(
+        tablet_options_.block_cache,
+        ToCachePriority(schema()->table_properties().block_cache_priority()));
+    tablet_options_.block_cache = block_cache_with_priority_;
+  }
 }
 
 Tablet::~Tablet() {
@@ -368,8 +391,13 @@ Status Tablet::OpenKeyValueTablet() {
 
   // Install the history cleanup handler. Note that TabletRetentionPolicy is going to hold a raw ptr
   // to this tablet. So, we ensure that rocksdb_ is reset before this tablet gets destroyed.
-  rocksdb_options.compaction_filter_factory = make_shared<DocDBCompactionFilterFactory>(
-      make_shared<TabletRetentionPolicy>(this));
+  auto retention_policy = make_shared<TabletRetentionPolicy>(this);
+  rocksdb_options.compaction_filter_factory =
+      make_shared<DocDBCompactionFilterFactory>(retention_policy);
+  if (schema()->table_properties().drop_expired_files()) {
+    rocksdb_options.compaction_file_filter_factory =
+        make_shared<DocDBCompactionFileFilterFactory>(retention_policy);
+  }
 
   const string db_dir = metadata()->rocksdb_dir();
   LOG(INFO) << "Creating RocksDB database in dir " << db_dir;
@@ -956,6 +984,11 @@ Status Tablet::AlterSchema(AlterSchemaOperationState *operation_state) {
     }
 
     metadata_->SetSchema(*operation_state->schema(), operation_state->schema_version());
+    if (block_cache_with_priority_) {
+      // RocksDB keeps the block cache it was opened with, so change the priority of the view.
+      block_cache_with_priority_->SetPriority(ToCachePriority(
+          operation_state->schema()->table_properties().block_cache_priority()));
+    }
     if (operation_state->has_new_table_name()) {
       metadata_->SetTableName(operation_state->new_table_name());
       if (metric_entity_) {
@@ -1126,12 +1159,15 @@ Status Tablet::StartDocWriteOperation(const docdb::DocOperations &doc_ops,
 
   // We expect all read operations for this transaction to be done in ExecuteDocWriteOperation.
   // Once read_txn goes out of scope, the read point is deregistered.
-  RETURN_NOT_OK(docdb::ExecuteDocWriteOperation(
-      doc_ops, real_read_time, rocksdb_.get(), write_batch,
-      table_type_ == TableType::REDIS_TABLE_TYPE ? InitMarkerBehavior::kRequired
-                                                 : InitMarkerBehavior::kOptional,
-      &monotonic_counter_,
-      data.restart_read_ht));
+  {
+    docdb::ScopedTraceRocksDBCost rocksdb_cost;
+    RETURN_NOT_OK(docdb::ExecuteDocWriteOperation(
+        doc_ops, real_read_time, rocksdb_.get(), write_batch,
+        table_type_ == TableType::REDIS_TABLE_TYPE ? InitMarkerBehavior::kRequired
+                                                   : InitMarkerBehavior::kOptional,
+        &monotonic_counter_,
+        data.restart_read_ht));
+  }
 
   if (data.restart_read_ht->is_valid()) {
     return Status::OK();
@@ -535,6 +535,10 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // For the block cache and memory manager shared across tablets
   TabletOptions tablet_options_;
 
+  // View of the shared block cache with this table's block_cache_priority. Kept so that ALTER TABLE
+  // can change the priority of the cache regular_db_ was opened with.
+  std::shared_ptr<rocksdb::CacheWithPriority> block_cache_with_priority_;
+
   // A lightweight way to reject new operations when the tablet is shutting down. This is used to
   // prevent race conditions between destroying the RocksDB instance and read/write operations.
   std::atomic_bool shutdown_requested_{false};
@@ -46,11 +46,17 @@
 #include "yb/util/opid.h"
 #include "yb/util/logging.h"
 #include "yb/util/stopwatch.h"
+#include "yb/util/threadpool.h"
 
 DEFINE_bool(skip_remove_old_recovery_dir, false,
             "Skip removing WAL recovery dir after startup. (useful for debugging)");
 TAG_FLAG(skip_remove_old_recovery_dir, hidden);
 
+DEFINE_bool(tablet_bootstrap_prefetch_log_segments, true,
+            "Read and verify the next log segment on a separate thread while the current one is "
+            "being replayed during tablet bootstrap. Keeps up to two segments in memory.");
+TAG_FLAG(tablet_bootstrap_prefetch_log_segments, advanced);
+
 DEFINE_test_flag(double, fault_crash_during_log_replay, 0.0,
                  "Fraction of the time when the tablet will crash immediately "
                  "after processing a log entry during log replay.");
@@ -101,6 +107,22 @@ static string DebugInfo(const string& tablet_id,
                     segment_path, debug_str);
 }
 
+namespace {
+
+// Entries of a log segment, as read by ReadableLogSegment::ReadEntries.
+struct SegmentEntries {
+  log::LogEntries entries;
+  Status read_status;
+};
+
+SegmentEntries ReadSegmentEntries(const scoped_refptr<ReadableLogSegment>& segment) {
+  SegmentEntries result;
+  result.read_status = segment->ReadEntries(&result.entries);
+  return result;
+}
+
+} // namespace
+
 // ============================================================================
 //  Class ReplayState.
 // ============================================================================
@@ -641,11 +663,35 @@ Status TabletBootstrap::PlaySegments(ConsensusBootstrapInfo* consensus_info) {
   // from the log we're reading into the log we're writing.
   RETURN_NOT_OK_PREPEND(OpenNewLog(), "Failed to open new log");
 
-  int segment_count = 0;
-  for (const scoped_refptr<ReadableLogSegment>& segment : segments) {
-    log::LogEntries entries;
+  // While a segment is replayed, the next one is read, decoded and checksummed in a pool owned by
+  // this call. The pool is declared after the buffer it fills, so an early return shuts it down,
+  // waiting for the pending read, before the buffer is destroyed.
+  SegmentEntries next_segment_entries;
+  std::unique_ptr<ThreadPool> prefetch_pool;
+  if (FLAGS_tablet_bootstrap_prefetch_log_segments && segments.size() > 1) {
+    RETURN_NOT_OK(ThreadPoolBuilder("tb-prefetch").set_max_threads(1).Build(&prefetch_pool));
+  }
+  bool next_segment_prefetched = false;
+  for (size_t segment_idx = 0; segment_idx < segments.size(); ++segment_idx) {
+    const scoped_refptr<ReadableLogSegment>& segment = segments[segment_idx];
     // TODO: Optimize this to not read the whole thing into memory?
-    Status read_status = segment->ReadEntries(&entries);
+    SegmentEntries segment_entries;
+    if (next_segment_prefetched) {
+      prefetch_pool->Wait();
+      segment_entries = std::move(next_segment_entries);
+      next_segment_prefetched = false;
+    } else {
+      segment_entries = ReadSegmentEntries(segment);
+    }
+    if (prefetch_pool && segment_idx + 1 < segments.size()) {
+      scoped_refptr<ReadableLogSegment> next_segment = segments[segment_idx + 1];
+      RETURN_NOT_OK(prefetch_pool->SubmitFunc([&next_segment_entries, next_segment] {
+        next_segment_entries = ReadSegmentEntries(next_segment);
+      }));
+      next_segment_prefetched = true;
+    }
+    auto& entries = segment_entries.entries;
+    const Status& read_status = segment_entries.read_status;
     for (int entry_idx = 0; entry_idx < entries.size(); ++entry_idx) {
       Status s = HandleEntry(&state, &entries[entry_idx]);
       if (!s.ok()) {
@@ -676,10 +722,9 @@ Status TabletBootstrap::PlaySegments(ConsensusBootstrapInfo* consensus_info) {
     // number of MB processed, but this is better than nothing.
     listener_->StatusMessage(Substitute("Bootstrap replayed $0/$1 log segments. "
                                         "Stats: $2. Pending: $3 replicates",
-                                        segment_count + 1, log_reader_->num_segments(),
+                                        segment_idx + 1, log_reader_->num_segments(),
                                         stats_.ToString(),
                                         state.pending_replicates.size()));
-    segment_count++;
   }
 
   LOG(INFO) << "Dumping replay state to log at the end of " << __FUNCTION__;
@@ -15,6 +15,7 @@
 
 namespace rocksdb {
 class EventListener;
+class PersistentCache;
 }
 
 namespace yb {
@@ -22,6 +23,10 @@ namespace tablet {
 
 struct TabletOptions {
   std::shared_ptr<rocksdb::Cache> block_cache;
+  // Optional second cache tier holding compressed blocks, consulted on block_cache miss.
+  std::shared_ptr<rocksdb::Cache> block_cache_compressed;
+  // Optional on-device cache of raw data blocks, consulted before reading SST files.
+  std::shared_ptr<rocksdb::PersistentCache> persistent_cache;
   std::shared_ptr<rocksdb::MemoryMonitor> memory_monitor;
   std::vector<std::shared_ptr<rocksdb::EventListener>> listeners;
 };
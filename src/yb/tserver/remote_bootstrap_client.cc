@@ -32,6 +32,8 @@
 
 #include "yb/tserver/remote_bootstrap_client.h"
 
+#include <atomic>
+
 #include <gflags/gflags.h>
 #include <glog/logging.h>
 
@@ -44,6 +46,7 @@
 #include "yb/gutil/strings/substitute.h"
 #include "yb/gutil/strings/util.h"
 #include "yb/gutil/walltime.h"
+#include "yb/rocksdb/rate_limiter.h"
 #include "yb/rpc/messenger.h"
 #include "yb/rpc/rpc_controller.h"
 #include "yb/tablet/tablet.pb.h"
@@ -60,6 +63,7 @@
 #include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
 #include "yb/util/net/net_util.h"
+#include "yb/util/threadpool.h"
 
 DEFINE_int32(remote_bootstrap_begin_session_timeout_ms, 3000,
              "Tablet server RPC client timeout for BeginRemoteBootstrapSession calls.");
@@ -83,6 +87,18 @@ DEFINE_int32(committed_config_change_role_timeout_sec, 30,
              "timing out. ");
 TAG_FLAG(committed_config_change_role_timeout_sec, hidden);
 
+DEFINE_int32(remote_bootstrap_max_concurrent_downloads, 4,
+             "Maximum number of RocksDB files or WAL segments a remote bootstrap client downloads "
+             "concurrently.");
+TAG_FLAG(remote_bootstrap_max_concurrent_downloads, advanced);
+
+DEFINE_int64(remote_bootstrap_rate_limit_bytes_per_sec, 0,
+             "Maximum rate at which this tablet server downloads data for all of its remote "
+             "bootstrap sessions combined, so that re-replication does not starve foreground "
+             "traffic of disk and network bandwidth on either side. 0 means no limit.");
+TAG_FLAG(remote_bootstrap_rate_limit_bytes_per_sec, advanced);
+
+DECLARE_int32(remote_bootstrap_max_chunk_size);
 DECLARE_int32(rpc_max_message_size);
 
 DEFINE_test_flag(double, fault_crash_bootstrap_client_before_changing_role, 0.0,
@@ -98,6 +114,35 @@ DEFINE_test_flag(double, fault_crash_bootstrap_client_before_changing_role, 0.0,
 namespace yb {
 namespace tserver {
 
+namespace {
+
+// Returns the rate limiter shared by all remote bootstrap clients of this process, or null if
+// remote_bootstrap_rate_limit_bytes_per_sec is 0.
+rocksdb::RateLimiter* DownloadRateLimiter() {
+  static const std::unique_ptr<rocksdb::RateLimiter> rate_limiter(
+      FLAGS_remote_bootstrap_rate_limit_bytes_per_sec > 0
+          ? rocksdb::NewGenericRateLimiter(FLAGS_remote_bootstrap_rate_limit_bytes_per_sec)
+          : nullptr);
+  return rate_limiter.get();
+}
+
+// Blocks until the process-wide download rate limit allows receiving 'bytes' more bytes.
+void ThrottleDownload(int64_t bytes) {
+  auto* rate_limiter = DownloadRateLimiter();
+  if (!rate_limiter) {
+    return;
+  }
+  // A single request to the rate limiter must not exceed its burst size.
+  const int64_t burst = rate_limiter->GetSingleBurstBytes();
+  while (bytes > 0) {
+    const int64_t request = std::min(bytes, burst);
+    rate_limiter->Request(request, rocksdb::Env::IO_LOW);
+    bytes -= request;
+  }
+}
+
+} // namespace
+
 using consensus::ConsensusMetadata;
 using consensus::ConsensusStatePB;
 using consensus::OpId;
@@ -513,13 +558,11 @@ Status RemoteBootstrapClient::DownloadWALs() {
   // Download the WAL segments.
   int num_segments = wal_seqnos_.size();
   LOG_WITH_PREFIX(INFO) << "Starting download of " << num_segments << " WAL segments...";
-  uint64_t counter = 0;
-  for (uint64_t seg_seqno : wal_seqnos_) {
+  RETURN_NOT_OK(DownloadInParallel(num_segments, [this, num_segments](size_t idx) {
     UpdateStatusMessage(Substitute("Downloading WAL segment with seq. number $0 ($1/$2)",
-                                   seg_seqno, counter + 1, num_segments));
-    RETURN_NOT_OK(DownloadWAL(seg_seqno));
-    ++counter;
-  }
+                                   wal_seqnos_[idx], idx + 1, num_segments));
+    return DownloadWAL(wal_seqnos_[idx]);
+  }));
 
   downloaded_wal_ = true;
   return Status::OK();
@@ -541,21 +584,24 @@ Status RemoteBootstrapClient::DownloadRocksDBFiles() {
                         Substitute("Failed to create RocksDB tablet directory $0",
                                    rocksdb_dir));
 
-  for (auto const& file_pb : new_sb->rocksdb_files()) {
+  const auto& rocksdb_files = new_sb->rocksdb_files();
+  RETURN_NOT_OK(DownloadInParallel(rocksdb_files.size(), [&](size_t idx) -> Status {
+    const auto& file_pb = rocksdb_files.Get(idx);
     WritableFileOptions opts;
     opts.sync_on_close = true;
     gscoped_ptr<WritableFile> rocksdb_file;
     auto file_path = JoinPathSegments(rocksdb_dir, file_pb.name());
     RETURN_NOT_OK(fs_manager_->env()->NewWritableFile(opts, file_path, &rocksdb_file));
 
+    VLOG(2) << "Downloading file " << file_path;
     DataIdPB data_id;
     data_id.set_type(DataIdPB::ROCKSDB_FILE);
     data_id.set_file_name(file_pb.name());
     RETURN_NOT_OK_PREPEND(DownloadFile(data_id, rocksdb_file.get()),
                           Substitute("Unable to download rocksdb file $0",
                                      file_path));
-    VLOG(2) << "Downloading file " << file_path;
-  }
+    return rocksdb_file->Close();
+  }));
   new_superblock_.swap(new_sb);
   downloaded_rocksdb_files_ = true;
   return Status::OK();
@@ -576,6 +622,11 @@ Status RemoteBootstrapClient::DownloadWAL(uint64_t wal_segment_seqno) {
   RETURN_NOT_OK_PREPEND(DownloadFile(data_id, writer.get()),
                         Substitute("Unable to download WAL segment with seq. number $0",
                                    wal_segment_seqno));
+  // Close explicitly, so that a failed fsync is reported instead of being dropped in the
+  // destructor.
+  RETURN_NOT_OK_PREPEND(writer->Close(),
+                        Substitute("Unable to close WAL segment with seq. number $0",
+                                   wal_segment_seqno));
   return Status::OK();
 }
 
@@ -625,11 +676,64 @@ Status RemoteBootstrapClient::DownloadBlock(const BlockId& old_block_id,
   return Status::OK();
 }
 
+Status RemoteBootstrapClient::DownloadInParallel(
+    size_t count, const std::function<Status(size_t)>& download) {
+  const size_t num_threads = std::min<size_t>(
+      count, std::max(FLAGS_remote_bootstrap_max_concurrent_downloads, 1));
+  std::atomic<size_t> next_idx(0);
+  std::atomic<bool> failed(false);
+  auto worker = [&]() -> Status {
+    for (;;) {
+      const size_t idx = next_idx.fetch_add(1, std::memory_order_relaxed);
+      if (idx >= count || failed.load(std::memory_order_relaxed)) {
+        return Status::OK();
+      }
+      Status s = download(idx);
+      if (!s.ok()) {
+        failed.store(true, std::memory_order_relaxed);
+        return s;
+      }
+    }
+  };
+
+  // The calling thread is one of the workers, the others run in a pool owned by this call.
+  std::vector<Status> helper_results(num_threads - 1);
+  std::unique_ptr<ThreadPool> pool;
+  if (num_threads > 1) {
+    RETURN_NOT_OK(ThreadPoolBuilder("rb-download")
+                      .set_max_threads(num_threads - 1)
+                      .Build(&pool));
+    for (size_t i = 0; i != helper_results.size(); ++i) {
+      Status s = pool->SubmitFunc([&worker, &helper_results, i] {
+        helper_results[i] = worker();
+      });
+      if (!s.ok()) {
+        failed.store(true, std::memory_order_relaxed);
+        helper_results[i] = s;
+        break;
+      }
+    }
+  }
+  Status result = worker();
+  if (pool) {
+    pool->Wait();
+  }
+  for (const auto& s : helper_results) {
+    if (result.ok()) {
+      result = s;
+    }
+  }
+  return result;
+}
+
 template<class Appendable>
 Status RemoteBootstrapClient::DownloadFile(const DataIdPB& data_id,
                                            Appendable* appendable) {
   uint64_t offset = 0;
-  int32_t max_length = FLAGS_rpc_max_message_size - 1024; // Leave 1K for message headers.
+  // Leave 1K for message headers. Sources cut chunks to their remote_bootstrap_max_chunk_size, so
+  // that the download is paced in small steps.
+  int32_t max_length = std::min(FLAGS_rpc_max_message_size - 1024,
+                                FLAGS_remote_bootstrap_max_chunk_size);
 
   rpc::RpcController controller;
   controller.set_timeout(MonoDelta::FromMilliseconds(session_idle_timeout_millis_));
@@ -653,6 +757,7 @@ Status RemoteBootstrapClient::DownloadFile(const DataIdPB& data_id,
 
     // Write the data.
     RETURN_NOT_OK(appendable->Append(resp.chunk().data()));
+    ThrottleDownload(resp.chunk().data().size());
 
     if (offset + resp.chunk().data().size() == resp.chunk().total_data_length()) {
       done = true;
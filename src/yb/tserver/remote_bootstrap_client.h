@@ -32,6 +32,7 @@
 #ifndef YB_TSERVER_REMOTE_BOOTSTRAP_CLIENT_H
 #define YB_TSERVER_REMOTE_BOOTSTRAP_CLIENT_H
 
+#include <functional>
 #include <string>
 #include <memory>
 #include <vector>
@@ -73,10 +74,14 @@ class RemoteBootstrapServiceProxy;
 class TSTabletManager;
 
 // Client class for using remote bootstrap to copy a tablet from another host.
-// This class is not thread-safe.
+// The public methods of this class are not thread-safe.
 //
-// TODO:
-// * Parallelize download of blocks and WAL segments.
+// RocksDB files and WAL segments are downloaded concurrently by the workers of
+// DownloadInParallel(), see remote_bootstrap_max_concurrent_downloads. While they run, the workers
+// only read the set-once members, proxy_, session_id_, session_idle_timeout_millis_, meta_ and
+// wal_seqnos_, none of which change until all workers are done. The proxy and status_listener_
+// are thread-safe. Each worker writes only to the file it downloads, and no other member is
+// modified before DownloadInParallel() returns.
 //
 class RemoteBootstrapClient {
  public:
@@ -147,7 +152,7 @@ class RemoteBootstrapClient {
   // End the remote bootstrap session.
   CHECKED_STATUS EndRemoteSession();
 
-  // Download all WAL files sequentially.
+  // Download all WAL files.
   CHECKED_STATUS DownloadWALs();
 
   // Download a single WAL file.
@@ -177,6 +182,11 @@ class RemoteBootstrapClient {
 
   CHECKED_STATUS DownloadRocksDBFiles();
 
+  // Invokes 'download' for each index in [0, count), running up to
+  // remote_bootstrap_max_concurrent_downloads invocations concurrently. Stops starting new
+  // invocations after the first failure and returns it.
+  CHECKED_STATUS DownloadInParallel(size_t count, const std::function<Status(size_t)>& download);
+
   CHECKED_STATUS VerifyData(uint64_t offset, const DataChunkPB& resp);
 
   // Return standard log prefix.
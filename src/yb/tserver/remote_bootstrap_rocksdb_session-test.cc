@@ -13,6 +13,8 @@
 
 #include "remote_bootstrap_session-test.h"
 
+DECLARE_int32(remote_bootstrap_max_chunk_size);
+
 namespace yb {
 namespace tserver {
 
@@ -84,5 +86,33 @@ TEST_F(RemoteBootstrapRocksDBTest, TestNonExistentRocksDBFile) {
   ASSERT_TRUE(status.IsNotFound());
 }
 
+TEST_F(RemoteBootstrapRocksDBTest, TestFilePiecesAreCapped) {
+  constexpr int32_t kMaxChunkSize = 4096;
+  FLAGS_remote_bootstrap_max_chunk_size = kMaxChunkSize;
+
+  auto superblock = session_->tablet_superblock();
+  ASSERT_GT(superblock.rocksdb_files().size(), 0);
+  auto largest_file = superblock.rocksdb_files(0);
+  for (const auto& file : superblock.rocksdb_files()) {
+    if (file.size_bytes() > largest_file.size_bytes()) {
+      largest_file = file;
+    }
+  }
+
+  // The whole file is read back in chunks of at most kMaxChunkSize, even though the requests do
+  // not limit their length.
+  uint64_t offset = 0;
+  while (offset < largest_file.size_bytes()) {
+    string data;
+    int64_t total_data_length = 0;
+    RemoteBootstrapErrorPB::Code error_code;
+    ASSERT_OK(session_->GetFilePiece(largest_file.name(), offset, 0, &data, &total_data_length,
+                                     &error_code));
+    ASSERT_EQ(largest_file.size_bytes(), static_cast<uint64_t>(total_data_length));
+    ASSERT_EQ(std::min<uint64_t>(kMaxChunkSize, largest_file.size_bytes() - offset), data.size());
+    offset += data.size();
+  }
+}
+
 }  // namespace tserver
 }  // namespace yb
@@ -102,6 +102,12 @@ DEFINE_test_flag(double, fault_crash_leader_after_changing_role, 0.0,
 DEFINE_uint64(remote_bootstrap_change_role_timeout_ms, 15000,
               "Timeout for change role operation during remote bootstrap.");
 
+METRIC_DEFINE_counter(server, remote_bootstrap_bytes_sent,
+                      "Remote Bootstrap Bytes Sent",
+                      yb::MetricUnit::kBytes,
+                      "Number of bytes of data files and WAL segments sent to remote bootstrap "
+                      "clients.");
+
 namespace yb {
 namespace tserver {
 
@@ -130,6 +136,7 @@ RemoteBootstrapServiceImpl::RemoteBootstrapServiceImpl(
     : RemoteBootstrapServiceIf(metric_entity),
       fs_manager_(CHECK_NOTNULL(fs_manager)),
       tablet_peer_lookup_(CHECK_NOTNULL(tablet_peer_lookup)),
+      bytes_sent_(METRIC_remote_bootstrap_bytes_sent.Instantiate(metric_entity)),
       shutdown_latch_(1) {
   CHECK_OK(Thread::Create("remote-bootstrap", "rb-session-exp",
                           &RemoteBootstrapServiceImpl::EndExpiredSessions, this,
@@ -275,6 +282,8 @@ void RemoteBootstrapServiceImpl::FetchData(const FetchDataRequestPB* req,
   uint32_t crc32 = Crc32c(data->data(), data->length());
   data_chunk->set_crc32(crc32);
 
+  bytes_sent_->IncrementBy(data->size());
+
   context.RespondSuccess();
 }
 
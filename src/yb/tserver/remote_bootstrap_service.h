@@ -110,6 +110,8 @@ class RemoteBootstrapServiceImpl : public RemoteBootstrapServiceIf {
   FsManager* fs_manager_;
   TabletPeerLookupIf* tablet_peer_lookup_;
 
+  scoped_refptr<Counter> bytes_sent_;
+
   // Protects sessions_ and session_expirations_ maps.
   mutable simple_spinlock sessions_lock_;
   SessionMap sessions_;
@@ -42,9 +42,19 @@
 #include "yb/gutil/type_traits.h"
 #include "yb/server/metadata.h"
 #include "yb/tablet/tablet_peer.h"
+#include "yb/util/flag_tags.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/stopwatch.h"
 #include "yb/util/trace.h"
 
+using yb::operator"" _MB;
+
+DEFINE_int32(remote_bootstrap_max_chunk_size, 1_MB,
+             "Maximum number of bytes of a file that a remote bootstrap source reads and sends "
+             "for one FetchData request. Larger requests are cut to this size, so that a source "
+             "never reads a whole WAL segment or SST file in one go.");
+TAG_FLAG(remote_bootstrap_max_chunk_size, advanced);
+
 DECLARE_int32(rpc_max_message_size);
 
 namespace yb {
@@ -71,6 +81,7 @@ RemoteBootstrapSession::RemoteBootstrapSession(
       fs_manager_(fs_manager),
       blocks_deleter_(&blocks_),
       logs_deleter_(&logs_),
+      rocksdb_files_deleter_(&rocksdb_files_),
       succeeded_(false) {}
 
 RemoteBootstrapSession::~RemoteBootstrapSession() {
@@ -257,12 +268,16 @@ static int64_t DetermineReadLength(int64_t bytes_remaining, int64_t requested_le
   // Determine the size of the chunks we want to read.
   // Choose "system max" as a multiple of typical HDD block size (4K) with 4K to
   // spare for other stuff in the message, like headers, other protobufs, etc.
+  // It is further capped by remote_bootstrap_max_chunk_size, which bounds the size of each read
+  // on the source.
   const int32_t kSpareBytes = 4096;
   const int32_t kDiskSectorSize = 4096;
   int32_t system_max_chunk_size =
-      ((FLAGS_rpc_max_message_size - kSpareBytes) / kDiskSectorSize) * kDiskSectorSize;
-  CHECK_GT(system_max_chunk_size, 0) << "rpc_max_message_size is too low to transfer data: "
-                                     << FLAGS_rpc_max_message_size;
+      (std::min(FLAGS_rpc_max_message_size - kSpareBytes, FLAGS_remote_bootstrap_max_chunk_size) /
+           kDiskSectorSize) * kDiskSectorSize;
+  CHECK_GT(system_max_chunk_size, 0)
+      << "rpc_max_message_size or remote_bootstrap_max_chunk_size is too low to transfer data: "
+      << FLAGS_rpc_max_message_size << ", " << FLAGS_remote_bootstrap_max_chunk_size;
 
   // The min of the {requested, system} maxes is the effective max.
   int64_t maxlen = (requested_len > 0) ? std::min<int64_t>(requested_len, system_max_chunk_size) :
@@ -376,7 +391,27 @@ Status RemoteBootstrapSession::GetFilePiece(const std::string file_name,
                                             uint64_t offset, int64_t client_maxlen,
                                             std::string* data, int64_t* block_file_size,
                                             RemoteBootstrapErrorPB::Code* error_code) {
+  ImmutableRandomAccessFileInfo* file_info;
+  RETURN_NOT_OK(FindRocksDBFile(file_name, &file_info, error_code));
+  RETURN_NOT_OK(ReadFileChunkToBuf(file_info, offset, client_maxlen,
+                                   Substitute("rocksdb file $0", file_name),
+                                   data, block_file_size, error_code));
 
+  return Status::OK();
+}
+
+Status RemoteBootstrapSession::FindRocksDBFile(const std::string& file_name,
+                                               ImmutableRandomAccessFileInfo** file_info,
+                                               RemoteBootstrapErrorPB::Code* error_code) {
+  {
+    boost::lock_guard<simple_spinlock> l(session_lock_);
+    if (FindCopy(rocksdb_files_, file_name, file_info)) {
+      return Status::OK();
+    }
+  }
+
+  // Open the file without holding the session lock. If several chunks of the same file are
+  // requested concurrently, the first one to finish opening wins.
   auto file_path = JoinPathSegments(checkpoint_dir_, file_name);
   if (!fs_manager_->env()->FileExists(file_path)) {
     *error_code = RemoteBootstrapErrorPB::ROCKSDB_FILE_NOT_FOUND;
@@ -385,22 +420,20 @@ Status RemoteBootstrapSession::GetFilePiece(const std::string file_name,
   }
 
   gscoped_ptr<RandomAccessFile> readable_file;
-  shared_ptr<RandomAccessFile> readable_file_shared_ptr;
-
   RETURN_NOT_OK(fs_manager_->env()->NewRandomAccessFile(file_path, &readable_file));
 
   uint64 file_size = 0;
   RETURN_NOT_OK(readable_file->Size(&file_size));
-  VLOG(2) << "Reading RocksDB file. File path: " << file_path << " file size: " << file_size;
-
-  readable_file_shared_ptr.reset(readable_file.release());
-
-  std::unique_ptr<ImmutableRandomAccessFileInfo> file_info(
-      new ImmutableRandomAccessFileInfo(readable_file_shared_ptr, file_size));
-  RETURN_NOT_OK(ReadFileChunkToBuf(file_info.get(), offset, client_maxlen,
-                                   Substitute("rocksdb file $0", file_name),
-                                   data, block_file_size, error_code));
+  VLOG(2) << "Opened RocksDB file. File path: " << file_path << " file size: " << file_size;
 
+  std::unique_ptr<ImmutableRandomAccessFileInfo> new_info(new ImmutableRandomAccessFileInfo(
+      shared_ptr<RandomAccessFile>(readable_file.release()), file_size));
+  boost::lock_guard<simple_spinlock> l(session_lock_);
+  auto it = rocksdb_files_.emplace(file_name, new_info.get());
+  if (it.second) {
+    ignore_result(new_info.release());
+  }
+  *file_info = it.first->second;
   return Status::OK();
 }
 
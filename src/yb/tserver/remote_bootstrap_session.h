@@ -170,6 +170,7 @@ class RemoteBootstrapSession : public RefCountedThreadSafe<RemoteBootstrapSessio
 
   typedef std::unordered_map<BlockId, ImmutableReadableBlockInfo*, BlockIdHash> BlockMap;
   typedef std::unordered_map<uint64_t, ImmutableRandomAccessFileInfo*> LogMap;
+  typedef std::unordered_map<std::string, ImmutableRandomAccessFileInfo*> RocksDBFileMap;
 
   ~RemoteBootstrapSession();
 
@@ -189,6 +190,11 @@ class RemoteBootstrapSession : public RefCountedThreadSafe<RemoteBootstrapSessio
                         ImmutableRandomAccessFileInfo** file_info,
                         RemoteBootstrapErrorPB::Code* error_code);
 
+  // Look up a rocksdb checkpoint file in the cache, opening it on first access.
+  CHECKED_STATUS FindRocksDBFile(const std::string& file_name,
+                                 ImmutableRandomAccessFileInfo** file_info,
+                                 RemoteBootstrapErrorPB::Code* error_code);
+
   // Unregister log anchor, if it's registered.
   CHECKED_STATUS UnregisterAnchorIfNeededUnlocked();
 
@@ -204,8 +210,12 @@ class RemoteBootstrapSession : public RefCountedThreadSafe<RemoteBootstrapSessio
 
   BlockMap blocks_; // Protected by session_lock_.
   LogMap logs_;     // Protected by session_lock_.
+  // Checkpoint files are immutable, so each one is opened once per session rather than once per
+  // fetched chunk.
+  RocksDBFileMap rocksdb_files_; // Protected by session_lock_.
   ValueDeleter blocks_deleter_;
   ValueDeleter logs_deleter_;
+  ValueDeleter rocksdb_files_deleter_;
 
   tablet::TabletSuperBlockPB tablet_superblock_;
 
@@ -30,6 +30,8 @@
 // under the License.
 //
 
+#include "yb/common/wire_protocol.h"
+
 #include "yb/consensus/log-test-base.h"
 
 #include "yb/gutil/strings/escaping.h"
@@ -66,6 +68,8 @@ using std::shared_ptr;
 using std::string;
 using strings::Substitute;
 
+using namespace std::literals;
+
 DEFINE_int32(single_threaded_insert_latency_bench_warmup_rows, 100,
              "Number of rows to insert in the warmup phase of the single threaded"
              " tablet server insert latency micro-benchmark");
@@ -79,6 +83,8 @@ DECLARE_int32(metrics_retirement_age_ms);
 DECLARE_string(block_manager);
 DECLARE_string(rpc_bind_addresses);
 DECLARE_bool(disable_clock_sync_error);
+DECLARE_int32(rpc_workers_limit);
+DECLARE_int32(inject_latency_on_start_remote_bootstrap_ms);
 
 // Declare these metrics prototypes for simpler unit testing of their behavior.
 METRIC_DECLARE_counter(rows_inserted);
@@ -674,6 +680,59 @@ TEST_F(TabletServerTest, TestConcurrentDeleteTablet) {
   ASSERT_EQ(1, num_success);
 }
 
+class TabletServerFewRpcWorkersTest : public TabletServerTestBase {
+ public:
+  static constexpr int kRpcWorkers = 4;
+
+  void SetUp() override {
+    FLAGS_rpc_workers_limit = kRpcWorkers;
+    TabletServerTestBase::SetUp();
+    StartTabletServer();
+  }
+};
+
+// Long running consensus calls, such as StartRemoteBootstrap, must not delay consensus heartbeats,
+// even when they occupy all regular RPC workers.
+TEST_F(TabletServerFewRpcWorkersTest, BlockedRemoteBootstrapDoesNotDelayUpdateConsensus) {
+  const auto kBootstrapLatency = 6s;
+  FLAGS_inject_latency_on_start_remote_bootstrap_ms = ToMilliseconds(kBootstrapLatency);
+
+  const string uuid = mini_server_->server()->fs_manager()->uuid();
+  consensus::StartRemoteBootstrapRequestPB rb_req;
+  rb_req.set_dest_uuid(uuid);
+  rb_req.set_tablet_id(kTabletId);
+  rb_req.set_bootstrap_peer_uuid("fake-peer");
+  ASSERT_OK(HostPortToPB(HostPort("127.0.0.1", 1), rb_req.mutable_bootstrap_peer_addr()));
+
+  consensus::StartRemoteBootstrapResponsePB rb_resps[kRpcWorkers];
+  RpcController rb_rpcs[kRpcWorkers];
+  CountDownLatch latch(kRpcWorkers);
+  for (int i = 0; i < kRpcWorkers; i++) {
+    rb_rpcs[i].set_timeout(kBootstrapLatency * 3);
+    consensus_proxy_->StartRemoteBootstrapAsync(
+        rb_req, &rb_resps[i], &rb_rpcs[i], [&latch]() { latch.CountDown(); });
+  }
+  // Let the server pick up the remote bootstrap calls, so that they block all regular workers.
+  SleepFor(500ms);
+
+  consensus::ConsensusRequestPB req;
+  consensus::ConsensusResponsePB resp;
+  RpcController rpc;
+  req.set_dest_uuid(uuid);
+  req.set_tablet_id(kTabletId);
+  req.set_caller_uuid("fake-leader");
+  req.set_caller_term(0);
+  rpc.set_timeout(kBootstrapLatency / 2);
+  const auto start = MonoTime::Now();
+  ASSERT_OK(consensus_proxy_->UpdateConsensus(req, &resp, &rpc));
+  ASSERT_LT(MonoTime::Now() - start, MonoDelta(kBootstrapLatency / 2));
+
+  latch.Wait();
+  for (int i = 0; i < kRpcWorkers; i++) {
+    ASSERT_OK(rb_rpcs[i].status());
+  }
+}
+
 TEST_F(TabletServerTest, TestInsertLatencyMicroBenchmark) {
   METRIC_DEFINE_entity(test);
   METRIC_DEFINE_histogram(test, insert_latency,
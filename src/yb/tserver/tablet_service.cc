@@ -46,6 +46,7 @@
 
 #include "yb/docdb/doc_operation.h"
 #include "yb/docdb/doc_rowwise_iterator.h"
+#include "yb/docdb/docdb_rocksdb_util.h"
 
 #include "yb/gutil/bind.h"
 #include "yb/gutil/casts.h"
@@ -106,6 +107,10 @@ DEFINE_int32(scanner_inject_latency_on_each_batch_ms, 0,
              "Used for tests.");
 TAG_FLAG(scanner_inject_latency_on_each_batch_ms, unsafe);
 
+DEFINE_test_flag(int32, inject_latency_on_start_remote_bootstrap_ms, 0,
+                 "Sleep for the specified number of milliseconds before handling "
+                 "StartRemoteBootstrap, to simulate a long running remote bootstrap.");
+
 DECLARE_int32(memory_limit_warn_threshold_percentage);
 
 DEFINE_int32(max_wait_for_safe_time_ms, 5000,
@@ -186,6 +191,16 @@ Status GetTabletRef(const scoped_refptr<TabletPeer>& tablet_peer,
   return Status::OK();
 }
 
+void FillRequestCost(const Trace& trace, RequestCostPB* cost) {
+  cost->set_keys_scanned(trace.TotalCost(TraceCost::kKeysScanned));
+  cost->set_blocks_read(trace.TotalCost(TraceCost::kBlocksRead));
+  cost->set_block_cache_hits(trace.TotalCost(TraceCost::kBlockCacheHits));
+  cost->set_bytes_read(trace.TotalCost(TraceCost::kBytesRead));
+  cost->set_lock_wait_micros(trace.TotalCost(TraceCost::kLockWaitMicros));
+  cost->set_raft_wait_micros(trace.TotalCost(TraceCost::kRaftWaitMicros));
+  cost->set_apply_micros(trace.TotalCost(TraceCost::kApplyMicros));
+}
+
 } // namespace
 
 // Prepares modification operation, checks limits, fetches tablet_peer and tablet etc.
@@ -260,9 +275,10 @@ class WriteOperationCompletionCallback : public OperationCompletionCallback {
       WriteResponsePB* response,
       tablet::WriteOperationState* state,
       const server::ClockPtr& clock,
-      bool trace = false)
+      bool trace = false,
+      bool cost = false)
       : context_(std::move(context)), response_(response), state_(state), clock_(clock),
-        include_trace_(trace) {}
+        include_trace_(trace), include_cost_(cost) {}
 
   void OperationCompleted() override {
     if (!status_.ok()) {
@@ -289,6 +305,9 @@ class WriteOperationCompletionCallback : public OperationCompletionCallback {
       if (include_trace_ && Trace::CurrentTrace() != nullptr) {
         response_->set_trace_buffer(Trace::CurrentTrace()->DumpToString(true));
       }
+      if (include_cost_ && FLAGS_enable_tracing) {
+        FillRequestCost(*context_->trace(), response_->mutable_cost());
+      }
       response_->set_propagated_hybrid_time(clock_->Now().ToUint64());
       context_->RespondSuccess();
     }
@@ -305,6 +324,7 @@ class WriteOperationCompletionCallback : public OperationCompletionCallback {
   tablet::WriteOperationState* const state_;
   server::ClockPtr clock_;
   const bool include_trace_;
+  const bool include_cost_;
 };
 
 // Checksums the scan result.
@@ -677,7 +697,8 @@ void TabletServiceImpl::Write(const WriteRequestPB* req,
   auto context_ptr = std::make_shared<RpcContext>(std::move(context));
   operation_state->set_completion_callback(
       std::make_unique<WriteOperationCompletionCallback>(
-          context_ptr, resp, operation_state.get(), server_->Clock(), req->include_trace()));
+          context_ptr, resp, operation_state.get(), server_->Clock(), req->include_trace(),
+          req->include_cost()));
 
   auto status = tablet_peer->SubmitWrite(std::move(operation_state));
 
@@ -865,6 +886,9 @@ void TabletServiceImpl::Read(const ReadRequestPB* req,
   if (req->include_trace() && Trace::CurrentTrace() != nullptr) {
     resp->set_trace_buffer(Trace::CurrentTrace()->DumpToString(true));
   }
+  if (req->include_cost() && FLAGS_enable_tracing) {
+    FillRequestCost(*context.trace(), resp->mutable_cost());
+  }
   RpcOperationCompletionCallback<ReadResponsePB> callback(
       std::move(context), resp, server_->Clock());
   callback.OperationCompleted();
@@ -878,6 +902,7 @@ Result<ReadHybridTime> TabletServiceImpl::DoRead(tablet::AbstractTablet* tablet,
                                                  HostPortPB* host_port_pb,
                                                  ReadResponsePB* resp,
                                                  rpc::RpcContext* context) {
+  docdb::ScopedTraceRocksDBCost rocksdb_cost;
   tablet::RequireLease require_lease(req->consistency_level() == YBConsistencyLevel::STRONG);
   tablet::ScopedReadOperation read_tx(tablet, require_lease, read_time);
   switch (tablet->table_type()) {
@@ -933,6 +958,15 @@ ConsensusServiceImpl::ConsensusServiceImpl(const scoped_refptr<MetricEntity>& me
 ConsensusServiceImpl::~ConsensusServiceImpl() {
 }
 
+rpc::ServicePriority ConsensusServiceImpl::MethodPriority(const std::string& method_name) const {
+  // Only heartbeats and votes, which are short and decide whether a leader keeps its lease. Calls
+  // such as StartRemoteBootstrap or ChangeConfig can block for a long time and would starve them.
+  if (method_name == "UpdateConsensus" || method_name == "RequestConsensusVote") {
+    return rpc::ServicePriority::kHigh;
+  }
+  return rpc::ServicePriority::kNormal;
+}
+
 void ConsensusServiceImpl::UpdateConsensus(const ConsensusRequestPB* req,
                                            ConsensusResponsePB* resp,
                                            rpc::RpcContext context) {
@@ -1185,6 +1219,9 @@ void ConsensusServiceImpl::GetConsensusState(const consensus::GetConsensusStateR
 void ConsensusServiceImpl::StartRemoteBootstrap(const StartRemoteBootstrapRequestPB* req,
                                                 StartRemoteBootstrapResponsePB* resp,
                                                 rpc::RpcContext context) {
+  if (PREDICT_FALSE(FLAGS_inject_latency_on_start_remote_bootstrap_ms > 0)) {
+    SleepFor(MonoDelta::FromMilliseconds(FLAGS_inject_latency_on_start_remote_bootstrap_ms));
+  }
   if (!CheckUuidMatchOrRespond(tablet_manager_, "StartRemoteBootstrap", req, resp, &context)) {
     return;
   }
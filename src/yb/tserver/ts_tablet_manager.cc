@@ -60,7 +60,11 @@
 #include "yb/master/master.pb.h"
 #include "yb/master/sys_catalog.h"
 
+#include "yb/rocksdb/env.h"
 #include "yb/rocksdb/memory_monitor.h"
+#include "yb/rocksdb/persistent_cache.h"
+
+#include "yb/rocksutil/yb_rocksdb_logger.h"
 
 #include "yb/rpc/messenger.h"
 
@@ -155,6 +159,22 @@ DEFINE_int32(db_block_cache_size_percentage, 50,
              "Default percentage of total available memory to use as block cache size, if not "
              "asking for a raw number, through FLAGS_db_block_cache_size_bytes.");
 
+DEFINE_int64(db_block_cache_compressed_size_bytes, 0,
+             "Size of cross-tablet shared RocksDB compressed block cache (in bytes). Blocks are "
+             "kept there in their on-disk compressed form and the cache is consulted on a miss "
+             "in the uncompressed block cache before going to disk. 0 disables the compressed "
+             "block cache.");
+
+DEFINE_string(db_persistent_cache_path, "",
+              "Directory on a local device used for the persistent RocksDB block cache. Data "
+              "blocks read from SST files are stored there and served from it on a block cache "
+              "miss. Its contents are kept across restarts. Empty disables the persistent block "
+              "cache.");
+
+DEFINE_int64(db_persistent_cache_size_bytes, 10LL * 1024 * 1024 * 1024,
+             "Maximum size of the persistent RocksDB block cache (in bytes). Only used when "
+             "FLAGS_db_persistent_cache_path is set.");
+
 DEFINE_test_flag(int32, sleep_after_tombstoning_tablet_secs, 0,
                  "Whether we sleep in LogAndTombstone after calling DeleteTabletData.");
 
@@ -172,21 +192,21 @@ METRIC_DEFINE_histogram(server, op_apply_queue_length, "Operation Apply Queue Le
                         "Number of operations waiting to be applied to the tablet. "
                         "High queue lengths indicate that the server is unable to process "
                         "operations as fast as they are being written to the WAL.",
-                        10000, 2);
+                        10000, 2, STRIPED);
 
 METRIC_DEFINE_histogram(server, op_apply_queue_time, "Operation Apply Queue Time",
                         MetricUnit::kMicroseconds,
                         "Time that operations spent waiting in the apply queue before being "
                         "processed. High queue times indicate that the server is unable to "
                         "process operations as fast as they are being written to the WAL.",
-                        10000000, 2);
+                        10000000, 2, STRIPED);
 
 METRIC_DEFINE_histogram(server, op_apply_run_time, "Operation Apply Run Time",
                         MetricUnit::kMicroseconds,
                         "Time that operations spent being applied to the tablet. "
                         "High values may indicate that the server is under-provisioned or "
                         "that operations consist of very large batches.",
-                        10000000, 2);
+                        10000000, 2, STRIPED);
 
 using consensus::ConsensusMetadata;
 using consensus::ConsensusStatePB;
@@ -298,7 +318,25 @@ TSTabletManager::TSTabletManager(FsManager* fs_manager,
   }
   if (FLAGS_db_block_cache_size_bytes != kDbCacheSizeCacheDisabled) {
     tablet_options_.block_cache = rocksdb::NewLRUCache(block_cache_size_bytes);
-    tablet_options_.block_cache->SetMetrics(server_->metric_entity());
+    tablet_options_.block_cache->SetMetrics(server_->metric_entity(),
+                                            CacheMetricsTier::kUncompressed);
+  }
+  if (FLAGS_db_block_cache_compressed_size_bytes > 0) {
+    tablet_options_.block_cache_compressed =
+        rocksdb::NewLRUCache(FLAGS_db_block_cache_compressed_size_bytes);
+    tablet_options_.block_cache_compressed->SetMetrics(server_->metric_entity(),
+                                                       CacheMetricsTier::kCompressed);
+  }
+  if (!FLAGS_db_persistent_cache_path.empty()) {
+    Status s = rocksdb::NewFilePersistentCache(
+        rocksdb::Env::Default(), FLAGS_db_persistent_cache_path,
+        FLAGS_db_persistent_cache_size_bytes,
+        std::make_shared<YBRocksDBLogger>("Persistent cache: "),
+        &tablet_options_.persistent_cache);
+    if (!s.ok()) {
+      LOG(WARNING) << "Failed to open persistent block cache at "
+                   << FLAGS_db_persistent_cache_path << ", continuing without it: " << s;
+    }
   }
 
   // Calculate memstore_size_bytes
@@ -71,11 +71,51 @@ METRIC_DEFINE_gauge_uint64(server, block_cache_multi_touch_usage,
                            "Multi Cache Block Cache Memory Usage",
                            yb::MetricUnit::kBytes,
                            "Memory consumed by the multi cache block cache");
+
+METRIC_DEFINE_counter(server, compressed_block_cache_inserts,
+                      "Compressed Block Cache Inserts", yb::MetricUnit::kBlocks,
+                      "Number of blocks inserted in the compressed block cache");
+METRIC_DEFINE_counter(server, compressed_block_cache_lookups,
+                      "Compressed Block Cache Lookups", yb::MetricUnit::kBlocks,
+                      "Number of blocks looked up from the compressed block cache");
+METRIC_DEFINE_counter(server, compressed_block_cache_evictions,
+                      "Compressed Block Cache Evictions", yb::MetricUnit::kBlocks,
+                      "Number of blocks evicted from the compressed block cache");
+METRIC_DEFINE_counter(server, compressed_block_cache_misses,
+                      "Compressed Block Cache Misses", yb::MetricUnit::kBlocks,
+                      "Number of lookups in the compressed block cache that didn't yield a block");
+METRIC_DEFINE_counter(server, compressed_block_cache_misses_caching,
+                      "Compressed Block Cache Misses (Caching)", yb::MetricUnit::kBlocks,
+                      "Number of lookups in the compressed block cache that were expecting a "
+                      "block that didn't yield one.");
+METRIC_DEFINE_counter(server, compressed_block_cache_hits,
+                      "Compressed Block Cache Hits", yb::MetricUnit::kBlocks,
+                      "Number of lookups in the compressed block cache that found a block");
+METRIC_DEFINE_counter(server, compressed_block_cache_hits_caching,
+                      "Compressed Block Cache Hits (Caching)", yb::MetricUnit::kBlocks,
+                      "Number of lookups in the compressed block cache that were expecting a "
+                      "block that found one.");
+
+METRIC_DEFINE_gauge_uint64(server, compressed_block_cache_usage,
+                           "Compressed Block Cache Memory Usage",
+                           yb::MetricUnit::kBytes,
+                           "Memory consumed by the compressed block cache");
+METRIC_DEFINE_gauge_uint64(server, compressed_block_cache_single_touch_usage,
+                           "Single Touch Compressed Block Cache Memory Usage",
+                           yb::MetricUnit::kBytes,
+                           "Memory consumed by the single touch compressed block cache");
+METRIC_DEFINE_gauge_uint64(server, compressed_block_cache_multi_touch_usage,
+                           "Multi Cache Compressed Block Cache Memory Usage",
+                           yb::MetricUnit::kBytes,
+                           "Memory consumed by the multi cache compressed block cache");
+
 namespace yb {
 
-#define MINIT(member, x) member(METRIC_##x.Instantiate(entity))
-#define GINIT(member, x) member(METRIC_##x.Instantiate(entity, 0))
-CacheMetrics::CacheMetrics(const scoped_refptr<MetricEntity>& entity)
+#define MINIT(member, x) member(tier == CacheMetricsTier::kCompressed \
+    ? METRIC_compressed_##x.Instantiate(entity) : METRIC_##x.Instantiate(entity))
+#define GINIT(member, x) member(tier == CacheMetricsTier::kCompressed \
+    ? METRIC_compressed_##x.Instantiate(entity, 0) : METRIC_##x.Instantiate(entity, 0))
+CacheMetrics::CacheMetrics(const scoped_refptr<MetricEntity>& entity, CacheMetricsTier tier)
   : MINIT(inserts, block_cache_inserts),
     MINIT(lookups, block_cache_lookups),
     MINIT(evictions, block_cache_evictions),
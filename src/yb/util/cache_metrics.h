@@ -44,8 +44,16 @@ class AtomicGauge;
 class Counter;
 class MetricEntity;
 
+// The block cache tier that a set of cache metrics is reported for. The compressed tier holds
+// blocks in their on-disk (compressed) form and is consulted on a miss in the uncompressed tier.
+enum class CacheMetricsTier {
+  kUncompressed,
+  kCompressed,
+};
+
 struct CacheMetrics {
-  explicit CacheMetrics(const scoped_refptr<MetricEntity>& metric_entity);
+  explicit CacheMetrics(const scoped_refptr<MetricEntity>& metric_entity,
+                        CacheMetricsTier tier = CacheMetricsTier::kUncompressed);
 
   scoped_refptr<Counter> inserts;
   scoped_refptr<Counter> lookups;
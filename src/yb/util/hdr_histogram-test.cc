@@ -125,4 +125,27 @@ TEST_F(HdrHistogramTest, PercentileAndCopyTest) {
   ASSERT_EQ(hist.TotalSum(), copy.TotalSum());
 }
 
+TEST_F(HdrHistogramTest, MergeTest) {
+  HdrHistogram hist(10000LU, kSigDigits);
+  HdrHistogram other(10000LU, kSigDigits);
+  hist.Increment(10);
+  hist.Increment(20);
+  other.IncrementBy(20, 2);
+  other.Increment(1);
+  other.Increment(5000);
+
+  hist.MergeFrom(other);
+  ASSERT_EQ(6, hist.TotalCount());
+  ASSERT_EQ(10 + 20 + 2 * 20 + 1 + 5000, hist.TotalSum());
+  ASSERT_EQ(3, hist.CountInBucketForValue(20));
+  ASSERT_EQ(1, hist.MinValue());
+  ASSERT_EQ(5000, hist.MaxValue());
+
+  // Merging an empty histogram changes nothing.
+  hist.MergeFrom(HdrHistogram(10000LU, kSigDigits));
+  ASSERT_EQ(6, hist.TotalCount());
+  ASSERT_EQ(1, hist.MinValue());
+  ASSERT_EQ(5000, hist.MaxValue());
+}
+
 } // namespace yb
@@ -40,6 +40,7 @@
 #include "yb/gutil/bind.h"
 #include "yb/gutil/map-util.h"
 #include "yb/util/hdr_histogram.h"
+#include "yb/util/histogram.pb.h"
 #include "yb/util/jsonreader.h"
 #include "yb/util/jsonwriter.h"
 #include "yb/util/metrics.h"
@@ -181,6 +182,24 @@ TEST_F(MetricsTest, SimpleHistogramTest) {
   // TODO: Test coverage needs to be improved a lot.
 }
 
+METRIC_DEFINE_histogram(test_entity, test_striped_hist, "Test Striped Histogram",
+                        MetricUnit::kMilliseconds, "foo", 1000000, 3, STRIPED);
+
+TEST_F(MetricsTest, StripedHistogramTest) {
+  scoped_refptr<Histogram> hist = METRIC_test_striped_hist.Instantiate(entity_);
+  hist->Increment(2);
+  hist->IncrementBy(4, 1);
+  ASSERT_EQ(2, hist->TotalCount());
+  ASSERT_EQ(2, hist->MinValueForTests());
+  ASSERT_EQ(3, hist->MeanValueForTests());
+  ASSERT_EQ(4, hist->MaxValueForTests());
+
+  HistogramSnapshotPB snapshot;
+  ASSERT_OK(hist->GetHistogramSnapshotPB(&snapshot, MetricJsonOptions()));
+  ASSERT_EQ(2, snapshot.total_count());
+  ASSERT_EQ(6, snapshot.total_sum());
+}
+
 TEST_F(MetricsTest, JsonPrintTest) {
   scoped_refptr<Counter> bytes_seen = METRIC_reqs_pending.Instantiate(entity_);
   bytes_seen->Increment();
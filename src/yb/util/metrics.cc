@@ -43,6 +43,7 @@
 #include "yb/gutil/singleton.h"
 #include "yb/gutil/stl_util.h"
 #include "yb/gutil/strings/substitute.h"
+#include "yb/gutil/sysinfo.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/hdr_histogram.h"
 #include "yb/util/histogram.pb.h"
@@ -56,6 +57,11 @@ DEFINE_int32(metrics_retirement_age_ms, 120 * 1000,
 TAG_FLAG(metrics_retirement_age_ms, runtime);
 TAG_FLAG(metrics_retirement_age_ms, advanced);
 
+DEFINE_int32(metrics_max_histogram_stripes, 16,
+             "Maximum number of per-thread stripes kept by histograms defined with the STRIPED "
+             "flag. Rounded down to a power of two. 1 disables striping.");
+TAG_FLAG(metrics_max_histogram_stripes, advanced);
+
 // TODO: changed to empty string and add logic to get this from cluster_uuid in case empty.
 DEFINE_string(metric_node_name, "DEFAULT_NODE_NAME",
               "Value to use as node name for metrics reporting");
@@ -705,17 +711,83 @@ scoped_refptr<Histogram> HistogramPrototype::Instantiate(
 // Histogram
 /////////////////////////////////////////////////
 
+namespace {
+
+size_t NumHistogramStripes(const HistogramPrototype* proto) {
+  if (!(proto->flags() & STRIPED)) {
+    return 1;
+  }
+  const size_t limit = std::max(FLAGS_metrics_max_histogram_stripes, 1);
+  size_t result = 1;
+  while (result < static_cast<size_t>(base::NumCPUs()) && result * 2 <= limit) {
+    result *= 2;
+  }
+  return result;
+}
+
+} // namespace
+
 Histogram::Histogram(const HistogramPrototype* proto)
   : Metric(proto),
-    histogram_(new HdrHistogram(proto->max_trackable_value(), proto->num_sig_digits())) {
+    histogram_(new HdrHistogram(proto->max_trackable_value(), proto->num_sig_digits())),
+    num_stripes_(NumHistogramStripes(proto)) {
+  if (num_stripes_ > 1) {
+    stripes_.reset(new std::atomic<HdrHistogram*>[num_stripes_]);
+    for (size_t i = 0; i != num_stripes_; ++i) {
+      stripes_[i].store(nullptr, std::memory_order_relaxed);
+    }
+  }
+}
+
+Histogram::~Histogram() {
+  for (size_t i = 1; i < num_stripes_; ++i) {
+    delete stripes_[i].load(std::memory_order_acquire);
+  }
+}
+
+HdrHistogram* Histogram::RecordingHistogram() {
+  if (num_stripes_ == 1) {
+    return histogram_.get();
+  }
+
+  // Threads are assigned stripes round robin, which spreads them more evenly than hashing.
+  static std::atomic<size_t> next_thread_index{0};
+  static thread_local size_t thread_index =
+      next_thread_index.fetch_add(1, std::memory_order_relaxed);
+  const size_t stripe = thread_index & (num_stripes_ - 1);
+  if (stripe == 0) {
+    return histogram_.get();
+  }
+
+  HdrHistogram* result = stripes_[stripe].load(std::memory_order_acquire);
+  if (PREDICT_FALSE(result == nullptr)) {
+    std::unique_ptr<HdrHistogram> new_stripe(new HdrHistogram(
+        histogram_->highest_trackable_value(), histogram_->num_significant_digits()));
+    if (stripes_[stripe].compare_exchange_strong(
+            result, new_stripe.get(), std::memory_order_acq_rel)) {
+      result = new_stripe.release();
+    }
+  }
+  return result;
+}
+
+std::unique_ptr<HdrHistogram> Histogram::Snapshot() const {
+  std::unique_ptr<HdrHistogram> result(new HdrHistogram(*histogram_));
+  for (size_t i = 1; i < num_stripes_; ++i) {
+    const HdrHistogram* stripe = stripes_[i].load(std::memory_order_acquire);
+    if (stripe != nullptr) {
+      result->MergeFrom(*stripe);
+    }
+  }
+  return result;
 }
 
 void Histogram::Increment(int64_t value) {
-  histogram_->Increment(value);
+  RecordingHistogram()->Increment(value);
 }
 
 void Histogram::IncrementBy(int64_t value, int64_t amount) {
-  histogram_->IncrementBy(value, amount);
+  RecordingHistogram()->IncrementBy(value, amount);
 }
 
 Status Histogram::WriteAsJson(JsonWriter* writer,
@@ -729,7 +801,8 @@ Status Histogram::WriteAsJson(JsonWriter* writer,
 
 CHECKED_STATUS Histogram::WriteForPrometheus(
     PrometheusWriter* writer, const MetricEntity::AttributeMap& attr) const {
-  HdrHistogram snapshot(*histogram_);
+  const auto snapshot_holder = Snapshot();
+  const HdrHistogram& snapshot = *snapshot_holder;
 
   // Representing the sum and count require suffixed names.
   std::string hist_name = prototype_->name();
@@ -762,7 +835,8 @@ CHECKED_STATUS Histogram::WriteForPrometheus(
 
 Status Histogram::GetHistogramSnapshotPB(HistogramSnapshotPB* snapshot_pb,
                                          const MetricJsonOptions& opts) const {
-  HdrHistogram snapshot(*histogram_);
+  const auto snapshot_holder = Snapshot();
+  const HdrHistogram& snapshot = *snapshot_holder;
   snapshot_pb->set_name(prototype_->name());
   if (opts.include_schema_info) {
     snapshot_pb->set_type(MetricType::Name(prototype_->type()));
@@ -796,22 +870,29 @@ Status Histogram::GetHistogramSnapshotPB(HistogramSnapshotPB* snapshot_pb,
 }
 
 uint64_t Histogram::CountInBucketForValueForTests(uint64_t value) const {
-  return histogram_->CountInBucketForValue(value);
+  return Snapshot()->CountInBucketForValue(value);
 }
 
 uint64_t Histogram::TotalCount() const {
-  return histogram_->TotalCount();
+  uint64_t result = histogram_->TotalCount();
+  for (size_t i = 1; i < num_stripes_; ++i) {
+    const HdrHistogram* stripe = stripes_[i].load(std::memory_order_acquire);
+    if (stripe != nullptr) {
+      result += stripe->TotalCount();
+    }
+  }
+  return result;
 }
 
 uint64_t Histogram::MinValueForTests() const {
-  return histogram_->MinValue();
+  return Snapshot()->MinValue();
 }
 
 uint64_t Histogram::MaxValueForTests() const {
-  return histogram_->MaxValue();
+  return Snapshot()->MaxValue();
 }
 double Histogram::MeanValueForTests() const {
-  return histogram_->MeanValue();
+  return Snapshot()->MeanValue();
 }
 
 ScopedLatencyMetric::ScopedLatencyMetric(Histogram* latency_hist)
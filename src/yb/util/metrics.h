@@ -119,6 +119,23 @@
 //                            "Total number of threads started on this server",
 //                            yb::EXPOSE_AS_COUNTER);
 //
+// Striped histograms
+// ------------------------------------------------------------
+//
+// Counters are already striped across cache lines (see LongAdder), but a Histogram records into
+// shared bucket and total words. For server-wide histograms that are recorded into from many
+// threads at a high rate, pass the 'STRIPED' flag to give each thread one of several histograms,
+// which are merged only when the metric is read:
+//
+// METRIC_DEFINE_histogram(server, rpc_incoming_queue_time,
+//                         "RPC Queue Time",
+//                         yb::MetricUnit::kMicroseconds,
+//                         "Number of microseconds incoming RPC requests spend in the worker queue",
+//                         60000000LU, 3,
+//                         yb::STRIPED);
+//
+// Each stripe is a full histogram, so avoid this flag for per-tablet metrics.
+//
 //
 // Metrics ownership
 // ------------------------------------------------------------
@@ -239,6 +256,8 @@
 /////////////////////////////////////////////////////
 
 #include <algorithm>
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <sstream>
@@ -303,13 +322,14 @@
 #define METRIC_DEFINE_gauge_double(entity, name, label, unit, desc, ...) \
     METRIC_DEFINE_gauge(double, entity, name, label, unit, desc, ## __VA_ARGS__)
 
-#define METRIC_DEFINE_histogram(entity, name, label, unit, desc, max_val, num_sig_digits) \
+#define METRIC_DEFINE_histogram(entity, name, label, unit, desc, max_val, num_sig_digits, ...) \
   ::yb::HistogramPrototype BOOST_PP_CAT(METRIC_, name)(                                   \
       ::yb::MetricPrototype::CtorArgs(BOOST_PP_STRINGIZE(entity), \
                                       BOOST_PP_STRINGIZE(name), \
                                       label, \
                                       unit, \
-                                      desc), \
+                                      desc, \
+                                      ## __VA_ARGS__), \
       max_val, \
       num_sig_digits)
 
@@ -767,7 +787,10 @@ class MetricPrototypeRegistry {
 enum PrototypeFlags {
   // Flag which causes a Gauge prototype to expose itself as if it
   // were a counter.
-  EXPOSE_AS_COUNTER = 1 << 0
+  EXPOSE_AS_COUNTER = 1 << 0,
+
+  // Flag which causes a Histogram to keep per-thread stripes that are merged when read.
+  STRIPED = 1 << 1
 };
 
 class MetricPrototype {
@@ -802,6 +825,7 @@ class MetricPrototype {
   const char* label() const { return args_.label_; }
   MetricUnit::Type unit() const { return args_.unit_; }
   const char* description() const { return args_.description_; }
+  uint32_t flags() const { return args_.flags_; }
   virtual MetricType::Type type() const = 0;
 
   // Writes the fields of this prototype to the given JSON writer.
@@ -1140,12 +1164,32 @@ class Histogram : public Metric {
   uint64_t MaxValueForTests() const;
   double MeanValueForTests() const;
 
+  size_t num_stripes() const { return num_stripes_; }
+
+  ~Histogram();
+
  private:
   FRIEND_TEST(MetricsTest, SimpleHistogramTest);
+  FRIEND_TEST(MultiThreadedMetricsTest, HistogramIncrementScaling);
+  FRIEND_TEST(MultiThreadedMetricsTest, StripedHistogramSpreadsThreads);
   friend class MetricEntity;
   explicit Histogram(const HistogramPrototype* proto);
 
+  // Returns the histogram that the calling thread should record into.
+  HdrHistogram* RecordingHistogram();
+
+  // Returns a (non-consistent) snapshot with all stripes merged.
+  std::unique_ptr<HdrHistogram> Snapshot() const;
+
+  // Also serves as the first stripe of a striped histogram.
   const gscoped_ptr<HdrHistogram> histogram_;
+
+  // Power of two, 1 unless the prototype has the STRIPED flag.
+  const size_t num_stripes_;
+
+  // The remaining stripes, allocated when a thread first records into them. stripes_[0] is unused.
+  std::unique_ptr<std::atomic<HdrHistogram*>[]> stripes_;
+
   DISALLOW_COPY_AND_ASSIGN(Histogram);
 };
 
@@ -40,14 +40,18 @@
 #include "yb/gutil/ref_counted.h"
 #include "yb/gutil/strings/substitute.h"
 #include "yb/util/debug/leakcheck_disabler.h"
+#include "yb/util/hdr_histogram.h"
 #include "yb/util/jsonwriter.h"
 #include "yb/util/metrics.h"
 #include "yb/util/monotime.h"
+#include "yb/util/stopwatch.h"
 #include "yb/util/test_util.h"
 #include "yb/util/thread.h"
 
 DEFINE_int32(mt_metrics_test_num_threads, 4,
              "Number of threads to spawn in mt metrics tests");
+DEFINE_int32(mt_metrics_test_histogram_increments, 1000000,
+             "Number of increments per thread in the histogram scaling test");
 
 METRIC_DEFINE_entity(test_entity);
 
@@ -98,6 +102,80 @@ TEST_F(MultiThreadedMetricsTest, CounterIncrementTest) {
   ASSERT_EQ(num_threads * num_increments, counter->value());
 }
 
+METRIC_DEFINE_histogram(test_entity, test_hist, "Test Histogram",
+                        MetricUnit::kMicroseconds, "Test histogram", 60000000LU, 2);
+METRIC_DEFINE_histogram(test_entity, test_striped_hist, "Test Striped Histogram",
+                        MetricUnit::kMicroseconds, "Test striped histogram", 60000000LU, 2,
+                        STRIPED);
+
+static void IncrementHistogram(Histogram* hist, int num_increments) {
+  for (int i = 0; i < num_increments; i++) {
+    // Latency-like values that mostly hit the same few buckets.
+    hist->Increment(100 + (i & 0xf));
+  }
+}
+
+// Ensure that no increments are lost across the stripes of a striped histogram.
+TEST_F(MultiThreadedMetricsTest, StripedHistogramIncrementTest) {
+  scoped_refptr<Histogram> hist =
+      METRIC_test_striped_hist.Instantiate(
+          METRIC_ENTITY_test_entity.Instantiate(&registry_, "my-test"));
+  int num_threads = FLAGS_mt_metrics_test_num_threads;
+  int num_increments = 1000;
+  std::function<void()> f = std::bind(IncrementHistogram, hist.get(), num_increments);
+  RunWithManyThreads(&f, num_threads);
+  ASSERT_EQ(num_threads * num_increments, hist->TotalCount());
+  ASSERT_EQ(100, hist->MinValueForTests());
+  ASSERT_EQ(115, hist->MaxValueForTests());
+}
+
+// Microbenchmark for how the cost of recording into a shared histogram scales with the number of
+// threads, with and without striping.
+TEST_F(MultiThreadedMetricsTest, HistogramIncrementScaling) {
+  scoped_refptr<MetricEntity> entity =
+      METRIC_ENTITY_test_entity.Instantiate(&registry_, "my-test");
+  const int num_increments = FLAGS_mt_metrics_test_histogram_increments;
+  for (const HistogramPrototype* proto : {&METRIC_test_hist, &METRIC_test_striped_hist}) {
+    for (int num_threads = 1; num_threads <= FLAGS_mt_metrics_test_num_threads * 4;
+         num_threads *= 2) {
+      // A fresh histogram for each run, so that all runs start without allocated stripes.
+      scoped_refptr<Histogram> hist = new Histogram(proto);
+      std::function<void()> f = std::bind(IncrementHistogram, hist.get(), num_increments);
+      Stopwatch sw;
+      sw.start();
+      RunWithManyThreads(&f, num_threads);
+      sw.stop();
+      LOG(INFO) << proto->name() << " (" << hist->num_stripes() << " stripes), "
+                << num_threads << " threads: "
+                << sw.elapsed().wall * 1.0 / num_increments << " ns per increment per thread";
+      ASSERT_EQ(static_cast<uint64_t>(num_threads) * num_increments, hist->TotalCount());
+    }
+  }
+}
+
+// Ensure that as many new threads as there are stripes record into different stripes, so that
+// they do not share cache lines.
+TEST_F(MultiThreadedMetricsTest, StripedHistogramSpreadsThreads) {
+  const int num_increments = 1000;
+  scoped_refptr<Histogram> hist = new Histogram(&METRIC_test_striped_hist);
+  const size_t num_stripes = hist->num_stripes();
+  LOG(INFO) << "Stripes: " << num_stripes;
+  std::function<void()> f = std::bind(IncrementHistogram, hist.get(), num_increments);
+  RunWithManyThreads(&f, num_stripes);
+
+  // Threads are assigned stripes round robin, so each stripe got exactly one thread.
+  ASSERT_EQ(static_cast<uint64_t>(num_increments), hist->histogram_->TotalCount());
+  for (size_t i = 1; i != num_stripes; ++i) {
+    const HdrHistogram* stripe = hist->stripes_[i].load(std::memory_order_acquire);
+    ASSERT_NE(nullptr, stripe) << "Stripe " << i;
+    ASSERT_EQ(static_cast<uint64_t>(num_increments), stripe->TotalCount()) << "Stripe " << i;
+  }
+
+  // A histogram without the STRIPED flag keeps a single one.
+  scoped_refptr<Histogram> unstriped_hist = new Histogram(&METRIC_test_hist);
+  ASSERT_EQ(1U, unstriped_hist->num_stripes());
+}
+
 // Helper function to register a bunch of counters in a loop.
 void MultiThreadedMetricsTest::RegisterCounters(
     const scoped_refptr<MetricEntity>& metric_entity,
@@ -121,6 +121,27 @@ TEST_F(TraceTest, TestChildTrace) {
             XOutDigits(traceA->DumpToString(false)));
 }
 
+TEST_F(TraceTest, TestCost) {
+  scoped_refptr<Trace> traceA(new Trace);
+  scoped_refptr<Trace> traceB(new Trace);
+  ADOPT_TRACE(traceA.get());
+  traceA->AddChildTrace(traceB.get());
+  TRACE_COST(TraceCost::kKeysScanned, 10);
+  {
+    ADOPT_TRACE(traceB.get());
+    TRACE_COST(TraceCost::kKeysScanned, 5);
+    TRACE_COST(TraceCost::kLockWaitMicros, 7);
+  }
+  ASSERT_EQ(15, traceA->TotalCost(TraceCost::kKeysScanned));
+  ASSERT_EQ(7, traceA->TotalCost(TraceCost::kLockWaitMicros));
+  ASSERT_EQ(5, traceB->TotalCost(TraceCost::kKeysScanned));
+  ASSERT_EQ(0, traceA->TotalCost(TraceCost::kBlocksRead));
+  EXPECT_EQ("Related trace:\n"
+            "Cost: KeysScanned=5 LockWaitMicros=7\n"
+            "Cost: KeysScanned=15 LockWaitMicros=7\n",
+            traceA->DumpToString(false));
+}
+
 static void GenerateTraceEvents(int thread_id,
                                 int num_events) {
   for (int i = 0; i < num_events; i++) {
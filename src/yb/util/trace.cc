@@ -213,6 +213,9 @@ struct TraceEntry {
 };
 
 Trace::Trace() {
+  for (auto& cost : costs_) {
+    cost.store(0, std::memory_order_relaxed);
+  }
 }
 
 ThreadSafeObjectPool<ThreadSafeArena>& ArenaPool() {
@@ -332,6 +335,19 @@ void Trace::Dump(std::ostream *out, bool include_time_deltas) const {
          trace_start_time_usec,
          entries | boost::adaptors::indirected,
          &child_traces);
+
+  bool has_cost = false;
+  for (auto cost : kTraceCostList) {
+    auto value = TotalCost(cost);
+    if (value != 0) {
+      // Strip the 'k' prefix of the enum value name.
+      *out << (has_cost ? " " : "Cost: ") << (ToCString(cost) + 1) << "=" << value;
+      has_cost = true;
+    }
+  }
+  if (has_cost) {
+    *out << std::endl;
+  }
 }
 
 string Trace::DumpToString(bool include_time_deltas) const {
@@ -359,6 +375,19 @@ void Trace::AddChildTrace(Trace* child_trace) {
   CHECK(!child_trace->HasOneRef());
 }
 
+int64_t Trace::TotalCost(TraceCost cost) const {
+  int64_t result = costs_[util::to_underlying(cost)].load(std::memory_order_relaxed);
+  vector<scoped_refptr<Trace> > child_traces;
+  {
+    std::lock_guard<simple_spinlock> l(lock_);
+    child_traces = child_traces_;
+  }
+  for (const auto& child_trace : child_traces) {
+    result += child_trace->TotalCost(cost);
+  }
+  return result;
+}
+
 PlainTrace::PlainTrace() {
 }
 
@@ -32,6 +32,7 @@
 #ifndef YB_UTIL_TRACE_H
 #define YB_UTIL_TRACE_H
 
+#include <array>
 #include <atomic>
 #include <iosfwd>
 #include <string>
@@ -46,6 +47,7 @@
 #include "yb/gutil/ref_counted.h"
 #include "yb/gutil/threading/thread_collision_warner.h"
 
+#include "yb/util/enums.h"
 #include "yb/util/locks.h"
 #include "yb/util/memory/arena_fwd.h"
 
@@ -90,6 +92,20 @@ DECLARE_bool(enable_tracing);
     } \
   } while (0)
 
+// Adds 'delta' to the given TraceCost of the current trace, if tracing is enabled in the current
+// thread.
+// Example:
+//  TRACE_COST(TraceCost::kLockWaitMicros, wait_time.ToMicroseconds());
+#define TRACE_COST(cost, delta) \
+  do { \
+    if (FLAGS_enable_tracing) { \
+      yb::Trace* _trace = Trace::CurrentTrace(); \
+      if (_trace) { \
+        _trace->AddCost((cost), (delta)); \
+      } \
+    } \
+  } while (0)
+
 #define PLAIN_TRACE_TO(trace, message) \
   do { \
     if (FLAGS_enable_tracing) { \
@@ -101,6 +117,18 @@ namespace yb {
 
 struct TraceEntry;
 
+// Resources consumed on behalf of a request. Accumulated per trace and summed over the trace and
+// all of its children, so the cost of a request includes the work done by the operations it
+// started.
+YB_DEFINE_ENUM(TraceCost,
+               (kKeysScanned)      // RocksDB internal keys visited by iterators.
+               (kBlocksRead)       // SST blocks read from disk.
+               (kBlockCacheHits)   // SST blocks found in the block cache.
+               (kBytesRead)        // Bytes of SST blocks read from disk.
+               (kLockWaitMicros)   // Time spent waiting for DocDB row locks.
+               (kRaftWaitMicros)   // Time between submitting an operation to Raft and its commit.
+               (kApplyMicros));    // Time spent applying operations to RocksDB.
+
 // A trace for a request or other process. This supports collecting trace entries
 // from a number of threads, and later dumping the results to a stream.
 //
@@ -155,6 +183,14 @@ class Trace : public RefCountedThreadSafe<Trace> {
   // Attaches the given trace which will get appended at the end when Dumping.
   void AddChildTrace(Trace* child_trace);
 
+  // Adds 'delta' to the given cost of this trace.
+  void AddCost(TraceCost cost, int64_t delta) {
+    costs_[util::to_underlying(cost)].fetch_add(delta, std::memory_order_relaxed);
+  }
+
+  // Returns the given cost of this trace, including the costs of all its child traces.
+  int64_t TotalCost(TraceCost cost) const;
+
   // Return the current trace attached to this thread, if there is one.
   static Trace* CurrentTrace() {
     return threadlocal_trace_;
@@ -197,6 +233,8 @@ class Trace : public RefCountedThreadSafe<Trace> {
 
   std::vector<scoped_refptr<Trace> > child_traces_;
 
+  std::array<std::atomic<int64_t>, kTraceCostMapSize> costs_;
+
   DISALLOW_COPY_AND_ASSIGN(Trace);
 };
 
@@ -28,6 +28,7 @@ using client::YBColumnSchema;
 // scanner phase and as a result if we're doing string matching everything should be lowercase.
 const std::map<std::string, PTTableProperty::KVProperty> PTTableProperty::kPropertyDataTypes
     = {
+    {"block_cache_priority", KVProperty::kBlockCachePriority},
     {"bloom_filter_fp_chance", KVProperty::kBloomFilterFpChance},
     {"caching", KVProperty::kCaching},
     {"comment", KVProperty::kComment},
@@ -36,11 +37,14 @@ const std::map<std::string, PTTableProperty::KVProperty> PTTableProperty::kPrope
     {"crc_check_chance", KVProperty::kCrcCheckChance},
     {"dclocal_read_repair_chance", KVProperty::kDclocalReadRepairChance},
     {"default_time_to_live", KVProperty::kDefaultTimeToLive},
+    {"drop_expired_files", KVProperty::kDropExpiredFiles},
     {"gc_grace_seconds", KVProperty::kGcGraceSeconds},
     {"index_interval", KVProperty::kIndexInterval},
     {"memtable_flush_period_in_ms", KVProperty::kMemtableFlushPeriodInMs},
     {"min_index_interval", KVProperty::kMinIndexInterval},
     {"max_index_interval", KVProperty::kMaxIndexInterval},
+    {"packed_rows", KVProperty::kPackedRows},
+    {"range_tombstones", KVProperty::kRangeTombstones},
     {"read_repair_chance", KVProperty::kReadRepairChance},
     {"speculative_retry", KVProperty::kSpeculativeRetry},
     {"transactions", KVProperty::kTransactions}
@@ -75,6 +79,20 @@ PTTableProperty::~PTTableProperty() {
 }
 
 
+bool PTTableProperty::ParseBlockCachePriority(const string& val,
+                                              BlockCachePriorityPB* priority) {
+  if (val == "default") {
+    *priority = BLOCK_CACHE_PRIORITY_DEFAULT;
+  } else if (val == "high") {
+    *priority = BLOCK_CACHE_PRIORITY_HIGH;
+  } else if (val == "low") {
+    *priority = BLOCK_CACHE_PRIORITY_LOW;
+  } else {
+    return false;
+  }
+  return true;
+}
+
 Status PTTableProperty::AnalyzeSpeculativeRetry(const string &val) {
   string generic_error = Substitute("Invalid value $0 for option 'speculative_retry'", val);
 
@@ -219,6 +237,31 @@ CHECKED_STATUS PTTableProperty::Analyze(SemContext *sem_context) {
       RETURN_SEM_CONTEXT_ERROR_NOT_OK(GetStringValueFromExpr(rhs_, true, table_property_name,
                                                              &str_val));
       break;
+    case KVProperty::kBlockCachePriority: {
+      RETURN_SEM_CONTEXT_ERROR_NOT_OK(GetStringValueFromExpr(rhs_, true, table_property_name,
+                                                             &str_val));
+      BlockCachePriorityPB priority;
+      if (!ParseBlockCachePriority(str_val, &priority)) {
+        return sem_context->Error(this,
+            Substitute("Invalid value $0 for option '$1'. Valid values are 'default', 'high' "
+                       "and 'low'", str_val, table_property_name).c_str(),
+            ErrorCode::INVALID_ARGUMENTS);
+      }
+      break;
+    }
+    case KVProperty::kDropExpiredFiles: FALLTHROUGH_INTENDED;
+    case KVProperty::kPackedRows: FALLTHROUGH_INTENDED;
+    case KVProperty::kRangeTombstones: {
+      bool bool_val;
+      RETURN_SEM_CONTEXT_ERROR_NOT_OK(GetBoolValueFromExpr(rhs_, table_property_name, &bool_val));
+      if (sem_context->current_alter_table() != nullptr) {
+        return sem_context->Error(this,
+            Substitute("Option '$0' can only be set when the table is created",
+                       table_property_name).c_str(),
+            ErrorCode::FEATURE_NOT_SUPPORTED);
+      }
+      break;
+    }
     case KVProperty::kCompaction: FALLTHROUGH_INTENDED;
     case KVProperty::kCaching: FALLTHROUGH_INTENDED;
     case KVProperty::kCompression: FALLTHROUGH_INTENDED;
@@ -366,6 +409,40 @@ Status PTTableProperty::SetTableProperty(yb::TableProperties *table_property) co
       table_property->SetDefaultTimeToLive(val * MonoTime::kMillisecondsPerSecond);
       break;
     }
+    case KVProperty::kBlockCachePriority: {
+      string val;
+      BlockCachePriorityPB priority;
+      if (!GetStringValueFromExpr(rhs_, true, table_property_name, &val).ok() ||
+          !ParseBlockCachePriority(val, &priority)) {
+        return STATUS(InvalidArgument, Substitute("Invalid value for block_cache_priority"));
+      }
+      table_property->SetBlockCachePriority(priority);
+      break;
+    }
+    case KVProperty::kDropExpiredFiles: {
+      bool val;
+      if (!GetBoolValueFromExpr(rhs_, table_property_name, &val).ok()) {
+        return STATUS(InvalidArgument, Substitute("Invalid value for drop_expired_files"));
+      }
+      table_property->SetDropExpiredFiles(val);
+      break;
+    }
+    case KVProperty::kPackedRows: {
+      bool val;
+      if (!GetBoolValueFromExpr(rhs_, table_property_name, &val).ok()) {
+        return STATUS(InvalidArgument, Substitute("Invalid value for packed_rows"));
+      }
+      table_property->SetUsePackedRows(val);
+      break;
+    }
+    case KVProperty::kRangeTombstones: {
+      bool val;
+      if (!GetBoolValueFromExpr(rhs_, table_property_name, &val).ok()) {
+        return STATUS(InvalidArgument, Substitute("Invalid value for range_tombstones"));
+      }
+      table_property->SetUseRangeTombstones(val);
+      break;
+    }
     case KVProperty::kBloomFilterFpChance: FALLTHROUGH_INTENDED;
     case KVProperty::kComment: FALLTHROUGH_INTENDED;
     case KVProperty::kCrcCheckChance: FALLTHROUGH_INTENDED;
@@ -37,6 +37,7 @@ enum class PropertyType : int {
 class PTTableProperty : public PTProperty {
  public:
   enum class KVProperty : int {
+    kBlockCachePriority,
     kBloomFilterFpChance,
     kCaching,
     kComment,
@@ -45,11 +46,14 @@ class PTTableProperty : public PTProperty {
     kCrcCheckChance,
     kDclocalReadRepairChance,
     kDefaultTimeToLive,
+    kDropExpiredFiles,
     kGcGraceSeconds,
     kIndexInterval,
     kMemtableFlushPeriodInMs,
     kMinIndexInterval,
     kMaxIndexInterval,
+    kPackedRows,
+    kRangeTombstones,
     kReadRepairChance,
     kSpeculativeRetry,
     kTransactions
@@ -129,6 +133,9 @@ class PTTableProperty : public PTProperty {
  private:
   CHECKED_STATUS AnalyzeSpeculativeRetry(const string &val);
 
+  // Parses the lowercase name of a block cache priority class. Returns false if it is not valid.
+  static bool ParseBlockCachePriority(const string& val, BlockCachePriorityPB* priority);
+
   static const std::map<std::string, PTTableProperty::KVProperty> kPropertyDataTypes;
 };
 
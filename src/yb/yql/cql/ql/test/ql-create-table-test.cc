@@ -181,6 +181,98 @@ TEST_F(TestQLCreateTable, TestQLCreateTableWithTTL) {
   EXPECT_EQ(1000, properties_pb.default_time_to_live());
 }
 
+TEST_F(TestQLCreateTable, TestQLCreateTableWithBlockCachePriority) {
+  // Init the simulated cluster.
+  ASSERT_NO_FATALS(CreateSimulatedCluster());
+
+  // Get an available processor.
+  TestQLProcessor *processor = GetQLProcessor();
+
+  EXEC_VALID_STMT("CREATE TABLE hot_table (c1 int, c2 int, PRIMARY KEY(c1)) WITH "
+                      "block_cache_priority = 'high';");
+  EXEC_INVALID_STMT("CREATE TABLE bad_table (c1 int, c2 int, PRIMARY KEY(c1)) WITH "
+                        "block_cache_priority = 'urgent';");
+
+  // Verify the priority was stored in syscatalog table.
+  master::CatalogManager *catalog_manager = cluster_->mini_master()->master()->catalog_manager();
+  master::GetTableSchemaRequestPB request_pb;
+  master::GetTableSchemaResponsePB response_pb;
+  request_pb.mutable_table()->mutable_namespace_()->set_name(kDefaultKeyspaceName);
+  request_pb.mutable_table()->set_table_name("hot_table");
+  CHECK_OK(catalog_manager->GetTableSchema(&request_pb, &response_pb));
+  const TablePropertiesPB& properties_pb = response_pb.schema().table_properties();
+  EXPECT_EQ(BLOCK_CACHE_PRIORITY_HIGH, properties_pb.block_cache_priority());
+}
+
+TEST_F(TestQLCreateTable, TestQLCreateTableWithPackedRows) {
+  // Init the simulated cluster.
+  ASSERT_NO_FATALS(CreateSimulatedCluster());
+
+  // Get an available processor.
+  TestQLProcessor *processor = GetQLProcessor();
+
+  EXEC_VALID_STMT("CREATE TABLE packed_table (c1 int, c2 int, PRIMARY KEY(c1)) WITH "
+                      "packed_rows = true;");
+  EXEC_INVALID_STMT("CREATE TABLE bad_table (c1 int, c2 int, PRIMARY KEY(c1)) WITH "
+                        "packed_rows = 'sometimes';");
+  EXEC_INVALID_STMT("ALTER TABLE packed_table WITH packed_rows = false;");
+
+  // Verify the property was stored in syscatalog table.
+  master::CatalogManager *catalog_manager = cluster_->mini_master()->master()->catalog_manager();
+  master::GetTableSchemaRequestPB request_pb;
+  master::GetTableSchemaResponsePB response_pb;
+  request_pb.mutable_table()->mutable_namespace_()->set_name(kDefaultKeyspaceName);
+  request_pb.mutable_table()->set_table_name("packed_table");
+  CHECK_OK(catalog_manager->GetTableSchema(&request_pb, &response_pb));
+  EXPECT_TRUE(response_pb.schema().table_properties().use_packed_rows());
+}
+
+TEST_F(TestQLCreateTable, TestQLCreateTableWithRangeTombstones) {
+  // Init the simulated cluster.
+  ASSERT_NO_FATALS(CreateSimulatedCluster());
+
+  // Get an available processor.
+  TestQLProcessor *processor = GetQLProcessor();
+
+  EXEC_VALID_STMT("CREATE TABLE range_table (h int, r int, v int, PRIMARY KEY((h), r)) WITH "
+                      "range_tombstones = true;");
+  EXEC_INVALID_STMT("CREATE TABLE bad_table (h int, r int, PRIMARY KEY((h), r)) WITH "
+                        "range_tombstones = 'sometimes';");
+  EXEC_INVALID_STMT("ALTER TABLE range_table WITH range_tombstones = false;");
+
+  // Verify the property was stored in syscatalog table.
+  master::CatalogManager *catalog_manager = cluster_->mini_master()->master()->catalog_manager();
+  master::GetTableSchemaRequestPB request_pb;
+  master::GetTableSchemaResponsePB response_pb;
+  request_pb.mutable_table()->mutable_namespace_()->set_name(kDefaultKeyspaceName);
+  request_pb.mutable_table()->set_table_name("range_table");
+  CHECK_OK(catalog_manager->GetTableSchema(&request_pb, &response_pb));
+  EXPECT_TRUE(response_pb.schema().table_properties().use_range_tombstones());
+}
+
+TEST_F(TestQLCreateTable, TestQLCreateTableWithDropExpiredFiles) {
+  // Init the simulated cluster.
+  ASSERT_NO_FATALS(CreateSimulatedCluster());
+
+  // Get an available processor.
+  TestQLProcessor *processor = GetQLProcessor();
+
+  EXEC_VALID_STMT("CREATE TABLE expiring_table (h int, r int, v int, PRIMARY KEY((h), r)) WITH "
+                      "default_time_to_live = 3600 AND drop_expired_files = true;");
+  EXEC_INVALID_STMT("CREATE TABLE bad_table (h int, r int, PRIMARY KEY((h), r)) WITH "
+                        "drop_expired_files = 'sometimes';");
+  EXEC_INVALID_STMT("ALTER TABLE expiring_table WITH drop_expired_files = false;");
+
+  // Verify the property was stored in syscatalog table.
+  master::CatalogManager *catalog_manager = cluster_->mini_master()->master()->catalog_manager();
+  master::GetTableSchemaRequestPB request_pb;
+  master::GetTableSchemaResponsePB response_pb;
+  request_pb.mutable_table()->mutable_namespace_()->set_name(kDefaultKeyspaceName);
+  request_pb.mutable_table()->set_table_name("expiring_table");
+  CHECK_OK(catalog_manager->GetTableSchema(&request_pb, &response_pb));
+  EXPECT_TRUE(response_pb.schema().table_properties().drop_expired_files());
+}
+
 TEST_F(TestQLCreateTable, TestQLCreateTableWithClusteringOrderBy) {
   // Init the simulated cluster.
   ASSERT_NO_FATALS(CreateSimulatedCluster());